@@ -65,6 +65,17 @@ function getOrSetUploadDate(dateToSetOrUndefined) {
     return parseInt(ctrl.value)
 }
 
+/** Get or set POSIX timezone rule
+ * @param {string | undefined} ruleOrUndefined * @returns {string} */
+ function getOrSetTimezoneRule(ruleOrUndefined) {
+    const ctrl = document.getElementById('edittzrule')
+    if (typeof ruleOrUndefined == 'string') {
+        ctrl.value = ruleOrUndefined
+        return ruleOrUndefined
+    }
+    return ctrl.value
+}
+
 /** Get or set ntpenabled
  * @param {boolean | undefined} ntpEnabledOrUndefined * @returns {boolean} */
  function getOrSetNTPEnabled(ntpEnabledOrUndefined) {
@@ -122,6 +133,7 @@ function updateControls(state) {
     getOrSetUploadDate(getOrSetDeviceDate(ISOStringToDate(state.date)))
     getOrSetTimezone(state.timezone)
     getOrSetDaylight(state.daylight)
+    getOrSetTimezoneRule(state.tzrule)
     getOrSetNTPEnabled(state.ntpenabled)
     getOrSetTimeserver(1, state.ntpserver1)
     getOrSetTimeserver(2, state.ntpserver2)
@@ -138,7 +150,7 @@ function setStatus(text) {
 function requestState() {
     if (window.location.hostname == '') {
         setStatus("Device state accepted")
-        updateControls(JSON.parse('{"date":"20221108T102641Z", "timezone":3, "daylight":0, "ntpenabled":true, "ntpserver1":"0.pool.ntp.org", "ntpserver2":"1.pool.ntp.org", "ntpserver3":"time.nist.gov", "brightness":25, "colors":"0808220000443333AAFF0000001100"}'))
+        updateControls(JSON.parse('{"date":"20221108T102641Z", "timezone":3, "daylight":0, "tzrule":"MSK-3", "ntpenabled":true, "ntpserver1":"0.pool.ntp.org", "ntpserver2":"1.pool.ntp.org", "ntpserver3":"time.nist.gov", "brightness":25, "colors":"0808220000443333AAFF0000001100"}'))
         return
     }
 
@@ -147,7 +159,11 @@ function requestState() {
     rq.onreadystatechange = function() {
         if (rq.readyState === 4) {
             console.log(rq.response)            
-            updateControls(resp = JSON.parse(rq.response))
+            const state = JSON.parse(rq.response)
+            updateControls(state)
+            if ('forecast' in state) {
+                updateForecast(state.forecast)
+            }
             setStatus("Device state accepted")
         }
     }
@@ -155,6 +171,49 @@ function requestState() {
     console.log("get-state request sent")
 }
 
+/** Shows forecast pushed by device
+ * @param {object | null} forecast */
+function updateForecast(forecast) {
+    document.getElementById('forecastpanel').innerText = forecast
+        ? `${forecast.temperatureCelsius}\u00B0C, ${forecast.weatherDescription}, wind ${forecast.windSpeed} m/s ${forecast.windDirectionSideShort}`
+        : 'Forecast unknown'
+}
+
+/** Subscribes to device events, time, state and forecast come when they change,
+ * falls back to single state request when event source unavailable */
+function subscribeEvents() {
+    if (window.location.hostname == '' || typeof EventSource == 'undefined') {
+        requestState()
+        return
+    }
+
+    events = new EventSource('events')
+    events.addEventListener('time', function(event) {
+        const time = JSON.parse(event.data)
+        const date = ISOStringToDate(time.date)
+        date.setMilliseconds(time.ms)
+        getOrSetDeviceDate(date)
+        updateCurrentTime()
+    })
+    events.addEventListener('state', function(event) {
+        updateControls(JSON.parse(event.data))
+        setStatus("Device state accepted")
+    })
+    events.addEventListener('forecast', function(event) {
+        updateForecast(JSON.parse(event.data))
+    })
+    events.onerror = function() {
+        setStatus("Device connection lost, reconnecting")
+    }
+}
+
+/** Requests state unless device pushes it by events */
+function refreshState() {
+    if (!events || events.readyState == EventSource.CLOSED) {
+        requestState()
+    }
+}
+
 function updateCurrentTime() {
     const deviceDate = getOrSetDeviceDate()
     if (deviceDate) {
@@ -187,25 +246,56 @@ function buttonSyncronizeTimeClick() {
     rq.onreadystatechange = function() {
         if (rq.readyState === 4) {
             setStatus("Clock syncronization initiated")
-            requestState()
+            refreshState()
         }
     }
     rq.send('')
 }
 
-function buttonCommitDisplaySettingsClick() {
-    const brightness = getOrSetDisplayBrightness()
-    const colors = getOrSetDisplayColors()
+function buttonSetTimezoneRuleClick() {
+    const rule = getOrSetTimezoneRule()
+    let rq = new XMLHttpRequest()
+    rq.open('POST', 'set-timezone', true)
+    rq.setRequestHeader("Content-Type", "application/x-www-form-urlencoded")
+    rq.onreadystatechange = function() {
+        if (rq.readyState === 4) {
+            setStatus(rq.status == 200 ? "Timezone rule set: " + rule : "Timezone rule rejected")
+            refreshState()
+        }
+    }
+    rq.send('rule=' + encodeURIComponent(rule))
+}
 
+/** Sends settings batch, device checks all fields, applies them together and saves once
+ * @param {object} fields * @param {string} done */
+function postConfig(fields, done) {
     let rq = new XMLHttpRequest()
-    rq.open('POST', 'set-display', true)
+    rq.open('POST', 'set-config', true)
     rq.setRequestHeader("Content-Type", "application/x-www-form-urlencoded")
     rq.onreadystatechange = function() {
         if (rq.readyState === 4) {
-            setStatus('Display settings commited')
+            setStatus(rq.status == 200 ? done : 'Settings rejected: ' + rq.response)
+            refreshState()
         }
     }
-    rq.send(`brightness=${brightness}&colors=${colors}`)
+    rq.send(Object.keys(fields).map(key => key + '=' + encodeURIComponent(fields[key])).join('&'))
+}
+
+function buttonSetDeviceSyncroClick() {
+    postConfig({
+        tzrule: getOrSetTimezoneRule(),
+        ntpenabled: getOrSetNTPEnabled() ? 1 : 0,
+        ntpserver1: getOrSetTimeserver(1),
+        ntpserver2: getOrSetTimeserver(2),
+        ntpserver3: getOrSetTimeserver(3)
+    }, 'NTP settings commited')
+}
+
+function buttonCommitDisplaySettingsClick() {
+    postConfig({
+        brightness: getOrSetDisplayBrightness(),
+        colors: getOrSetDisplayColors()
+    }, 'Display settings commited')
 }
 
 function displayColorsTextChanged(value) {
@@ -219,8 +309,10 @@ function displayColorChaged(index, color) {
        color.substring(1) + colors.substring(6 + index * 6));
 }
 
+let events = null
+
 document.addEventListener("DOMContentLoaded", function() {
-    requestState()
+    subscribeEvents()
 })
 
 setInterval(updateCurrentTime, 1000) // update device time clock
@@ -0,0 +1,81 @@
+/******************************************************************************
+ * (c) Skatech Research Lab, 2000-2026.
+ * Last change: 2026.10.16
+ * Host-native benchmark harness - registration, timing and reporting helpers
+ *****************************************************************************/
+
+#pragma once
+
+#include <Arduino.h>
+#include <vector>
+
+#include "hal.h"
+
+typedef void (*BenchmarkFunction)();
+
+class Benchmark {
+    public:
+    const char* name;
+    BenchmarkFunction function;
+    Benchmark* next;
+
+    static Benchmark* first;
+
+    Benchmark(const char* name, BenchmarkFunction function);
+};
+
+#define BENCHMARK(name) \
+    static void bench_##name(); \
+    static Benchmark benchmark_##name(#name, bench_##name); \
+    static void bench_##name()
+
+// monotonic host clock in nanoseconds
+uint64_t benchNanos();
+
+// per-operation wall time and heap allocation samples, storage reserved up front
+// so the harness itself never allocates inside a measured region
+class Samples {
+    private:
+    std::vector<uint64_t> _nanos;
+    uint64_t _allocations = 0;
+
+    public:
+    Samples(size_t capacity = 100000) {
+        _nanos.reserve(capacity);
+    }
+
+    void add(uint64_t nanos, uint32_t allocations) {
+        if (_nanos.size() < _nanos.capacity()) {
+            _nanos.push_back(nanos);
+            _allocations += allocations;
+        }
+    }
+
+    size_t count() const {
+        return _nanos.size();
+    }
+
+    double mean() const;
+    void report(const char* label);
+};
+
+// measures single call of given function into samples
+template<typename F> inline void measure(Samples& samples, F function) {
+    uint32_t allocations = hal::allocations();
+    uint64_t start = benchNanos();
+    function();
+    uint64_t nanos = benchNanos() - start;
+    samples.add(nanos, hal::allocations() - allocations);
+}
+
+void note(const char* label, const char* format, ...) __attribute__((format(printf, 2, 3)));
+
+// sets POSIX TZ rule of both libc and firmware DateTime conversions
+void useZone(const char* rule);
+
+// copies files of a host directory into given file system, return files copied
+class FS;
+int copyHostFiles(FS& fs, const char* directory);
+
+// runs firmware setup() once and lets simulated clock run until network and forecast are up
+void firmwareBoot();
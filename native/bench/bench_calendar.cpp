@@ -0,0 +1,78 @@
+/******************************************************************************
+ * (c) Skatech Research Lab, 2000-2026.
+ * Last change: 2026.10.16
+ * Host-native benchmark of DateTime calendar conversion and formatting
+ *****************************************************************************/
+
+#include <string>
+
+#include "bench.h"
+#include "DateTime.h"
+
+// previous implementation: full localtime() and strftime() into a new String per call
+static String libcToString(time_t sec, const char* format) {
+    struct tm* t = localtime(&sec);
+    char v[48];
+    strftime(v, sizeof(v), format, t);
+    return String(v);
+}
+
+// count seconds formatted differently from libc, stepping with given interval
+static int mismatches(time_t from, time_t to, time_t step, const char* format) {
+    int count = 0;
+    for (time_t sec = from; sec < to; sec += step) {
+        char buffer[48];
+        DateTime(sec).toString(buffer, sizeof(buffer), format);
+        count += libcToString(sec, format) != buffer;
+    }
+    return count;
+}
+
+BENCHMARK(calendar) {
+    std::string zone = TimeZone::local().getRule();
+    const char* full = "%a %d %b %Y %j %H:%M:%S %Z %z %%";
+    int failures = 0;
+    for (const char* tz : { "CET-1CEST,M3.5.0,M10.5.0/3", "<+1030>-10:30<+11>-11,M10.1.0,M4.1.0", "UTC0" }) {
+        useZone(tz);
+        // year of 2026 sparsely, transition days second by second, random jumps
+        failures += mismatches(1767225600, 1798761600, 61, full);
+        failures += mismatches(1774746000 - 86400, 1774746000 + 86400, 1, full);
+        failures += mismatches(1792890000 - 86400, 1792890000 + 86400, 1, full);
+        for (int i = 0; i < 100000; i++) {
+            time_t sec = 946684800 + (time_t)(((uint64_t)i * 2654435761U) % 1700000000U);
+            failures += mismatches(sec, sec + 1, 1, full);
+        }
+    }
+    useZone("CET-1CEST,M3.5.0,M10.5.0/3");
+    note("seconds formatted unlike libc", "%d", failures);
+
+    // display update formats of consecutive seconds
+    Samples libc(100000), cached(100000);
+    time_t start = 1780000000;
+    for (int i = 0; i < 100000; i++) {
+        measure(libc, [&]() {
+            String time = libcToString(start + i, "%H %M");
+            String date = libcToString(start + i, "%d %b %y");
+        });
+    }
+    for (int i = 0; i < 100000; i++) {
+        measure(cached, [&]() {
+            char time[8], date[12];
+            DateTime now(start + i);
+            now.toString(time, sizeof(time), "%H %M");
+            now.toString(date, sizeof(date), "%d %b %y");
+        });
+    }
+    libc.report("tick, localtime + strftime (previous)");
+    cached.report("tick, calendar cache");
+    note("ticks per second", "%.0f libc, %.0f cached", 1e9 / libc.mean(), 1e9 / cached.mean());
+
+    Samples jumps(100000);
+    for (int i = 0; i < 100000; i++) {
+        time_t sec = start + (i * 7919) % 86400;
+        measure(jumps, [&]() { DateTime(sec).toDetails(); });
+    }
+    jumps.report("toDetails(), random second of the day");
+
+    useZone(zone.c_str());
+}
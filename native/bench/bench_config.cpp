@@ -0,0 +1,111 @@
+/******************************************************************************
+ * (c) Skatech Research Lab, 2000-2026.
+ * Last change: 2026.10.17
+ * Host-native benchmark of settings changes, separate requests against a single
+ * checked batch committed once
+ *****************************************************************************/
+
+#include <ESP8266WebServer.h>
+
+#include "bench.h"
+#include "configuration.h"
+#include "Scheduler.h"
+
+#define BENCH_CONFIG_ROUNDS 200
+#define BENCH_CONFIG_RULE "CET-1CEST,M3.5.0,M10.5.0/3"
+#define BENCH_CONFIG_COLORS "0808220000443333AAFF0000001100"
+#define BENCH_CONFIG_BRIGHTNESS "40"    // other than the default 25, read back from /get-state
+
+void loop();
+
+extern Configuration state;
+extern ESP8266WebServer server;
+extern ScheduledTask flushTask;
+
+typedef std::vector<std::pair<std::string, std::string>> Fields;
+
+// request served by the firmware loop, configuration flush scheduled by it done too,
+// return status code
+static int configRequest(const char* uri, const Fields& args, Samples* samples = NULL) {
+    server.simulate({ HTTP_POST, uri, args, { }, true });
+    hal::advance(hal::radioReceiveMicros(hal::uptimeMicros()) - hal::uptimeMicros());
+    if (samples) {
+        measure(*samples, []() { server.handleClient(); });
+    }
+    else server.handleClient();
+    while (flushTask.isScheduled()) {
+        loop();
+    }
+    return server.lastResponse().code;
+}
+
+static std::string currentState() {
+    server.simulate({ HTTP_GET, "/get-state", { }, { }, true });
+    hal::advance(hal::radioReceiveMicros(hal::uptimeMicros()) - hal::uptimeMicros());
+    server.handleClient();
+    std::string body = server.lastResponse().body;
+    return body.substr(body.find(",")); // date runs on
+}
+
+BENCHMARK(config) {
+    firmwareBoot();
+    struct timeval clock;
+    gettimeofday(&clock, NULL);
+    std::string rule = state.timezoneRule;
+    const char* rules[2] = { BENCH_CONFIG_RULE, rule.c_str() };
+    int failures = 0;
+
+    // previous: page sends date, rule and display scheme apart, then asks to save
+    Samples separate(BENCH_CONFIG_ROUNDS * 4), batched(BENCH_CONFIG_ROUNDS);
+    uint32_t writes = hal::flashWrites();
+    for (int i = 0; i < BENCH_CONFIG_ROUNDS; i++) {
+        failures += configRequest("/set-date", { { "date", "20230102T100000Z" } }, &separate) != 200;
+        failures += configRequest("/set-timezone", { { "rule", rules[i % 2] } }, &separate) != 200;
+        failures += configRequest("/set-display", { { "brightness", BENCH_CONFIG_BRIGHTNESS }, { "colors", BENCH_CONFIG_COLORS } },
+            &separate) != 200;
+        failures += configRequest("/write-config", { }, &separate) != 200;
+    }
+    uint32_t separateWrites = hal::flashWrites() - writes;
+
+    writes = hal::flashWrites();
+    for (int i = 0; i < BENCH_CONFIG_ROUNDS; i++) {
+        failures += configRequest("/set-config", { { "date", "20230102T100000Z" }, { "tzrule", rules[i % 2] },
+            { "brightness", BENCH_CONFIG_BRIGHTNESS }, { "colors", BENCH_CONFIG_COLORS } }, &batched) != 200;
+    }
+    uint32_t batchWrites = hal::flashWrites() - writes;
+
+    // same values again, nothing to write
+    writes = hal::flashWrites();
+    for (int i = 0; i < BENCH_CONFIG_ROUNDS; i++) {
+        failures += configRequest("/set-config", { { "tzrule", rule.c_str() }, { "brightness", BENCH_CONFIG_BRIGHTNESS },
+            { "ntpenabled", "1" } }) != 200;
+    }
+    uint32_t unchangedWrites = hal::flashWrites() - writes;
+
+    // brightness set is what the page reads back and what the panel shows
+    bool shown = currentState().find("\"brightness\":" BENCH_CONFIG_BRIGHTNESS ",") != std::string::npos &&
+        hal::displayContrast() == atoi(BENCH_CONFIG_BRIGHTNESS);
+    failures += !shown;
+
+    // invalid field after valid ones, none of them may be applied
+    std::string before = currentState();
+    writes = hal::flashWrites();
+    int rejected = 0;
+    rejected += configRequest("/set-config", { { "tzrule", BENCH_CONFIG_RULE }, { "brightness", "60" },
+        { "colors", "0808220000443333AAFF00000011" } }) == 400;
+    rejected += configRequest("/set-config", { { "ntpserver1", "pool.example.org" }, { "brightness", "256" } }) == 400;
+    rejected += configRequest("/set-config", { { "tzrule", BENCH_CONFIG_RULE }, { "timezone", "3" } }) == 400;
+    rejected += configRequest("/set-config", { { "date", "20230102T100000Z" }, { "tzrule", "<+03" } }) == 400;
+    failures += (rejected != 4) + (currentState() != before) + (hal::flashWrites() != writes);
+    settimeofday(&clock, NULL);
+
+    separate.report("separate requests, handleClient()");
+    batched.report("POST /set-config, handleClient()");
+    note("handling per change", "separate 4 requests %.1f us, batched 1 request %.1f us",
+        separate.mean() * 4 / 1000, batched.mean() / 1000);
+    note("flash writes", "separate %u, batched %u, unchanged batches %u of %d",
+        separateWrites, batchWrites, unchangedWrites, BENCH_CONFIG_ROUNDS);
+    note("brightness read back", "%s", shown ? "yes" : "no");
+    note("rejected batches", "%d of 4, state kept %s", rejected, currentState() == before ? "yes" : "no");
+    note("unexpected results", "%d", failures);
+}
@@ -0,0 +1,152 @@
+/******************************************************************************
+ * (c) Skatech Research Lab, 2000-2026.
+ * Last change: 2026.10.17
+ * Host-native benchmark of Server-Sent Events delivery to web page subscribers
+ *****************************************************************************/
+
+#include <ESP8266WebServer.h>
+
+#include "bench.h"
+#include "EventStream.h"
+#include "configuration.h"
+#include "JsonStream.h"
+
+#define BENCH_EVENTS_SECONDS 120
+#define BENCH_EVENTS_CHANGE 1000        // ms between configuration changes
+#define BENCH_EVENTS_LONG_RULE "<+0545>-05:45<+0645>-06:45,M3.5.0/02,M10.5.0/03"  // longest rule kept
+#define BENCH_EVENTS_LONG_SERVER "ntp-time-servers-0123456789.org"              // longest server kept
+
+void loop();
+
+extern ESP8266WebServer server;
+extern EventStream events;
+extern Configuration state;
+
+class EventCounter : public JsonListener {
+    public:
+    int values = 0;
+
+    void onJsonValue(const JsonPath& path, const char* value, bool string) override {
+        values++;
+    }
+};
+
+// page reading its event source, complete events are taken from received bytes
+struct Subscriber {
+    std::shared_ptr<hal::Connection> connection;
+    std::string pending;
+    int time = 0, state = 0, forecast = 0, malformed = 0;
+    size_t bytes = 0;
+
+    void read() {
+        pending += connection->received;
+        bytes += connection->received.size();
+        connection->received.clear();
+        size_t end;
+        while ((end = pending.find("\n\n")) != std::string::npos) {
+            std::string block = pending.substr(0, end);
+            pending.erase(0, end + 2);
+            size_t event = block.find("event: "), data = block.find("\ndata: ");
+            if (event == std::string::npos) {
+                continue;
+            }
+            std::string name = block.substr(event + 7, data - event - 7);
+            std::string json = data == std::string::npos ? "" : block.substr(data + 7);
+            EventCounter counter;
+            JsonStreamParser parser(&counter);
+            malformed += !parser.feed(json.c_str(), json.size()) || counter.values == 0;
+            (name == "time" ? time : name == "state" ? state : forecast)++;
+        }
+    }
+};
+
+static std::shared_ptr<hal::Connection> request(HTTPMethod method, const char* uri,
+        std::vector<std::pair<std::string, std::string>> args = { }) {
+    uint32_t served = server.served();
+    std::shared_ptr<hal::Connection> connection = server.simulate({ method, uri, args, { }, true });
+    while (server.served() == served) {
+        loop();
+    }
+    return connection;
+}
+
+BENCHMARK(events) {
+    firmwareBoot();
+    Subscriber pages[EVENT_MAX_SUBSCRIBERS];
+    for (Subscriber& page : pages) {
+        page.connection = request(HTTP_GET, "/events");
+    }
+    request(HTTP_GET, "/events");
+    int refused = server.lastResponse().code == 503;
+
+    // last page stops reading, its connection window and then event buffer fill up
+    uint64_t until = hal::uptimeMicros() + (uint64_t)BENCH_EVENTS_SECONDS * 1000000;
+    uint64_t change = hal::uptimeMicros(), droppedAt = 0;
+    int changes = 0;
+    Samples flush(BENCH_EVENTS_SECONDS * 1000);
+    while (hal::uptimeMicros() < until) {
+        if (hal::uptimeMicros() >= change) {
+            request(HTTP_POST, "/set-display", { { "brightness", "40" }, { "colors", "0808220000443333AAFF0000001100" } });
+            change += BENCH_EVENTS_CHANGE * 1000;
+            changes++;
+        }
+        loop();
+        measure(flush, []() { events.flush(); });
+        for (int i = 0; i < EVENT_MAX_SUBSCRIBERS - 1; i++) {
+            pages[i].read();
+        }
+        if (droppedAt == 0 && !pages[EVENT_MAX_SUBSCRIBERS - 1].connection->open) {
+            droppedAt = hal::uptimeMicros();
+        }
+    }
+
+    request(HTTP_GET, "/get-state");
+    size_t polled = server.lastResponse().body.size();
+    bool brightness = server.lastResponse().body.find("\"brightness\":40,") != std::string::npos;
+    // time event follows clock set at once, clock restored for benchmarks that follow
+    struct timeval clock;
+    gettimeofday(&clock, NULL);
+    request(HTTP_POST, "/set-date", { { "date", "20230102T100000Z" } });
+    pages[0].read();
+    int timeEvents = pages[0].time;
+    settimeofday(&clock, NULL);
+
+    int malformed = 0, missed = 0;
+    for (int i = 0; i < EVENT_MAX_SUBSCRIBERS - 1; i++) {
+        malformed += pages[i].malformed;
+        missed += pages[i].state != changes + 1 || pages[i].forecast < 1 || pages[i].time < 1;
+    }
+
+    // every configuration string at its longest still gives one well formed state event
+    std::string rule = state.timezoneRule, servers[3] = { state.timeServer1, state.timeServer2, state.timeServer3 };
+    int states = pages[0].state, broken = pages[0].malformed;
+    size_t received = pages[0].bytes;
+    request(HTTP_POST, "/set-config", { { "tzrule", BENCH_EVENTS_LONG_RULE }, { "ntpserver1", BENCH_EVENTS_LONG_SERVER },
+        { "ntpserver2", BENCH_EVENTS_LONG_SERVER }, { "ntpserver3", BENCH_EVENTS_LONG_SERVER } });
+    events.flush();
+    pages[0].read();
+    bool longest = strlen(state.timezoneRule) + 1 == sizeof(state.timezoneRule) &&
+        strlen(state.timeServer1) + 1 == sizeof(state.timeServer1) && pages[0].state == states + 1 &&
+        pages[0].malformed == broken;
+    received = pages[0].bytes - received;
+    request(HTTP_POST, "/set-config", { { "tzrule", rule }, { "ntpserver1", servers[0] },
+        { "ntpserver2", servers[1] }, { "ntpserver3", servers[2] } });
+    events.flush();
+    flush.report("EventStream::flush()");
+    note("configuration changes", "%d, state events per page %d, bytes per page %zu", changes, pages[0].state,
+        pages[0].bytes);
+    note("bytes per event", "%.0f, GET /get-state response %zu", (double)pages[0].bytes / (pages[0].state +
+        pages[0].time + pages[0].forecast), polled);
+    note("time events after set-date", "%d", timeEvents);
+    note("stalled page dropped after", "%.1f s", droppedAt ? (droppedAt - (until - BENCH_EVENTS_SECONDS * 1000000ULL)) /
+        1e6 : 0.0);
+    note("subscriber beyond limit refused", "%s", refused ? "yes" : "no");
+    note("subscribers left", "%u", events.getSubscriberCount());
+    note("brightness set read back", "%s", brightness ? "yes" : "no");
+    note("state event of longest strings", "%zu bytes sent, well formed %s", received, longest ? "yes" : "no");
+    note("events missed or malformed", "%d", missed + malformed + !refused + (droppedAt == 0) + !brightness + !longest);
+    for (Subscriber& page : pages) {
+        page.connection->open = false;
+    }
+    events.flush();
+}
@@ -0,0 +1,331 @@
+/******************************************************************************
+ * (c) Skatech Research Lab, 2000-2026.
+ * Last change: 2026.10.17
+ * Host-native benchmarks of the firmware main loop, display frame and web UI
+ *****************************************************************************/
+
+#include <ESP8266WebServer.h>
+#include <LittleFS.h>
+
+#include "bench.h"
+#include "configuration.h"
+#include "forecast.h"
+#include "display-SSD1306.h"
+#include "Scheduler.h"
+#include "LatencyHistogram.h"
+#include "JsonStream.h"
+
+#define BENCH_SIMULATED_SECONDS 600
+#define BENCH_REQUEST_PERIOD 1733       // ms between web requests, drifting over second phase
+#define BENCH_REQUEST_SERVE 40          // ms every request holds the loop
+#define BENCH_TASKS_MAX 32              // scheduler tasks the checks save counters of
+#define BENCH_WEBUI_SOURCE "data"
+#define BENCH_WEBUI_BUILD ".pio/webui"
+
+// open-meteo current_weather response as returned in 2023
+#define BENCH_FORECAST_RESPONSE "{\"latitude\":78.125,\"longitude\":15.25,\"generationtime_ms\":0.2510547637939453," \
+    "\"utc_offset_seconds\":0,\"timezone\":\"GMT\",\"timezone_abbreviation\":\"GMT\",\"elevation\":7.0," \
+    "\"current_weather\":{\"temperature\":-8.3,\"windspeed\":14.8,\"winddirection\":113.0," \
+    "\"weathercode\":3,\"time\":\"2023-01-02T10:00\"}}"
+
+void setup();
+void loop();
+
+extern Configuration state;
+extern ClockDisplay display;
+extern ForecastProvider forecast;
+extern ESP8266WebServer server;
+extern Scheduler scheduler;
+extern LatencyHistogram faceLatency;
+
+void firmwareBoot() {
+    static bool booted = false;
+    if (booted) {
+        return;
+    }
+    booted = true;
+    hal::setHttpResponse(HTTP_CODE_OK, BENCH_FORECAST_RESPONSE, 250);
+    // filesystem image as tools/webui.py builds it, plain data/ when it was not run
+    LittleFS.begin();
+    if (copyHostFiles(LittleFS, BENCH_WEBUI_BUILD) == 0) {
+        copyHostFiles(LittleFS, BENCH_WEBUI_SOURCE);
+    }
+    setup();
+    uint64_t until = hal::uptimeMicros() + 5000000;
+    while (hal::uptimeMicros() < until) {
+        loop();
+    }
+}
+
+BENCHMARK(loop) {
+    firmwareBoot();
+    Samples idle(BENCH_SIMULATED_SECONDS * 1000), second(BENCH_SIMULATED_SECONDS);
+    hal::resetDisplayStats();
+    uint32_t serial = hal::serialBytes();
+    uint64_t until = hal::uptimeMicros() + (uint64_t)BENCH_SIMULATED_SECONDS * 1000000;
+    uint32_t requests = hal::httpRequests();
+    uint64_t longest = 0;
+    int skipped = 0, passes = 0;
+
+    // slow link, forecast refresh made due at the start of the simulated period whatever
+    // benchmarks ran before
+    hal::setNetworkDelays(200, 300);
+    hal::setHttpResponse(HTTP_CODE_OK, BENCH_FORECAST_RESPONSE, 3000);
+    forecast.expire();
+    time_t seen = time(NULL);
+    while (hal::uptimeMicros() < until) {
+        time_t now = time(NULL);
+        bool changed = now != seen;
+        skipped += now - seen > 1 ? now - seen - 1 : 0;
+        seen = now;
+        uint32_t allocations = hal::allocations();
+        uint64_t simulated = hal::uptimeMicros();
+        uint64_t start = benchNanos();
+        loop();
+        uint64_t nanos = benchNanos() - start;
+        passes++;
+        longest = max(longest, hal::uptimeMicros() - simulated);
+        allocations = hal::allocations() - allocations;
+        (changed ? second : idle).add(nanos, allocations);
+    }
+    hal::setNetworkDelays(0, 0);
+    hal::setHttpResponse(HTTP_CODE_OK, BENCH_FORECAST_RESPONSE, 250);
+
+    const hal::DisplayStats& stats = hal::displayStats();
+    idle.report("loop() tick, idle");
+    second.report("loop() tick, second change");
+    note("simulated seconds", "%d", BENCH_SIMULATED_SECONDS);
+    note("display bus transfers", "%u", stats.frames);
+    note("display bus bytes per second", "%.1f", (double)stats.bytes / BENCH_SIMULATED_SECONDS);
+    note("display bus time per second", "%.0f us", (double)stats.busMicros / BENCH_SIMULATED_SECONDS);
+    note("serial bytes", "%u", hal::serialBytes() - serial);
+    note("forecast requests", "%u (DNS 200 ms, connect 300 ms, response 3000 ms)", hal::httpRequests() - requests);
+    note("longest loop() iteration, simulated", "%.1f ms", longest / 1000.0);
+    note("clock seconds skipped", "%d", skipped);
+    note("loop passes per second", "%.1f", (double)passes / BENCH_SIMULATED_SECONDS);
+    for (const ScheduledTask* task = scheduler.getFirstTask(); task; task = Scheduler::getFollowing(task)) {
+        note(task->name, "%u runs, %u overruns, max %u us, late %u ms", (unsigned)task->runs,
+            (unsigned)task->overruns, (unsigned)task->microsMax, (unsigned)task->lateMax);
+    }
+}
+
+static int64_t wallMicros() {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return (int64_t)tv.tv_sec * 1000000 + tv.tv_usec;
+}
+
+static void reportLatency(const char* label, const LatencyHistogram& latency) {
+    note(label, "p50 %.1f ms, p99 %.1f ms, min %.2f ms, max %.2f ms", latency.getPercentile(50) / 1000.0,
+        latency.getPercentile(99) / 1000.0, latency.getMin() / 1000.0, latency.getMax() / 1000.0);
+    char bins[96];
+    size_t length = 0;
+    for (uint8_t bin = 0; bin < HISTOGRAM_BINS && length < sizeof(bins); bin++) {
+        length += snprintf(bins + length, sizeof(bins) - length, "%s%u", bin ? " " : "", (unsigned)latency.getBin(bin));
+    }
+    note("  bins: early, <0.25, <0.5 .. ms", "%s", bins);
+}
+
+// second boundary to panel update completion, web requests served meanwhile
+BENCHMARK(face) {
+    firmwareBoot();
+    hal::setWebServeDelay(BENCH_REQUEST_SERVE);
+    uint64_t until = hal::uptimeMicros() + (uint64_t)BENCH_SIMULATED_SECONDS * 1000000;
+    uint64_t request = hal::uptimeMicros();
+    uint32_t served = server.served();
+
+    // previous loop: time polled every ms, face updated when the second changes
+    LatencyHistogram previous;
+    time_t seen = time(NULL);
+    while (hal::uptimeMicros() < until) {
+        time_t now = time(NULL);
+        if (now != seen) {
+            seen = now;
+            display.update(now);
+            previous.add((int32_t)(wallMicros() - (int64_t)now * 1000000));
+        }
+        display.animate(millis());
+        if (hal::uptimeMicros() >= request) {
+            server.simulate({ HTTP_GET, "/time", { }, { }, false });
+            request += BENCH_REQUEST_PERIOD * 1000;
+        }
+        server.handleClient();
+        delay(1);
+    }
+
+    // scheduled tasks catch up with the time passed first
+    uint64_t settled = hal::uptimeMicros() + 1000000;
+    while (hal::uptimeMicros() < settled) {
+        loop();
+    }
+    until = hal::uptimeMicros() + (uint64_t)BENCH_SIMULATED_SECONDS * 1000000;
+    request = hal::uptimeMicros();
+    faceLatency.reset();
+    while (hal::uptimeMicros() < until) {
+        if (hal::uptimeMicros() >= request) {
+            server.simulate({ HTTP_GET, "/time", { }, { }, false });
+            request += BENCH_REQUEST_PERIOD * 1000;
+        }
+        loop();
+    }
+    hal::setWebServeDelay(0);
+    reportLatency("face latency, polled loop (previous)", previous);
+    reportLatency("face latency, aligned push", faceLatency);
+    note("web requests served", "%u, %d ms each", server.served() - served, BENCH_REQUEST_SERVE);
+}
+
+BENCHMARK(render) {
+    firmwareBoot();
+    Samples frames(20000);
+    hal::resetDisplayStats();
+    uint32_t frameBytes = 0, frameMicros = 0;
+    time_t now = time(NULL);
+    for (int i = 0; i < 20000; i++) {
+        DateTime date(now + i);
+        measure(frames, [&]() { display.update(date); });
+        frameBytes += display.getFrameBytes();
+        frameMicros += display.getFrameMicros();
+    }
+    frames.report("ClockDisplay::update()");
+    note("changed tile bytes per frame", "%.1f", frameBytes / 20000.0);
+    note("frame push time", "%.0f us (max %u us)", frameMicros / 20000.0, display.getFrameMicrosMax());
+    note("display bus bytes per frame", "%.1f", hal::displayStats().bytes / 20000.0);
+    note("display bus time per frame", "%.0f us", hal::displayStats().busMicros / 20000.0);
+}
+
+BENCHMARK(ticker) {
+    firmwareBoot();
+    Samples frames(20000);
+    hal::resetDisplayStats();
+    uint32_t frameBytes = 0;
+    for (int i = 0; i < 20000; i++) {
+        delay(1000 / TICKER_FRAME_RATE);
+        uint32_t ms = millis();
+        measure(frames, [&]() { display.animate(ms); });
+        frameBytes += display.getFrameBytes();
+    }
+    frames.report("ClockDisplay::animate()");
+    note("frame rate", "%d fps, %d px/s", TICKER_FRAME_RATE, TICKER_SPEED);
+    note("changed tile bytes per frame", "%.1f", frameBytes / 20000.0);
+    note("display bus time per second", "%.0f us",
+        hal::displayStats().busMicros * (double)TICKER_FRAME_RATE / 20000);
+}
+
+static void benchRequest(const char* label, HTTPMethod method, const char* uri) {
+    Samples samples(5000);
+    size_t bytes = 0;
+    // request received with the beacon the modem sleeping station wakes for
+    for (int i = 0; i < 5000; i++) {
+        server.simulate({ method, uri, { }, { }, false });
+        hal::advance(hal::radioReceiveMicros(hal::uptimeMicros()) - hal::uptimeMicros());
+        measure(samples, []() { server.handleClient(); });
+        bytes = server.lastResponse().body.size();
+    }
+    samples.report(label);
+    note("  response bytes", "%zu", bytes);
+}
+
+// values of /get-state compared with configuration the firmware runs
+class StateChecker : public JsonListener {
+    private:
+    TimeZone _zone;
+    char _colors[sizeof(state.displayColors) / sizeof(uint32_t) * 6 + 1];
+
+    // hours of the value against offset in seconds
+    static bool isOffset(const char* value, int32_t seconds) {
+        return lround(strtod(value, NULL) * 3600) == seconds;
+    }
+
+    public:
+    int values = 0, mismatches = 0;
+
+    StateChecker() {
+        _zone.parse(state.timezoneRule);
+        for (uint8_t i = 0; i < sizeof(state.displayColors) / sizeof(uint32_t); i++) {
+            snprintf(_colors + i * 6, sizeof(_colors) - i * 6, "%06X", (unsigned)(state.displayColors[i] & 0xFFFFFF));
+        }
+    }
+
+    void onJsonValue(const JsonPath& path, const char* value, bool string) override {
+        values++;
+        const char* expected = path.is("tzrule") ? state.timezoneRule : path.is("ntpserver1") ? state.timeServer1 :
+            path.is("ntpserver2") ? state.timeServer2 : path.is("ntpserver3") ? state.timeServer3 :
+            path.is("colors") ? _colors : NULL;
+        if (expected && (!string || strcmp(value, expected) != 0)) {
+            mismatches++;
+        }
+        if (path.is("ntpenabled") && strcmp(value, state.ntpenabled ? "true" : "false") != 0) {
+            mismatches++;
+        }
+        if (path.is("brightness") && (string || strtoul(value, NULL, 10) != state.displayBrightness)) {
+            mismatches++;
+        }
+        if (path.is("timezone") && (string || !isOffset(value, _zone.getStandardOffset()))) {
+            mismatches++;
+        }
+        if (path.is("daylight") && (string || !isOffset(value, _zone.getOffset(time(NULL)) - _zone.getStandardOffset()))) {
+            mismatches++;
+        }
+    }
+};
+
+static int checkState() {
+    server.simulate({ HTTP_GET, "/get-state", { }, { }, false });
+    hal::advance(hal::radioReceiveMicros(hal::uptimeMicros()) - hal::uptimeMicros());
+    server.handleClient();
+    const ESP8266WebServer::Response& response = server.lastResponse();
+    StateChecker checker;
+    JsonStreamParser parser(&checker);
+    bool parsed = parser.feed(response.body.c_str(), response.body.size());
+    note("  chunks", "%u, finished %s", (unsigned)response.chunks, response.finished ? "yes" : "no");
+    note("  values", "%d, parsed %s", checker.values, parsed ? "yes" : "no");
+    return checker.mismatches + !parsed + !response.chunked + !response.finished;
+}
+
+// tasks of /get-state-tasks counted, counters of long uptime in place of the real ones
+class TasksChecker : public JsonListener {
+    public:
+    int names = 0;
+
+    void onJsonValue(const JsonPath& path, const char* value, bool string) override {
+        names += path.is("tasks", "", "name") && string;
+    }
+};
+
+static int checkTasks() {
+    uint16_t count = 0;
+    uint32_t saved[BENCH_TASKS_MAX][3];
+    for (const ScheduledTask* task = scheduler.getFirstTask(); task && count < BENCH_TASKS_MAX;
+            task = Scheduler::getFollowing(task), count++) {
+        ScheduledTask* counters = const_cast<ScheduledTask*>(task);
+        saved[count][0] = counters->runs, saved[count][1] = counters->overruns, saved[count][2] = counters->microsMax;
+        counters->runs = counters->overruns = counters->microsMax = UINT32_MAX;
+    }
+    server.simulate({ HTTP_GET, "/get-state-tasks", { }, { }, false });
+    hal::advance(hal::radioReceiveMicros(hal::uptimeMicros()) - hal::uptimeMicros());
+    server.handleClient();
+    count = 0;
+    for (const ScheduledTask* task = scheduler.getFirstTask(); task && count < BENCH_TASKS_MAX;
+            task = Scheduler::getFollowing(task), count++) {
+        ScheduledTask* counters = const_cast<ScheduledTask*>(task);
+        counters->runs = saved[count][0], counters->overruns = saved[count][1], counters->microsMax = saved[count][2];
+    }
+    const ESP8266WebServer::Response& response = server.lastResponse();
+    TasksChecker checker;
+    JsonStreamParser parser(&checker);
+    bool parsed = parser.feed(response.body.c_str(), response.body.size());
+    note("  response bytes, counters at maximum", "%zu", response.body.size());
+    note("  tasks", "%d of %u, parsed %s", checker.names, count, parsed ? "yes" : "no");
+    return (checker.names != count) + !parsed + !response.chunked + !response.finished;
+}
+
+BENCHMARK(http) {
+    firmwareBoot();
+    benchRequest("GET /time", HTTP_GET, "/time");
+    benchRequest("GET /info", HTTP_GET, "/info");
+    benchRequest("GET /get-state", HTTP_GET, "/get-state");
+    note("get-state checks failed", "%d", checkState());
+    benchRequest("GET /get-state-forecast", HTTP_GET, "/get-state-forecast");
+    benchRequest("GET /get-state-tasks", HTTP_GET, "/get-state-tasks");
+    note("get-state-tasks checks failed", "%d", checkTasks());
+}
@@ -0,0 +1,450 @@
+/******************************************************************************
+ * (c) Skatech Research Lab, 2000-2026.
+ * Last change: 2026.10.17
+ * Host-native benchmark of open-meteo response parsing, with response corpus
+ *****************************************************************************/
+
+#include <string>
+
+#include <ESP8266HTTPClient.h>
+#include <LittleFS.h>
+
+#include "bench.h"
+#include "secrets.h"
+#include "forecast.h"
+
+struct ForecastCase {
+    const char* name;
+    const char* body;
+    bool valid;
+    float temperature;
+    u8 weathercode;
+};
+
+static const ForecastCase corpus[] = {
+    { "2023 field order",
+        "{\"latitude\":78.125,\"longitude\":15.25,\"generationtime_ms\":0.25,\"utc_offset_seconds\":0,"
+        "\"timezone\":\"GMT\",\"timezone_abbreviation\":\"GMT\",\"elevation\":7.0,\"current_weather\":"
+        "{\"temperature\":-8.3,\"windspeed\":14.8,\"winddirection\":113.0,\"weathercode\":3,"
+        "\"time\":\"2023-01-02T10:00\"}}", true, -8.3F, 3 },
+    { "reordered and extra fields",
+        "{\"current_weather\":{\"time\":\"2024-05-01T12:00\",\"interval\":900,\"is_day\":1,"
+        "\"weathercode\":61,\"winddirection\":270,\"windspeed\":5.4,\"temperature\":12.5},"
+        "\"current_weather_units\":{\"temperature\":\"\\u00b0C\",\"windspeed\":\"km/h\"}}", true, 12.5F, 61 },
+    { "pretty printed",
+        "{\n  \"latitude\" : 78.125,\n  \"current_weather\" : {\n    \"temperature\" : 0.0,\n"
+        "    \"windspeed\" : 0.0,\n    \"winddirection\" : 0,\n    \"weathercode\" : 0\n  }\n}\n", true, 0.0F, 0 },
+    { "escaped strings and nesting",
+        "{\"timezone\":\"Europe\\/Oslo \\\"x\\\" \\\\\",\"meta\":[[1,2,{\"a\":[true,false,null]}],{}],"
+        "\"current_weather\":{\"temperature\":-40.5,\"windspeed\":120,\"winddirection\":359.9,"
+        "\"weathercode\":99}}", true, -40.5F, 99 },
+    { "missing field",
+        "{\"current_weather\":{\"temperature\":1.0,\"windspeed\":2.0,\"weathercode\":3}}", false, 0, 0 },
+    { "nested key with same name",
+        "{\"hourly\":{\"temperature\":5.0},\"current_weather\":{\"windspeed\":1,\"winddirection\":2,"
+        "\"weathercode\":3}}", false, 0, 0 },
+    { "truncated",
+        "{\"current_weather\":{\"temperature\":1.0,\"windspeed\":2.0,\"winddirection\":3,\"weath", false, 0, 0 },
+    { "malformed",
+        "{\"current_weather\":{\"temperature\":1.0,,\"windspeed\":2.0,\"winddirection\":3,\"weathercode\":1}}",
+        false, 0, 0 },
+    { "error object",
+        "{\"error\":true,\"reason\":\"Latitude must be in range of -90 to 90\\u00b0. Given: 178.14.\"}", false, 0, 0 },
+};
+
+// hourly series of a week ahead of the current weather, typical large response
+static std::string largeResponse() {
+    std::string body = "{\"latitude\":78.125,\"longitude\":15.25,\"hourly\":{\"time\":[";
+    for (int i = 0; i < 168; i++) {
+        char item[32];
+        snprintf(item, sizeof(item), "%s\"2023-01-%02dT%02d:00\"", i ? "," : "", 2 + i / 24, i % 24);
+        body += item;
+    }
+    body += "],\"temperature_2m\":[";
+    for (int i = 0; i < 168; i++) {
+        char item[16];
+        snprintf(item, sizeof(item), "%s%.1f", i ? "," : "", -8.3 + (i % 24) * 0.4);
+        body += item;
+    }
+    body += "]},\"current_weather\":{\"temperature\":-8.3,\"windspeed\":14.8,\"winddirection\":113.0,"
+        "\"weathercode\":3,\"time\":\"2023-01-02T10:00\"}}";
+    return body;
+}
+
+// current weather with hourly series in the order and format requested by ForecastSeries,
+// values derived from the hour index so each record can be checked after parsing
+static float hourlyTemperature(int i) { return -12.3F + i * 0.35F; }
+static float hourlyWindSpeed(int i) { return (i * 7) % 90 / 2.0F + 0.3F; }
+static float hourlyWindDirection(int i) { return (i * 37) % 360; }
+static int hourlyWeatherCode(int i) { return i % 4 == 0 ? 61 : i % 3; }
+
+static std::string hourlyResponse(time_t now, const char* order) {
+    long base = now / 86400 * 86400;
+    std::string body = "{\"latitude\":78.125,\"longitude\":15.25,\"current_weather\":{\"temperature\":-8.3,"
+        "\"windspeed\":14.8,\"winddirection\":113.0,\"weathercode\":3,\"time\":1672653600},"
+        "\"hourly_units\":{\"time\":\"unixtime\",\"temperature_2m\":\"\\u00b0C\"},\"hourly\":{";
+    for (const char* field = order; *field; field++) {
+        static const char* names[] = { "time", "temperature_2m", "weathercode", "windspeed_10m", "winddirection_10m" };
+        body += field == order ? "\"" : ",\"";
+        body += names[*field - '0'];
+        body += "\":[";
+        for (int i = 0; i < 72; i++) {
+            char item[24];
+            switch (*field - '0') {
+                case 0: snprintf(item, sizeof(item), "%ld", base + i * 3600L); break;
+                case 1: snprintf(item, sizeof(item), "%.1f", hourlyTemperature(i)); break;
+                case 2: snprintf(item, sizeof(item), "%d", hourlyWeatherCode(i)); break;
+                case 3: snprintf(item, sizeof(item), "%.1f", hourlyWindSpeed(i)); break;
+                case 4: snprintf(item, sizeof(item), "%.0f", hourlyWindDirection(i)); break;
+            }
+            body += i ? "," : "";
+            body += item;
+        }
+        body += "]";
+    }
+    return body + "}}";
+}
+
+// count hours of the next two days differing from the source beyond quantization step
+static int hourlyMismatches(const ForecastSeries& series, time_t now) {
+    int mismatches = 0;
+    long base = now / 86400 * 86400;
+    for (int i = 0; i < 72; i++) {
+        time_t hour = base + i * 3600L;
+        const ForecastHour* record = series.at(hour);
+        bool expected = hour / 3600 >= now / 3600 && hour / 3600 < now / 3600 + FORECAST_SERIES_HOURS;
+        if (record == NULL) {
+            mismatches += expected;
+            continue;
+        }
+        float direction = fabsf(record->getWindDirection() - hourlyWindDirection(i));
+        mismatches += !expected || fabsf(record->getTemperature() - hourlyTemperature(i)) > 0.051F ||
+            fabsf(record->getWindSpeed() - hourlyWindSpeed(i)) > 0.251F ||
+            min(direction, 360 - direction) > 0.71F || record->getWeatherCode() != hourlyWeatherCode(i);
+    }
+    return mismatches;
+}
+
+// previous implementation: whole body in a String, fixed field order sscanf
+static bool legacyParse(const String& data, float* temperature) {
+    const char* wdata = strstr(data.c_str(), "{\"temperature\":");
+    float windspeed, winddir;
+    int weathercode;
+    return wdata && sscanf(wdata,
+        "{\"temperature\":%f,\"windspeed\":%f,\"winddirection\":%f,\"weathercode\":%d}",
+        temperature, &windspeed, &winddir, &weathercode) == 4;
+}
+
+static bool legacyPull(float* temperature) {
+    WiFiClient wifi;
+    HTTPClient http;
+    http.begin(wifi, String("http://api.open-meteo.com/v1/forecast"));
+    return http.GET() == HTTP_CODE_OK && legacyParse(http.getString(), temperature);
+}
+
+// drives asynchronous fetch the way loop() does, one step per simulated millisecond
+static bool fetch(ForecastProvider& provider) {
+    bool received = provider.pull();
+    while (provider.isFetching()) {
+        delay(1);
+        received = provider.pull();
+    }
+    return received;
+}
+
+// records value sequence, used to check chunk boundaries do not change parsing
+class RecordingListener : public JsonListener {
+    public:
+    std::string record;
+
+    void onJsonValue(const JsonPath& path, const char* value, bool string) override {
+        for (uint8_t i = 0; i < path.depth; i++) {
+            record += path.indexes[i] < 0 ? path.keys[i] : std::to_string(path.indexes[i]);
+            record += '/';
+        }
+        record += string ? "s:" : "l:";
+        record += value;
+        record += '\n';
+    }
+};
+
+static bool parseChunked(const char* body, size_t chunk, std::string* record) {
+    RecordingListener listener;
+    JsonStreamParser parser(&listener);
+    size_t size = strlen(body);
+    for (size_t i = 0; i < size && !parser.isFailed(); i += chunk) {
+        parser.feed(body + i, min(chunk, size - i));
+    }
+    bool valid = parser.finish();
+    *record = listener.record;
+    return valid;
+}
+
+BENCHMARK(forecast) {
+    firmwareBoot();
+    int passed = 0, count = sizeof(corpus) / sizeof(corpus[0]);
+    for (const ForecastCase& test : corpus) {
+        hal::setHttpResponse(HTTP_CODE_OK, test.body);
+        ForecastProvider provider(FORECAST_LATITUDE, FORECAST_LONGITUDE);
+        bool received = fetch(provider);
+        bool expected = received == test.valid && (!received ||
+            (fabsf(provider.getForecast().getTemperature() - test.temperature) < 0.01F &&
+            provider.getForecast().toString("%w") == String((int)test.weathercode)));
+
+        std::string whole, chunked;
+        bool valid = parseChunked(test.body, strlen(test.body), &whole);
+        for (size_t chunk = 1; chunk <= 64 && expected; chunk++) {
+            expected = parseChunked(test.body, chunk, &chunked) == valid && chunked == whole;
+        }
+        if (expected) {
+            passed++;
+        }
+        else note("corpus case failed", "%s", test.name);
+    }
+    note("corpus cases as expected", "%d of %d", passed, count);
+
+    // hourly series in response order of the service and reordered, then incomplete one
+    int mismatches = 0;
+    time_t now = time(NULL);
+    for (const char* order : { "01234", "42130" }) {
+        std::string hourly = hourlyResponse(now, order);
+        hal::setHttpResponse(HTTP_CODE_OK, hourly.c_str());
+        ForecastProvider provider(FORECAST_LATITUDE, FORECAST_LONGITUDE);
+        mismatches += !fetch(provider) || provider.getSeries().hoursAhead(now) != FORECAST_SERIES_HOURS;
+        mismatches += hourlyMismatches(provider.getSeries(), now);
+    }
+    std::string partial = hourlyResponse(now, "0123");
+    hal::setHttpResponse(HTTP_CODE_OK, partial.c_str());
+    ForecastProvider partialProvider(FORECAST_LATITUDE, FORECAST_LONGITUDE);
+    mismatches += !fetch(partialProvider) || partialProvider.getSeries().at(now) != NULL;
+    note("hourly records differing", "%d of %d", mismatches, 2 * FORECAST_SERIES_HOURS);
+
+    std::string hourly = hourlyResponse(now, "01234");
+    hal::setHttpResponse(HTTP_CODE_OK, hourly.c_str());
+    static ForecastProvider seriesProvider(FORECAST_LATITUDE, FORECAST_LONGITUDE);
+    fetch(seriesProvider);
+    const ForecastSeries& series = seriesProvider.getSeries();
+    Samples lookup(100000);
+    float sum = 0;
+    for (int i = 0; i < 100000; i++) {
+        time_t time = now + (i % FORECAST_SERIES_HOURS) * 3600L;
+        measure(lookup, [&]() { sum += series.at(time)->getTemperature(); });
+    }
+    lookup.report("ForecastSeries::at()");
+    note("hourly response bytes", "%zu", hourly.size());
+    note("series bytes", "%zu for %d hours, %zu per hour (Forecast %zu)", sizeof(ForecastSeries),
+        FORECAST_SERIES_HOURS, sizeof(ForecastHour), sizeof(Forecast));
+
+    std::string large = largeResponse();
+    Samples stream(2000), legacy(2000);
+    uint32_t streamPeak = 0, legacyPeak = 0;
+    hal::setHttpResponse(HTTP_CODE_OK, large.c_str());
+    for (int i = 0; i < 2000; i++) {
+        ForecastProvider provider(FORECAST_LATITUDE, FORECAST_LONGITUDE);
+        uint32_t heap = hal::heapUsed();
+        hal::resetHeapPeak();
+        measure(stream, [&]() { fetch(provider); });
+        streamPeak = max(streamPeak, hal::heapPeak() - heap);
+
+        float temperature;
+        heap = hal::heapUsed();
+        hal::resetHeapPeak();
+        measure(legacy, [&]() { legacyPull(&temperature); });
+        legacyPeak = max(legacyPeak, hal::heapPeak() - heap);
+    }
+    stream.report("fetch, streaming parser");
+    legacy.report("GET, String + sscanf (previous)");
+    note("response bytes", "%zu", large.size());
+    note("peak heap, streaming parser", "%u bytes", streamPeak);
+    note("peak heap, String + sscanf", "%u bytes", legacyPeak);
+    note("parser object bytes", "%zu", sizeof(JsonStreamParser));
+
+    // slow link, every pull() step must stay short while fetch takes seconds
+    hal::setNetworkDelays(200, 300);
+    hal::setHttpResponse(HTTP_CODE_OK, large.c_str(), 3000);
+    Samples steps(100000);
+    uint64_t blocked = hal::uptimeMicros();
+    float temperature;
+    legacyPull(&temperature);
+    blocked = hal::uptimeMicros() - blocked;
+    ForecastProvider provider(FORECAST_LATITUDE, FORECAST_LONGITUDE);
+    bool received = false;
+    measure(steps, [&]() { received = provider.pull(); });
+    while (provider.isFetching()) {
+        delay(1);
+        measure(steps, [&]() { received = provider.pull(); });
+    }
+    steps.report("pull() step, slow link");
+    note("fetch result", "%s", received ? "OK" : "FAILED");
+    for (int phase = FETCH_RESOLVE; phase < FETCH_PHASES; phase++) {
+        char label[24];
+        snprintf(label, sizeof(label), "  phase %s", ForecastProvider::getPhaseName((ForecastFetchPhase)phase));
+        note(label, "%u ms", provider.getPhaseMillis((ForecastFetchPhase)phase));
+    }
+    note("longest pull() step, simulated", "%u us", provider.getStepMicrosMax());
+    note("blocking GET (previous), simulated", "%.0f ms", blocked / 1000.0);
+    hal::setNetworkDelays(0, 0);
+
+    Samples parse(2000);
+    for (int i = 0; i < 2000; i++) {
+        measure(parse, [&]() {
+            JsonStreamParser parser;
+            parser.feed(large.data(), large.size());
+            parser.finish();
+        });
+    }
+    parse.report("JsonStreamParser::feed(), no listener");
+    note("parser throughput", "%.1f MB/s", large.size() * 1000.0 / parse.mean());
+}
+
+BENCHMARK(snapshot) {
+    firmwareBoot();
+    time_t now = time(NULL);
+    std::string hourly = hourlyResponse(now, "01234");
+    hal::setHttpResponse(HTTP_CODE_OK, hourly.c_str());
+    LittleFS.remove(FORECAST_SNAPSHOT_FILE);
+
+    // written after fetch, restored by a new provider as after reboot
+    int failures = 0;
+    ForecastProvider fetched(FORECAST_LATITUDE, FORECAST_LONGITUDE);
+    failures += fetched.restore(LittleFS);
+    failures += !fetch(fetched);
+    fetched.pull();
+    File file = LittleFS.open(FORECAST_SNAPSHOT_FILE, "r");
+    size_t size = file.size();
+    file.close();
+
+    ForecastProvider restored(FORECAST_LATITUDE, FORECAST_LONGITUDE);
+    failures += !restored.restore(LittleFS) || restored.hasForecastFor(3600);
+    failures += !restored.pull() || !restored.hasForecastFor(3600) ||
+        restored.getForecast().toString() != fetched.getForecast().toString() ||
+        hourlyMismatches(restored.getSeries(), now) != 0;
+
+    // reboot with WiFi up before the clock is synchronized, it runs from a day behind the
+    // snapshot, no request until clock passes it, then restored forecast shown without one
+    struct timeval clock, boot = { (time_t)(fetched.getForecast().getTimestamp() - 86400), 0 };
+    gettimeofday(&clock, NULL);
+    settimeofday(&boot, NULL);
+    ForecastProvider unsynced(FORECAST_LATITUDE, FORECAST_LONGITUDE);
+    uint32_t unsyncedRequests = hal::httpRequests();
+    failures += !unsynced.restore(LittleFS);
+    for (int i = 0; i < 100; i++) {
+        fetch(unsynced);
+        delay(100);
+    }
+    settimeofday(&clock, NULL);
+    bool shown = fetch(unsynced) && unsynced.hasForecastFor(3600);
+    unsyncedRequests = hal::httpRequests() - unsyncedRequests;
+    failures += unsyncedRequests + !shown;
+
+    // damaged and truncated snapshots are rejected
+    file = LittleFS.open(FORECAST_SNAPSHOT_FILE, "r+");
+    file.seek(size / 2);
+    uint8_t byte = file.peek() ^ 0x10;
+    file.write(&byte, 1);
+    file.close();
+    ForecastProvider damaged(FORECAST_LATITUDE, FORECAST_LONGITUDE);
+    failures += damaged.restore(LittleFS) || damaged.hasForecastFor(86400);
+    file = LittleFS.open(FORECAST_SNAPSHOT_FILE, "w");
+    file.write((const uint8_t*)"\x00\x01", 2);
+    file.close();
+    failures += damaged.restore(LittleFS);
+    note("snapshot checks failed", "%d", failures);
+    note("snapshot bytes", "%zu", size);
+    note("unsynced clock reboot", "%u requests, restored forecast shown %s", unsyncedRequests, shown ? "yes" : "no");
+
+    fetched.store();
+    Samples restore(1000);
+    for (int i = 0; i < 1000; i++) {
+        ForecastProvider provider(FORECAST_LATITUDE, FORECAST_LONGITUDE);
+        measure(restore, [&]() { provider.restore(LittleFS); });
+    }
+    restore.report("ForecastProvider::restore()");
+
+    // a day of forecast refreshes every 10 minutes
+    ForecastProvider daily(FORECAST_LATITUDE, FORECAST_LONGITUDE, 600);
+    daily.restore(LittleFS);
+    uint32_t written = hal::fsBytesWritten(), requests = hal::httpRequests();
+    for (int i = 0; i < 24 * 6; i++) {
+        fetch(daily);
+        daily.pull();
+        hal::advance(600000000ULL);
+    }
+    note("fetches per day", "%u", hal::httpRequests() - requests);
+    note("snapshot writes per day", "%u", (hal::fsBytesWritten() - written) / (uint32_t)size);
+}
+
+// previous implementation: replace loop over String per option
+static String legacyToString(const Forecast& forecast, const char* format) {
+    String builder(format);
+    while (builder.indexOf("%m") >= 0) {
+        builder.replace("%m", String(forecast.getTimestamp()));
+    }
+    while (builder.indexOf("%w") >= 0) {
+        builder.replace("%w", String(forecast.getWeatherCode()));
+    }
+    while (builder.indexOf("%W") >= 0) {
+        builder.replace("%W", Forecast::getWeatherCodeDescription(forecast.getWeatherCode()));
+    }
+    while (builder.indexOf("%t") >= 0) {
+        builder.replace("%t", String(forecast.getTemperature(), 1));
+    }
+    while (builder.indexOf("%s") >= 0) {
+        builder.replace("%s", String(forecast.getWindSpeed() / 3.6F, 1));
+    }
+    while (builder.indexOf("%S") >= 0) {
+        builder.replace("%S", String(forecast.getWindSpeed(), 1));
+    }
+    while (builder.indexOf("%d") >= 0) {
+        builder.replace("%d", String(forecast.getWindDirection(), 1));
+    }
+    while (builder.indexOf("%e") >= 0) {
+        builder.replace("%e", Forecast::getWorldSide(forecast.getWindDirection(), true));
+    }
+    while (builder.indexOf("%E") >= 0) {
+        builder.replace("%E", Forecast::getWorldSide(forecast.getWindDirection(), false));
+    }
+    return builder;
+}
+
+BENCHMARK(format) {
+    firmwareBoot();
+    static const u8 codes[] = { 0, 1, 2, 3, 45, 61, 73, 95 };
+    int differing = 0, count = 0;
+    for (int i = 0; i < 400; i++) {
+        char body[192];
+        snprintf(body, sizeof(body), "{\"current_weather\":{\"temperature\":%.1f,\"windspeed\":%.1f,"
+            "\"winddirection\":%d,\"weathercode\":%d}}", -30.0 + i * 0.17, i * 0.3, i * 7 % 360, codes[i % 8]);
+        hal::setHttpResponse(HTTP_CODE_OK, body);
+        ForecastProvider provider(FORECAST_LATITUDE, FORECAST_LONGITUDE);
+        fetch(provider);
+        for (const char* format : { FORECAST_FORMAT_TEXT, FORECAST_FORMAT_JSON, "%e %d %S %m %%w %x" }) {
+            char buffer[FORECAST_FORMAT_BUFFER];
+            provider.getForecast().toString(buffer, sizeof(buffer), ForecastFormat(format));
+            differing += legacyToString(provider.getForecast(), format) != buffer;
+            count++;
+        }
+    }
+    note("outputs differing from previous", "%d of %d", differing, count);
+
+    hal::setHttpResponse(HTTP_CODE_OK, corpus[0].body);
+    static ForecastProvider provider(FORECAST_LATITUDE, FORECAST_LONGITUDE);
+    fetch(provider);
+    const Forecast& forecast = provider.getForecast();
+    Samples legacyText(20000), legacyJson(20000), text(20000), json(20000), compile(20000);
+    char buffer[FORECAST_FORMAT_BUFFER];
+    for (int i = 0; i < 20000; i++) {
+        measure(legacyText, [&]() { legacyToString(forecast, FORECAST_FORMAT_TEXT); });
+        measure(legacyJson, [&]() { legacyToString(forecast, FORECAST_FORMAT_JSON); });
+        measure(text, [&]() { forecast.toString(buffer, sizeof(buffer)); });
+        measure(json, [&]() { forecast.toString(buffer, sizeof(buffer), ForecastFormat::json()); });
+        measure(compile, [&]() { forecast.toString(buffer, sizeof(buffer), ForecastFormat(FORECAST_FORMAT_JSON)); });
+    }
+    legacyText.report("text, String replace (previous)");
+    text.report("text, compiled format");
+    legacyJson.report("JSON, String replace (previous)");
+    json.report("JSON, compiled format");
+    compile.report("JSON, format compiled per call");
+    note("speedup", "%.1fx text, %.1fx JSON", legacyText.mean() / text.mean(), legacyJson.mean() / json.mean());
+    note("format program bytes", "%zu", sizeof(ForecastFormat));
+}
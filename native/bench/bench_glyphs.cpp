@@ -0,0 +1,66 @@
+/******************************************************************************
+ * (c) Skatech Research Lab, 2000-2026.
+ * Last change: 2026.10.16
+ * Host-native benchmark of the clock face digits: font decoding vs glyph cache
+ *****************************************************************************/
+
+#include "bench.h"
+#include "GlyphCache.h"
+
+static void drawFont(U8G2& u8g2, const char* time, bool colon) {
+    u8g2.clearBuffer();
+    u8g2.setFont(u8g2_font_logisoso32_tn);
+    u8g2.setFontRefHeightExtendedText();
+    u8g2.setDrawColor(1);
+    u8g2.setFontPosTop();
+    u8g2.setFontDirection(0);
+    u8g2.drawStr(14, 0, time);
+    if (colon) {
+        u8g2.drawStr(58, 0, ":");
+    }
+}
+
+static void drawCache(U8G2& u8g2, const GlyphCache& cache, const char* time, bool colon) {
+    u8g2.clearBuffer();
+    cache.drawStr(u8g2, 14, 0, time);
+    if (colon) {
+        cache.drawStr(u8g2, 58, 0, ":");
+    }
+}
+
+BENCHMARK(glyphs) {
+    static U8G2_SSD1306_128X64_NONAME_F_SW_I2C u8g2(U8G2_R0, 0, 0);
+    static uint8_t reference[128 * 8];
+    GlyphCache cache;
+    uint32_t heap = hal::heapUsed();
+    cache.build(u8g2, u8g2_font_logisoso32_tn, "0123456789: ");
+    uint32_t cacheBytes = hal::heapUsed() - heap;
+
+    char times[1440][6];
+    for (int i = 0; i < 1440; i++) {
+        snprintf(times[i], sizeof(times[i]), "%02d %02d", i / 60, i % 60);
+    }
+
+    int mismatches = 0;
+    for (int i = 0; i < 1440; i++) {
+        drawFont(u8g2, times[i], i % 2);
+        memcpy(reference, u8g2.getBufferPtr(), sizeof(reference));
+        drawCache(u8g2, cache, times[i], i % 2);
+        mismatches += memcmp(reference, u8g2.getBufferPtr(), sizeof(reference)) != 0;
+    }
+
+    Samples font(14400), cached(14400);
+    for (int i = 0; i < 14400; i++) {
+        const char* time = times[i % 1440];
+        measure(font, [&]() { drawFont(u8g2, time, i % 2); });
+    }
+    for (int i = 0; i < 14400; i++) {
+        const char* time = times[i % 1440];
+        measure(cached, [&]() { drawCache(u8g2, cache, time, i % 2); });
+    }
+    font.report("clock face, font decoding");
+    cached.report("clock face, glyph cache");
+    note("speedup", "%.1fx", font.mean() / cached.mean());
+    note("glyph cache bytes", "%u", cacheBytes);
+    note("frames differing from font path", "%d of 1440", mismatches);
+}
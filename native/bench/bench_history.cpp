@@ -0,0 +1,182 @@
+/******************************************************************************
+ * (c) Skatech Research Lab, 2000-2026.
+ * Last change: 2026.10.17
+ * Host-native benchmark of weather history, appends with segment rotation and
+ * range queries checked against downsampling of every sample kept
+ *****************************************************************************/
+
+#include <ESP8266WebServer.h>
+#include <string>
+
+#include "bench.h"
+#include "WeatherHistory.h"
+
+#define BENCH_HISTORY_START 1767225600  // 2026-01-01
+#define BENCH_HISTORY_PERIOD 600        // seconds between samples, forecast refresh of the firmware
+#define BENCH_HISTORY_WEEKS 20          // more than segments keep, oldest ones rotated out
+#define BENCH_HISTORY_QUERIES 200
+
+void loop();
+
+extern ESP8266WebServer server;
+extern WeatherHistory history;
+
+class TextCapture : public Print {
+    public:
+    std::string text;
+
+    size_t write(uint8_t c) override {
+        text += (char)c;
+        return 1;
+    }
+
+    size_t write(const uint8_t* data, size_t size) override {
+        text.append((const char*)data, size);
+        return size;
+    }
+};
+
+// every sample kept is read, buckets written as WeatherHistory writes them
+static std::string expectedQuery(const std::vector<WeatherSample>& samples, uint32_t oldest,
+        uint32_t from, uint32_t till, uint32_t step, uint8_t field) {
+    TextCapture capture;
+    JsonWriter json(capture);
+    json.beginObject().member("from", from).member("till", till).member("step", step)
+        .member("field", field == HISTORY_FIELD_WINDSPEED ? "windspeed" : "temperature")
+        .key("buckets").beginArray();
+    for (size_t i = 0; i < samples.size(); ) {
+        if (samples[i].time < max(from, oldest) || samples[i].time >= till) {
+            i++;
+            continue;
+        }
+        uint32_t bucket = from + (samples[i].time - from) / step * step;
+        int32_t low = INT32_MAX, high = INT32_MIN, sum = 0, count = 0;
+        for (; i < samples.size() && samples[i].time < min(bucket + step, till); i++) {
+            int32_t value = field == HISTORY_FIELD_WINDSPEED ? samples[i].windspeed * 10 : samples[i].temperature;
+            low = min(low, value);
+            high = max(high, value);
+            sum += value;
+            count++;
+        }
+        json.beginArray().value(bucket).value(low, 10).value(high, 10)
+            .value((sum + (sum < 0 ? -count / 2 : count / 2)) / count, 10).value((uint32_t)count).endArray();
+    }
+    json.endArray().endObject();
+    return capture.text;
+}
+
+typedef std::vector<std::pair<std::string, std::string>> Fields;
+
+static std::string historyRequest(const Fields& args, int* code) {
+    server.simulate({ HTTP_GET, "/get-history", args, { }, true });
+    hal::advance(hal::radioReceiveMicros(hal::uptimeMicros()) - hal::uptimeMicros());
+    server.handleClient();
+    *code = server.lastResponse().code;
+    return server.lastResponse().body;
+}
+
+BENCHMARK(history) {
+    FS storage;
+    storage.begin();
+    WeatherHistory weather;
+    weather.begin(storage);
+    std::vector<WeatherSample> samples;
+    int problems = 0;
+    uint32_t seed = 2026;
+
+    // outside temperature around a daily swing, wind in gusts
+    Samples appends(BENCH_HISTORY_WEEKS * 7 * 86400 / BENCH_HISTORY_PERIOD);
+    uint32_t written = hal::fsBytesWritten();
+    for (uint32_t time = BENCH_HISTORY_START; time < BENCH_HISTORY_START + BENCH_HISTORY_WEEKS * 7 * 86400;
+            time += BENCH_HISTORY_PERIOD) {
+        seed = seed * 1664525 + 1013904223;
+        float temperature = -5 + 8 * sinf((time % 86400) * 2 * M_PI / 86400) + (seed >> 24) / 64.0f;
+        float windspeed = (seed >> 16 & 0xFF) / 8.0f;
+        WeatherSample sample = { time, (int16_t)lroundf(temperature * 10), (uint8_t)lroundf(windspeed), 3 };
+        samples.push_back(sample);
+        measure(appends, [&]() { problems += !weather.append(time, temperature, windspeed, 3); });
+    }
+    written = (hal::fsBytesWritten() - written) / samples.size();
+    problems += weather.append(samples.back().time, 0, 0, 0) + weather.append(1000000000, 0, 0, 0);
+    uint32_t oldest = weather.getOldest(), newest = weather.getNewest();
+    uint32_t kept = 0;
+    for (const WeatherSample& sample : samples) {
+        kept += sample.time >= oldest;
+    }
+    problems += weather.getSegments() != HISTORY_SEGMENTS || weather.getSamples() != kept;
+
+    // windows of a day, a week and all history, from random points
+    struct Window { const char* label; uint32_t length, step; } windows[] = {
+        { "day by hour", 86400, 3600 }, { "week by 6 hours", 7 * 86400, 6 * 3600 },
+        { "all by day", newest - oldest + 1, 86400 } };
+    for (const Window& window : windows) {
+        Samples queries(BENCH_HISTORY_QUERIES);
+        uint32_t read = hal::fsBytesRead(), mismatched = 0;
+        for (int i = 0; i < BENCH_HISTORY_QUERIES; i++) {
+            seed = seed * 1664525 + 1013904223;
+            uint32_t from = oldest - 86400 + (seed >> 8) % (newest - oldest + 2 * 86400 - window.length + 1);
+            uint8_t field = i % 2 ? HISTORY_FIELD_WINDSPEED : HISTORY_FIELD_TEMPERATURE;
+            TextCapture output;
+            measure(queries, [&]() { weather.query(output, from, from + window.length, window.step, field); });
+            mismatched += output.text != expectedQuery(samples, oldest, from, from + window.length, window.step, field);
+        }
+        read = hal::fsBytesRead() - read;
+        char label[64];
+        snprintf(label, sizeof(label), "query(), %s", window.label);
+        queries.report(label);
+        note(label, "%u bytes read per query of %u kept, %u mismatched", read / BENCH_HISTORY_QUERIES,
+            (unsigned)(kept * sizeof(WeatherSample)), mismatched);
+        problems += mismatched;
+    }
+
+    // reboot, index from the directory, torn tail of the newest segment is left behind
+    Dir dir = storage.openDir(HISTORY_DIRECTORY);
+    std::string newestPath;
+    while (dir.next()) {
+        newestPath = std::string(HISTORY_DIRECTORY "/") + dir.fileName().c_str();
+    }
+    storage.open(newestPath.c_str(), "a").write((const uint8_t*)"\x01\x02\x03", 3);
+    WeatherHistory rebooted;
+    uint32_t read = hal::fsBytesRead();
+    uint64_t start = benchNanos();
+    rebooted.begin(storage);
+    uint64_t bootNanos = benchNanos() - start;
+    read = hal::fsBytesRead() - read;
+    uint32_t next = newest + BENCH_HISTORY_PERIOD;
+    samples.push_back({ next, 125, 4, 3 });
+    problems += rebooted.getNewest() != newest || rebooted.getSamples() != weather.getSamples() ||
+        !rebooted.append(next, 12.5f, 4, 3);
+    TextCapture output;
+    rebooted.query(output, newest - 86400, next + 1, 3600, HISTORY_FIELD_TEMPERATURE);
+    problems += output.text != expectedQuery(samples, rebooted.getOldest(), newest - 86400, next + 1, 3600,
+        HISTORY_FIELD_TEMPERATURE);
+
+    // firmware keeps every forecast received once its clock is set, clock stays synchronized
+    // for benchmarks that follow
+    firmwareBoot();
+    int code, rejected = 0;
+    hal::setEpochTime(BENCH_HISTORY_START);
+    uint32_t before = history.getSamples();
+    uint64_t until = hal::uptimeMicros() + 1200 * 1000000ULL;
+    while (hal::uptimeMicros() < until && history.getSamples() < before + 2) {
+        loop();
+    }
+    std::string body = historyRequest({ { "step", "600" } }, &code);
+    problems += code != 200 || body.find("\"buckets\":[[") == std::string::npos ||
+        history.getSamples() < before + 2;
+    for (const Fields& query : { Fields { { "step", "0" } }, Fields { { "from", "100" }, { "till", "50" } },
+            Fields { { "from", "0" }, { "till", "1000000" }, { "step", "60" } }, Fields { { "field", "pressure" } } }) {
+        historyRequest(query, &code);
+        rejected += code == 400;
+    }
+    problems += rejected != 4;
+
+    appends.report("append()");
+    note("append()", "%u bytes written per sample, %u segments of %u samples kept", written,
+        (unsigned)weather.getSegments(), (unsigned)HISTORY_SEGMENT_SAMPLES);
+    note("begin(), reboot", "%.1f us, %u bytes read, torn tail skipped, %u segments", bootNanos / 1000.0, read,
+        (unsigned)rebooted.getSegments());
+    note("firmware history", "%u samples appended, GET /get-history %zu bytes, %d of 4 bad queries rejected",
+        (unsigned)(history.getSamples() - before), body.size(), rejected);
+    note("history problems", "%d", problems);
+}
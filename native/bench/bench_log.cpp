@@ -0,0 +1,119 @@
+/******************************************************************************
+ * (c) Skatech Research Lab, 2000-2026.
+ * Last change: 2026.10.17
+ * Host-native benchmark of logging, blocking UART prints against lines kept in
+ * a ring buffer and drained in idle time
+ *****************************************************************************/
+
+#include <ESP8266WebServer.h>
+
+#include "bench.h"
+#include "Logger.h"
+#include "LatencyHistogram.h"
+
+#define BENCH_LOG_BURST 30              // lines of a request burst, fit the ring
+#define BENCH_LOG_SECONDS 60
+
+void loop();
+
+extern ESP8266WebServer server;
+extern LatencyHistogram faceLatency;
+
+class LogCapture : public Print {
+    public:
+    std::string text;
+
+    size_t write(uint8_t c) override {
+        text += (char)c;
+        return 1;
+    }
+};
+
+// every line starts with uptime and level letter and ends with a line feed
+static int malformedLines(const std::string& text) {
+    int malformed = text.size() && text.back() != '\n';
+    for (size_t start = 0, end; (end = text.find('\n', start)) != std::string::npos; start = end + 1) {
+        unsigned long seconds, ms;
+        char level;
+        malformed += sscanf(text.c_str() + start, "%lu.%3lu %c ", &seconds, &ms, &level) != 3 ||
+            !strchr("EWID", level);
+    }
+    return malformed;
+}
+
+BENCHMARK(log) {
+    firmwareBoot();
+    Logger& logger = Logger::system();
+    while (logger.isPending()) {
+        loop();
+    }
+
+    // previous: burst printed straight to the UART, writes wait once the FIFO is full
+    uint64_t blocked = hal::serialBlockedMicros(), start = hal::uptimeMicros();
+    for (int i = 0; i < BENCH_LOG_BURST; i++) {
+        Serial.printf("Display scheme updated, brightness %d, request %d\r\n", 25, i);
+    }
+    uint64_t printBlocked = hal::serialBlockedMicros() - blocked, printHeld = hal::uptimeMicros() - start;
+    hal::advance(printBlocked + 20000);
+
+    Samples lines(BENCH_LOG_BURST);
+    blocked = hal::serialBlockedMicros();
+    start = hal::uptimeMicros();
+    uint32_t bytes = hal::serialBytes(), lost = logger.getLost();
+    for (int i = 0; i < BENCH_LOG_BURST; i++) {
+        measure(lines, [&]() { LOG_INFO("Display scheme updated, brightness %d, request %d", 25, i); });
+    }
+    uint64_t logHeld = hal::uptimeMicros() - start;
+    uint64_t drainStart = hal::uptimeMicros();
+    while (logger.isPending()) {
+        loop();
+    }
+    uint64_t drained = hal::uptimeMicros() - drainStart;
+    uint32_t logBlocked = hal::serialBlockedMicros() - blocked, logBytes = hal::serialBytes() - bytes;
+
+    // ring overflow while the UART is slower, whole oldest lines skipped
+    for (int i = 0; i < 200; i++) {
+        LOG_DEBUG("not compiled in at default level %d", i);
+        LOG_WARN("Forecast fetch FAILED: connect, phase connect, status %d, attempt %d", 0, i);
+    }
+    uint32_t overflowLost = logger.getLost() - lost;
+    while (logger.isPending()) {
+        loop();
+    }
+
+    // firmware under requests logging every second, face pushes stay on time
+    faceLatency.reset();
+    blocked = hal::serialBlockedMicros();
+    uint64_t until = hal::uptimeMicros() + BENCH_LOG_SECONDS * 1000000ULL;
+    while (hal::uptimeMicros() < until) {
+        server.simulate({ HTTP_POST, "/set-display", { { "brightness", "25" },
+            { "colors", "0808220000443333AAFF0000001100" } }, { }, true });
+        uint64_t next = hal::uptimeMicros() + 1000000;
+        while (hal::uptimeMicros() < next) {
+            loop();
+        }
+    }
+    uint32_t runBlocked = hal::serialBlockedMicros() - blocked;
+
+    server.simulate({ HTTP_GET, "/log", { }, { }, true });
+    uint32_t served = server.served();
+    while (server.served() == served) {
+        loop();
+    }
+    const std::string& body = server.lastResponse().body;
+    LogCapture ring;
+    logger.printTo(ring);
+
+    lines.report("LOG_INFO()");
+    note("burst of lines, Serial.printf", "%d lines, loop held %.1f ms, blocked %.1f ms", BENCH_LOG_BURST,
+        printHeld / 1000.0, printBlocked / 1000.0);
+    note("burst of lines, LOG_INFO", "loop held %.1f ms, blocked %.1f ms, drained in %.1f ms idle, %u bytes",
+        logHeld / 1000.0, logBlocked / 1000.0, drained / 1000.0, logBytes);
+    note("ring overflow", "%u bytes skipped by the UART, whole lines", overflowLost);
+    note("requests logging", "%d s, UART blocked %.1f ms, face latency max %.2f ms", BENCH_LOG_SECONDS,
+        runBlocked / 1000.0, faceLatency.getMax() / 1000.0);
+    note("GET /log", "%zu bytes, %d lines malformed", body.size(), malformedLines(body));
+    note("log problems", "%d", (logBlocked > 0) + (runBlocked > 0) + (overflowLost == 0) + malformedLines(body) +
+        (body != ring.text) + (body.find("Display scheme updated") == std::string::npos) +
+        (body.find("not compiled in") != std::string::npos));
+}
@@ -0,0 +1,103 @@
+/******************************************************************************
+ * (c) Skatech Research Lab, 2000-2026.
+ * Last change: 2026.10.16
+ * Host-native benchmark harness - entry point, runs all or named benchmarks
+ *   usage: program [-v] [benchmark-name...]
+ *****************************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdarg.h>
+
+#include "bench.h"
+#include "FS.h"
+
+Benchmark* Benchmark::first = nullptr;
+
+Benchmark::Benchmark(const char* name, BenchmarkFunction function)
+        : name(name), function(function), next(nullptr) {
+    Benchmark** tail = &first;
+    while (*tail) {
+        tail = &(*tail)->next;
+    }
+    *tail = this;
+}
+
+uint64_t benchNanos() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+double Samples::mean() const {
+    uint64_t total = 0;
+    for (uint64_t nanos : _nanos) {
+        total += nanos;
+    }
+    return _nanos.empty() ? 0 : (double)total / _nanos.size();
+}
+
+void Samples::report(const char* label) {
+    if (_nanos.empty()) {
+        printf("  %-40s %10s\n", label, "no samples");
+        return;
+    }
+    double average = mean();
+    std::sort(_nanos.begin(), _nanos.end());
+    printf("  %-40s %10zu %10.0f %10llu %10llu %10llu %9.2f\n", label, _nanos.size(), average,
+        (unsigned long long)_nanos[_nanos.size() / 2],
+        (unsigned long long)_nanos[_nanos.size() * 99 / 100],
+        (unsigned long long)_nanos.back(), (double)_allocations / _nanos.size());
+}
+
+int copyHostFiles(FS& fs, const char* directory) {
+    int count = 0;
+    std::error_code error;
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(directory, error)) {
+        if (!entry.is_regular_file()) {
+            continue;
+        }
+        std::ifstream input(entry.path(), std::ios::binary);
+        std::vector<char> data((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+        std::string path = "/" + std::filesystem::relative(entry.path(), directory).generic_string();
+        File file = fs.open(path.c_str(), "w");
+        file.write((const uint8_t*)data.data(), data.size());
+        count++;
+    }
+    return count;
+}
+
+void note(const char* label, const char* format, ...) {
+    char value[96];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(value, sizeof(value), format, args);
+    va_end(args);
+    printf("  %-40s %s\n", label, value);
+}
+
+int main(int argc, char** argv) {
+    std::vector<const char*> names;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-v") == 0) {
+            hal::setSerialEcho(true);
+        }
+        else names.push_back(argv[i]);
+    }
+
+    printf("ESP8266 OLED-SSD1306 Clock host benchmarks\n");
+    printf("  %-40s %10s %10s %10s %10s %10s %9s\n",
+        "operation", "count", "mean ns", "p50 ns", "p99 ns", "max ns", "allocs/op");
+
+    for (Benchmark* bench = Benchmark::first; bench; bench = bench->next) {
+        bool selected = names.empty() || std::any_of(names.begin(), names.end(),
+            [bench](const char* name) { return strcmp(name, bench->name) == 0; });
+        if (selected) {
+            printf("[%s]\n", bench->name);
+            bench->function();
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,145 @@
+/******************************************************************************
+ * (c) Skatech Research Lab, 2000-2026.
+ * Last change: 2026.10.17
+ * Host-native benchmark of run time metrics, recording cost and /metrics
+ * output checked as Prometheus text format
+ *****************************************************************************/
+
+#include <ESP8266WebServer.h>
+#include <map>
+#include <set>
+#include <sstream>
+
+#include "bench.h"
+#include "Metrics.h"
+
+#define BENCH_METRICS_RECORDS 100000
+#define BENCH_METRICS_SECONDS 60
+#define BENCH_METRICS_SCRAPES 100
+
+void loop();
+
+extern ESP8266WebServer server;
+
+static void metricsRequest(HTTPMethod method, const char* uri, Samples* samples = NULL) {
+    server.simulate({ method, uri, { }, { }, true });
+    hal::advance(hal::radioReceiveMicros(hal::uptimeMicros()) - hal::uptimeMicros());
+    if (samples) {
+        measure(*samples, []() { server.handleClient(); });
+    }
+    else server.handleClient();
+}
+
+// Check exposition lines, families described once before their samples, buckets
+// cumulative up to +Inf equal to count, return problems found
+static int checkExposition(const std::string& text, std::set<std::string>& families, int* series) {
+    int problems = 0;
+    std::set<std::string> described, seen;
+    std::map<std::string, uint64_t> last;
+    std::istringstream lines(text);
+    std::string line;
+    while (std::getline(lines, line)) {
+        if (line.rfind("# HELP ", 0) == 0) {
+            continue;
+        }
+        if (line.rfind("# TYPE ", 0) == 0) {
+            std::string family = line.substr(7, line.find(' ', 7) - 7);
+            problems += !described.insert(family).second;
+            continue;
+        }
+        size_t space = line.rfind(' ');
+        std::string name = line.substr(0, space), value = line.substr(space + 1);
+        problems += space == std::string::npos || value.empty() || !seen.insert(name).second;
+        std::string metric = name.substr(0, name.find('{'));
+        std::string family = metric;
+        for (const char* suffix : { "_bucket", "_sum", "_count" }) {
+            size_t at = family.size() - strlen(suffix);
+            if (family.size() > strlen(suffix) && family.compare(at, std::string::npos, suffix) == 0 &&
+                    described.count(family.substr(0, at))) {
+                family = family.substr(0, at);
+            }
+        }
+        problems += !described.count(family);
+        families.insert(family);
+        // series key without le label
+        std::string key = name;
+        size_t le = key.find("le=\"");
+        if (le != std::string::npos) {
+            key.erase(le, key.find('"', le + 4) + 1 - le);
+            if (key.find(",}") != std::string::npos) {
+                key.erase(key.find(",}"), 1);
+            }
+        }
+        if (metric.size() > 7 && metric.compare(metric.size() - 7, 7, "_bucket") == 0) {
+            uint64_t count = strtoull(value.c_str(), NULL, 10);
+            problems += count < last[key];
+            last[key] = count;
+            if (name.find("le=\"+Inf\"") != std::string::npos) {
+                (*series)++;
+            }
+        }
+        else if (metric.size() > 6 && metric.compare(metric.size() - 6, 6, "_count") == 0) {
+            size_t brace = key.find('{');
+            std::string bucket = metric.substr(0, metric.size() - 6) + "_bucket" +
+                (brace == std::string::npos ? "{}" : key.substr(brace));
+            problems += last.count(bucket) == 0 || last[bucket] != strtoull(value.c_str(), NULL, 10);
+        }
+    }
+    return problems;
+}
+
+BENCHMARK(metrics) {
+    firmwareBoot();
+
+    Metric metric("bench_record_seconds", "Benchmark records");
+    // single calls are below the clock resolution, timed in bulk
+    Samples record(1), timer(1);
+    uint32_t allocations = hal::allocations();
+    measure(record, [&]() {
+        for (uint32_t i = 0; i < BENCH_METRICS_RECORDS; i++) {
+            metric.record(i * 2654435761U >> 12);
+        }
+    });
+    measure(timer, [&]() {
+        for (uint32_t i = 0; i < BENCH_METRICS_RECORDS; i++) {
+            MetricTimer scoped(metric);
+        }
+    });
+    allocations = hal::allocations() - allocations;
+
+    // firmware runs with requests and a configuration save so every hot path is counted
+    uint64_t until = hal::uptimeMicros() + BENCH_METRICS_SECONDS * 1000000ULL;
+    metricsRequest(HTTP_POST, "/write-config");
+    while (hal::uptimeMicros() < until) {
+        loop();
+        if (hal::uptimeMicros() % 1000000 < 2000) {
+            metricsRequest(HTTP_GET, "/get-state");
+        }
+    }
+
+    Samples scrape(BENCH_METRICS_SCRAPES);
+    for (int i = 0; i < BENCH_METRICS_SCRAPES; i++) {
+        metricsRequest(HTTP_GET, "/metrics", &scrape);
+    }
+    const ESP8266WebServer::Response& response = server.lastResponse();
+    std::set<std::string> families;
+    int series = 0;
+    int problems = checkExposition(response.body, families, &series) + (response.code != 200);
+    for (const char* family : { "clock_loop_seconds", "clock_display_render_seconds", "clock_display_send_seconds",
+            "clock_forecast_step_seconds", "clock_forecast_phase_seconds", "clock_http_handler_seconds",
+            "clock_config_save_seconds", "clock_heap_free_bytes", "clock_heap_max_block_bytes",
+            "clock_heap_fragmentation_percent" }) {
+        if (!families.count(family)) {
+            note("family missing", "%s", family);
+            problems++;
+        }
+    }
+
+    note("Metric::record()", "%.1f ns", record.mean() / BENCH_METRICS_RECORDS);
+    note("MetricTimer scope", "%.1f ns with two micros() calls, allocations %u of %d records",
+        timer.mean() / BENCH_METRICS_RECORDS, allocations, BENCH_METRICS_RECORDS * 2);
+    scrape.report("GET /metrics, handleClient()");
+    note("exposition", "%zu bytes in %u chunks, %zu families, %d histogram series", response.body.size(),
+        (unsigned)response.chunks, families.size(), series);
+    note("exposition problems", "%d", problems);
+}
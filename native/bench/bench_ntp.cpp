@@ -0,0 +1,108 @@
+/******************************************************************************
+ * (c) Skatech Research Lab, 2000-2026.
+ * Last change: 2026.10.16
+ * Host-native benchmark of SNTPClient clock discipline against NTP stand-ins
+ *****************************************************************************/
+
+#include <math.h>
+
+#include "bench.h"
+#include "SNTPClient.h"
+
+#define BENCH_NTP_REFERENCE 1790000000  // reference UTC at start, 2026-09-21
+#define BENCH_NTP_SKEW 40000            // ppb the device oscillator runs fast
+#define BENCH_NTP_STEP 2                // ms of simulated time between update() calls
+
+class ClockErrors {
+    public:
+    double sum = 0, peak = 0;
+    uint32_t count = 0;
+
+    void add(int64_t error) {
+        sum += (double)error * error;
+        peak = fmax(peak, fabs((double)error));
+        count++;
+    }
+
+    double rms() const {
+        return count ? sqrt(sum / count) : 0;
+    }
+};
+
+// run client for given simulated seconds, clock error sampled every second after settle
+static void run(SNTPClient& client, uint32_t seconds, uint32_t settle, ClockErrors& errors) {
+    uint64_t start = hal::uptimeMicros();
+    uint64_t until = start + (uint64_t)seconds * 1000000, sampled = start + (uint64_t)settle * 1000000;
+    while (hal::uptimeMicros() < until) {
+        client.update();
+        hal::advance(BENCH_NTP_STEP * 1000);
+        hal::pollNetwork();
+        if (hal::uptimeMicros() >= sampled) {
+            errors.add(hal::clockErrorMicros());
+            sampled += 1000000;
+        }
+    }
+}
+
+BENCHMARK(ntp) {
+    firmwareBoot();
+    hal::setNetworkDelays(20, 0);
+    hal::setReferenceTime(BENCH_NTP_REFERENCE);
+    hal::setEpochTime(BENCH_NTP_REFERENCE + 3);
+    hal::setClockSkew(BENCH_NTP_SKEW);
+    // near server, far jittery one, and one answering 250 ms ahead, outvoted by others
+    hal::setNtpServer("a.ntp.test", 0, 24, 4);
+    hal::setNtpServer("b.ntp.test", 0, 60, 20);
+    hal::setNtpServer("c.ntp.test", 250000, 30, 4);
+
+    SNTPClient client;
+    client.configure("a.ntp.test", "b.ntp.test", "c.ntp.test");
+    ClockErrors first, steady, retuned, lossy;
+    run(client, 7200, 600, first);
+    uint32_t packets = hal::ntpRequests();
+    run(client, 86400 * 2, 0, steady);
+    uint32_t perDay = (hal::ntpRequests() - packets) / 2;
+    note("clock error, 10 min to 2 h", "%.2f ms RMS, %.2f ms max", first.rms() / 1000, first.peak / 1000);
+    note("clock error, next 48 h", "%.2f ms RMS, %.2f ms max", steady.rms() / 1000, steady.peak / 1000);
+    note("oscillator error", "%.3f ppm, estimated %.3f ppm", BENCH_NTP_SKEW / 1000.0, -client.getDrift() / 1000.0);
+    note("poll interval", "%u s, %u NTP packets per day", (unsigned)client.getPollInterval(), (unsigned)perDay);
+    note("clock steps", "%u", (unsigned)client.getSteps());
+    for (uint8_t i = 0; i < SNTP_SERVERS; i++) {
+        const SNTPPeer& peer = client.getPeer(i);
+        note("  server", "%s offset %.2f ms, delay %.1f ms, jitter %.2f ms, reach %02X%s", peer.host,
+            peer.offset / 1000.0, peer.delay / 1000.0, peer.jitter / 1000.0, peer.reach,
+            peer.truechimer ? "" : ", dropped");
+    }
+
+    // oscillator warms up by 10 ppm within 6 hours, then a quarter of the packets lost
+    for (int i = 1; i <= 36; i++) {
+        hal::setClockSkew(BENCH_NTP_SKEW - i * 10000 / 36);
+        run(client, 600, 0, retuned);
+    }
+    run(client, 86400 - 36 * 600, 0, retuned);
+    note("clock error, skew 40 -> 30 ppm", "%.2f ms RMS, %.2f ms max, estimated %.3f ppm", retuned.rms() / 1000,
+        retuned.peak / 1000, -client.getDrift() / 1000.0);
+    hal::setNtpServer("a.ntp.test", 0, 24, 4, 25);
+    hal::setNtpServer("b.ntp.test", 0, 60, 20, 25);
+    hal::setNtpServer("c.ntp.test", 250000, 30, 4, 25);
+    run(client, 86400, 0, lossy);
+    note("clock error, 25% packet loss", "%.2f ms RMS, %.2f ms max", lossy.rms() / 1000, lossy.peak / 1000);
+
+    // lwIP SNTP (previous) sets clock to a single reply hourly, error grows with skew between
+    note("hourly lwIP SNTP (previous)", "%.2f ms max drift error, 24 NTP packets per day",
+        BENCH_NTP_SKEW / 1000.0 * 3600 / 1000);
+
+    Samples idle(100000);
+    for (int i = 0; i < 100000; i++) {
+        measure(idle, [&]() { client.update(); });
+        hal::advance(100);
+    }
+    idle.report("SNTPClient::update(), between rounds");
+    char json[512];
+    note("state JSON bytes", "%u", (unsigned)client.toJSON(json, sizeof(json)));
+    note("client bytes", "%u", (unsigned)sizeof(SNTPClient));
+
+    hal::clearNtpServers();
+    hal::setClockSkew(0);
+    hal::setNetworkDelays(0, 0);
+}
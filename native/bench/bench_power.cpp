@@ -0,0 +1,78 @@
+/******************************************************************************
+ * (c) Skatech Research Lab, 2000-2026.
+ * Last change: 2026.10.16
+ * Host-native simulation of the firmware sleep and wake timeline by power mode
+ *****************************************************************************/
+
+#include <ESP8266WebServer.h>
+
+#include "bench.h"
+#include "Scheduler.h"
+#include "LatencyHistogram.h"
+#include "PowerControl.h"
+
+#define BENCH_POWER_SECONDS 600
+#define BENCH_POWER_REQUEST_PERIOD 4999 // ms between web requests, drifting over beacons
+
+void loop();
+void applyPowerMode();
+
+extern ESP8266WebServer server;
+extern PowerControl power;
+extern LatencyHistogram faceLatency;
+
+// firmware accounting of its idle calls checked against the time HAL spent in delay()
+static void simulate(uint8_t mode) {
+    power.setMode(mode);
+    applyPowerMode();
+    uint64_t settled = hal::uptimeMicros() + 2000000;
+    while (hal::uptimeMicros() < settled) {
+        loop();
+    }
+    power.reset();
+    hal::resetPowerStats();
+    faceLatency.reset();
+    LatencyHistogram requests;
+    uint64_t until = hal::uptimeMicros() + (uint64_t)BENCH_POWER_SECONDS * 1000000;
+    uint64_t request = hal::uptimeMicros(), sent = 0;
+    uint32_t served = server.served();
+    time_t seen = time(NULL);
+    int skipped = 0;
+    while (hal::uptimeMicros() < until) {
+        if (hal::uptimeMicros() >= request && sent == 0) {
+            server.simulate({ HTTP_GET, "/time", { }, { }, false });
+            sent = hal::uptimeMicros();
+            request += BENCH_POWER_REQUEST_PERIOD * 1000;
+        }
+        loop();
+        if (server.served() != served) {
+            served = server.served();
+            requests.add((int32_t)(server.servedAt() - sent));
+            sent = 0;
+        }
+        time_t now = time(NULL);
+        skipped += now - seen > 1 ? now - seen - 1 : 0;
+        seen = now;
+    }
+
+    hal::PowerStats stats = hal::powerStats();
+    uint64_t total = stats.activeMicros + stats.idleMicros + stats.lightMicros;
+    note(PowerControl::getModeName(mode), "duty %.1f%% (HAL %.1f%%), light sleep %.1f%%, %.1f mA",
+        power.getDutyCycle() / 10.0, stats.activeMicros * 100.0 / total, stats.lightMicros * 100.0 / total,
+        power.getEstimatedCurrent() / 1000.0);
+    note("  wakeups per second", "%.2f (HAL %.2f)", power.getWakeups() / (double)BENCH_POWER_SECONDS,
+        stats.wakeups / (double)BENCH_POWER_SECONDS);
+    note("  web request latency", "p50 %.0f ms, max %.0f ms, %u served", requests.getPercentile(50) / 1000.0,
+        requests.getMax() / 1000.0, (unsigned)requests.getCount());
+    note("  face latency", "p99 %.1f ms, max %.2f ms, seconds skipped %d", faceLatency.getPercentile(99) / 1000.0,
+        faceLatency.getMax() / 1000.0, skipped);
+}
+
+BENCHMARK(power) {
+    firmwareBoot();
+    simulate(POWER_MODE_FULL);
+    simulate(POWER_MODE_MODEM);
+    simulate(POWER_MODE_LIGHT);
+    power.setMode(POWER_DEFAULT_MODE);
+    applyPowerMode();
+}
@@ -0,0 +1,93 @@
+/******************************************************************************
+ * (c) Skatech Research Lab, 2000-2026.
+ * Last change: 2026.10.16
+ * Host-native benchmark of Scheduler timer wheel deadlines and overhead
+ *****************************************************************************/
+
+#include "bench.h"
+#include "Scheduler.h"
+
+#define BENCH_SCHEDULER_TASKS 200
+
+static void nothing() {
+}
+
+static uint32_t random32(uint32_t& seed) {
+    seed = seed * 1664525 + 1013904223;
+    return seed >> 8;
+}
+
+// earliest deadline of the scheduled tasks by scanning them all
+static uint32_t scanDeadline(ScheduledTask** tasks, uint32_t now) {
+    uint32_t best = now + SCHEDULER_MAX_DELAY;
+    for (int i = 0; i < BENCH_SCHEDULER_TASKS; i++) {
+        if (tasks[i]->isScheduled() && (int32_t)(tasks[i]->getDue() - best) < 0) {
+            best = tasks[i]->getDue();
+        }
+    }
+    return best;
+}
+
+// tasks of periods from 1 ms to 5 hours and one-shots, clock stepped by sleeps returned
+// or by single ticks, every run has to start at its deadline and the run count to match
+static int mismatches(bool sleeping, uint32_t seconds, uint32_t* runs) {
+    Scheduler scheduler;
+    ScheduledTask* tasks[BENCH_SCHEDULER_TASKS];
+    uint32_t seed = 12345, firstDue[BENCH_SCHEDULER_TASKS];
+    uint32_t start = millis();
+    for (int i = 0; i < BENCH_SCHEDULER_TASKS; i++) {
+        uint32_t period = i % 4 == 0 ? 0 : 1 + random32(seed) % (i % 4 == 1 ? 1000 : i % 4 == 2 ? 60000 : 18000000);
+        tasks[i] = new ScheduledTask("task", nothing, period, 1000);
+        uint32_t delay = random32(seed) % (i % 8 == 0 ? 20000000 : 100000);
+        scheduler.schedule(*tasks[i], delay);
+        firstDue[i] = tasks[i]->getDue();
+    }
+    int count = 0;
+    uint32_t end = start + seconds * 1000;
+    while ((int32_t)(millis() - end) < 0) {
+        uint32_t sleep = scheduler.run();
+        uint32_t next = scheduler.getNextDeadline();
+        count += next != scanDeadline(tasks, millis());
+        count += (int32_t)(next - millis()) > 0 && sleep != min((uint32_t)(next - millis()), (uint32_t)SCHEDULER_IDLE_SLEEP);
+        delay(sleeping ? max(sleep, (uint32_t)1) : 1);
+    }
+    for (int i = 0; i < BENCH_SCHEDULER_TASKS; i++) {
+        ScheduledTask& task = *tasks[i];
+        uint32_t expected = (int32_t)(end - firstDue[i]) <= 0 ? 0 :
+            task.period == 0 ? 1 : (end - firstDue[i] - 1) / task.period + 1;
+        count += task.runs != expected || task.lateMax != 0;
+        *runs += task.runs;
+        delete tasks[i];
+    }
+    return count;
+}
+
+BENCHMARK(scheduler) {
+    uint32_t runs = 0;
+    int failures = mismatches(false, 600, &runs) + mismatches(true, 21600, &runs);
+    note("task runs checked", "%u", (unsigned)runs);
+    note("deadlines missed or miscounted", "%d", failures);
+
+    Scheduler scheduler;
+    ScheduledTask frame("frame", nothing, 100, 1000), http("http", nothing, 5, 1000),
+        wifi("wifi", nothing, 250, 1000), sntp("sntp", nothing, 1000, 1000),
+        forecast("forecast", nothing, 1000, 1000);
+    for (ScheduledTask* task : { &frame, &http, &wifi, &sntp, &forecast }) {
+        scheduler.schedule(*task, task->period);
+    }
+    Samples loop(100000), deadline(100000);
+    uint32_t sleep = 0, wakeups = 0;
+    uint32_t start = millis();
+    for (int i = 0; i < 100000; i++) {
+        delay(sleep);
+        measure(loop, [&]() { sleep = scheduler.run(); });
+        wakeups++;
+    }
+    note("wakeups per second, firmware periods", "%.1f", wakeups * 1000.0 / (millis() - start));
+    for (int i = 0; i < 100000; i++) {
+        measure(deadline, [&]() { scheduler.getNextDeadline(); });
+    }
+    loop.report("Scheduler::run(), 5 tasks");
+    deadline.report("Scheduler::getNextDeadline()");
+    note("scheduler bytes", "%u, task %u", (unsigned)sizeof(Scheduler), (unsigned)sizeof(ScheduledTask));
+}
@@ -0,0 +1,131 @@
+/******************************************************************************
+ * (c) Skatech Research Lab, 2000-2026.
+ * Last change: 2026.10.17
+ * Host-native benchmark of the screen pager, RAM held for the panel against CPU
+ * per frame of the buffer mode compiled, panel image checked against whole frames
+ *****************************************************************************/
+
+#include "bench.h"
+#include "display-SSD1306.h"
+
+#define BENCH_SCREENS_FRAMES 2000
+#define BENCH_SCREENS_SECONDS 600       // pager run, every screen and switch between them
+#define BENCH_SCREENS_PREVIOUS_BYTES 2048   // full frame buffer and its copy on the panel
+
+void firmwareBoot();
+
+extern ClockDisplay display;
+extern ForecastProvider forecast;
+
+// hourly series of two days ahead, daily temperature swing with wind picking up
+static void fillSeries(ForecastSeries& series, time_t now) {
+    char value[16];
+    series.begin(now);
+    uint32_t base = now / 86400 * 86400;
+    for (int16_t i = 0; i < 72; i++) {
+        snprintf(value, sizeof(value), "%lu", (unsigned long)(base + i * 3600));
+        series.set("time", i, value);
+        snprintf(value, sizeof(value), "%.1f", -4 + 6 * sinf(i * 2 * M_PI / 24));
+        series.set("temperature_2m", i, value);
+        snprintf(value, sizeof(value), "%d", 5 + i % 17);
+        series.set("windspeed_10m", i, value);
+        series.set("winddirection_10m", i, "113");
+        series.set("weathercode", i, "3");
+    }
+    series.end();
+}
+
+// first second at or after given one showing the screen
+static time_t secondOf(time_t from, uint8_t screen) {
+    while (ClockDisplay::screenAt(from) != screen) {
+        from++;
+    }
+    return from;
+}
+
+BENCHMARK(screens) {
+    firmwareBoot();
+    static ForecastSeries series;
+    time_t now = time(NULL);
+    fillSeries(series, now);
+    display.updateForecast(forecast.getForecast(), series);
+    int problems = series.hoursAhead(now) < SCREEN_TREND_HOURS;
+
+    // same forecast arriving again between face prepared and pushed sends nothing, the
+    // face pushed at the second is the one prepared
+    uint8_t image[OLED_TILE_COLUMNS * OLED_TILE_ROWS * 8];
+    DateTime hourly(secondOf(now, SCREEN_HOURLY));
+    display.invalidate();
+    display.update(hourly);
+    memcpy(image, hal::displayPanel(), sizeof(image));
+    display.prepare(hourly);
+    uint32_t transfers = hal::displayStats().frames;
+    display.updateForecast(forecast.getForecast(), series);
+    transfers = hal::displayStats().frames - transfers;
+    display.invalidate();
+    display.push();
+    bool kept = memcmp(image, hal::displayPanel(), sizeof(image)) == 0;
+    problems += transfers + !kept;
+
+    // tile left stale on the panel, as by a hash collision, is gone with the next minute
+    // of the same screen
+    time_t clock = secondOf(now, SCREEN_CLOCK);
+    display.update(DateTime(clock));
+    hal::displayPanel()[3 * OLED_TILE_COLUMNS * 8 + 40] ^= 0xFF;
+    display.update(DateTime(clock + 60));
+    memcpy(image, hal::displayPanel(), sizeof(image));
+    display.invalidate();
+    display.push();
+    bool repaired = memcmp(image, hal::displayPanel(), sizeof(image)) == 0;
+    problems += !repaired;
+
+    // CPU per frame of every screen, seconds of it in turn so the panel changes
+    static const char* labels[SCREEN_COUNT] = { "update(), clock", "update(), hourly forecast",
+        "update(), temperature trend", "update(), network" };
+    for (uint8_t screen = 0; screen < SCREEN_COUNT; screen++) {
+        time_t second = secondOf(now, screen);
+        Samples frames(BENCH_SCREENS_FRAMES);
+        display.update(second);
+        for (int i = 0; i < BENCH_SCREENS_FRAMES; i++) {
+            DateTime date(second + i % 2);
+            measure(frames, [&]() { display.update(date); });
+        }
+        problems += display.getScreen() != screen;
+        frames.report(labels[screen]);
+    }
+
+    // pager run with ticker frames between faces, panel after every face must equal the
+    // same frame resent whole, digest of the images is the same for every buffer mode
+    uint32_t stale = 0, digest = 2166136261u, switches = 0;
+    uint8_t screen = display.getScreen();
+    hal::resetDisplayStats();
+    for (int i = 0; i < BENCH_SCREENS_SECONDS; i++) {
+        for (int frame = 0; frame < TICKER_FRAME_RATE - 1; frame++) {
+            delay(1000 / TICKER_FRAME_RATE);
+            display.animate(millis());
+        }
+        delay(1000 / TICKER_FRAME_RATE);
+        DateTime date(now + i);
+        display.update(date);
+        switches += display.getScreen() != screen;
+        screen = display.getScreen();
+        memcpy(image, hal::displayPanel(), sizeof(image));
+        for (size_t byte = 0; byte < sizeof(image); byte++) {
+            digest = (digest ^ image[byte]) * 16777619u;
+        }
+        display.invalidate();
+        display.push();
+        stale += memcmp(image, hal::displayPanel(), sizeof(image)) != 0;
+    }
+    problems += stale + (switches < BENCH_SCREENS_SECONDS / 60);
+
+    note("panel RAM", "%u bytes, %d tile rows buffered, previous %d, saved %d", display.getMemoryBytes(),
+        OLED_PAGE_BUFFER ? OLED_PAGE_BUFFER : OLED_TILE_ROWS, BENCH_SCREENS_PREVIOUS_BYTES,
+        BENCH_SCREENS_PREVIOUS_BYTES - display.getMemoryBytes());
+    note("pager run", "%d s, %u screen switches, %u faces differing from whole frame", BENCH_SCREENS_SECONDS,
+        switches, stale);
+    note("forecast during prepared face", "%u transfers, face kept %s", transfers, kept ? "yes" : "no");
+    note("stale tile after a minute", "%s", repaired ? "resent" : "kept");
+    note("panel image digest", "%08X", digest);
+    note("screens problems", "%d", problems);
+}
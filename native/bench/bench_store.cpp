@@ -0,0 +1,214 @@
+/******************************************************************************
+ * (c) Skatech Research Lab, 2000-2026.
+ * Last change: 2026.10.17
+ * Host-native benchmark of configuration storage, whole EEPROM sector commits
+ * against journal records, power cut at random points of the writes
+ *****************************************************************************/
+
+#include <EEPROM.h>
+
+#include "bench.h"
+#include "configuration.h"
+#include "ConfigurationStore.h"
+
+#define BENCH_STORE_CRC_ROUNDS 10000
+#define BENCH_STORE_SAVES 1000
+#define BENCH_STORE_CUTS 3000
+#define BENCH_STORE_LOADS 1000
+
+extern Configuration state;
+extern ConfigurationStore configStore;
+
+static uint32_t random32(uint32_t& seed) {
+    seed = seed * 1664525 + 1013904223;
+    return seed >> 8;
+}
+
+// previous checksum, bit by bit
+static uint16_t crc16Bitwise(const uint8_t *data, uint16_t size, uint16_t crc = 0xFFFF) {
+    while (size--) {
+        crc ^= *data++;
+        for (uint8_t i = 0; i < 8; ++i) {
+            if (crc & 0x01) {
+                crc = (crc >> 1) ^ 0xA001;
+            }
+            else crc >>= 1;
+        }
+    }
+    return crc;
+}
+
+static void eraseStore() {
+    for (uint8_t index = 0; index < CONFIG_STORE_SECTORS; index++) {
+        ESP.flashEraseSector(CONFIG_STORE_SECTOR - index);
+    }
+}
+
+// settings a web request could change, shared by attempts with equal seed
+static void changeConfiguration(Configuration& config, uint32_t& seed) {
+    config.displayBrightness = random32(seed) % 256;
+    config.displayColors[random32(seed) % 5] = random32(seed) & 0xFFFFFF;
+    snprintf(config.timeServer3, sizeof(config.timeServer3), "ntp%u.example.org", (unsigned)(random32(seed) % 1000));
+}
+
+static bool sameConfiguration(const Configuration& a, const Configuration& b) {
+    return memcmp(&a, &b, sizeof(Configuration)) == 0;
+}
+
+BENCHMARK(store) {
+    uint32_t seed = 2026;
+    int problems = 0;
+
+    // checksum of both kinds on random buffers, chained as the forecast snapshot does
+    uint8_t buffer[sizeof(Configuration)];
+    for (int round = 0; round < BENCH_STORE_CRC_ROUNDS; round++) {
+        uint16_t size = random32(seed) % sizeof(buffer);
+        for (uint16_t i = 0; i < size; i++) {
+            buffer[i] = random32(seed);
+        }
+        uint16_t split = size ? random32(seed) % size : 0;
+        problems += Configuration::crc16(buffer, size) != crc16Bitwise(buffer, size);
+        problems += Configuration::crc16(buffer + split, size - split, Configuration::crc16(buffer, split)) !=
+            crc16Bitwise(buffer, size);
+    }
+    Samples bitwise(BENCH_STORE_CRC_ROUNDS), table(BENCH_STORE_CRC_ROUNDS);
+    volatile uint16_t sink = 0;
+    for (int round = 0; round < BENCH_STORE_CRC_ROUNDS; round++) {
+        measure(bitwise, [&]() { sink = sink + crc16Bitwise(buffer, sizeof(buffer)); });
+        measure(table, [&]() { sink = sink + Configuration::crc16(buffer, sizeof(buffer)); });
+    }
+
+    // previous: whole EEPROM sector erased and written by every save
+    Configuration config;
+    config.loadDefaults();
+    eraseStore();
+    uint32_t erases = hal::flashErases();
+    uint64_t start = hal::uptimeMicros();
+    for (int i = 0; i < BENCH_STORE_SAVES; i++) {
+        changeConfiguration(config, seed);
+        config.stateCrc16 = config.calculateChecksum();
+        EEPROM.begin(sizeof(Configuration));
+        EEPROM.put(0, config);
+        problems += !EEPROM.end();
+    }
+    uint64_t eepromMicros = hal::uptimeMicros() - start;
+    uint32_t eepromErases = hal::flashErases() - erases;
+
+    // image of previous firmware in the EEPROM sector, format before timezone rule
+    Configuration legacy;
+    legacy.loadDefaults();
+    legacy.stateFormat = STATE_FORMAT_NO_RULE;
+    legacy.timezone = 2;
+    legacy.daylight = 1;
+    legacy.displayBrightness = 77;
+    memset(legacy.timezoneRule, 0, sizeof(legacy.timezoneRule));
+    legacy.stateCrc16 = legacy.calculateChecksum(offsetof(Configuration, timezoneRule));
+    EEPROM.begin(sizeof(Configuration));
+    EEPROM.put(0, legacy);
+    EEPROM.end();
+    ConfigurationStore store;
+    Configuration loaded;
+    bool migrated = store.load(loaded) && loaded.displayBrightness == 77 && strcmp(loaded.timezoneRule, "<+03>-3") == 0;
+    // migrated image stays readable until the first record is whole
+    hal::cutPowerAfter(100);
+    store.save(loaded);
+    hal::restorePower();
+    Configuration reloaded;
+    migrated = migrated && ConfigurationStore().load(reloaded) && reloaded.displayBrightness == 77;
+    problems += !migrated;
+
+    // journal records, an erase only when a sector is full
+    eraseStore();
+    store.load(config);
+    erases = hal::flashErases();
+    uint32_t writes = hal::flashWrites();
+    Samples saves(BENCH_STORE_SAVES);
+    start = hal::uptimeMicros();
+    for (int i = 0; i < BENCH_STORE_SAVES; i++) {
+        changeConfiguration(config, seed);
+        measure(saves, [&]() { problems += !store.save(config); });
+    }
+    uint64_t storeMicros = hal::uptimeMicros() - start;
+    uint32_t storeErases = hal::flashErases() - erases;
+    writes = hal::flashWrites();
+    for (int i = 0; i < BENCH_STORE_SAVES; i++) {
+        problems += !store.save(config);
+    }
+    uint32_t unchangedWrites = hal::flashWrites() - writes;
+    problems += !ConfigurationStore().load(loaded) || !sameConfiguration(loaded, config);
+
+    // boot validation of both sectors filled with records
+    Samples loads(BENCH_STORE_LOADS);
+    for (int i = 0; i < BENCH_STORE_LOADS; i++) {
+        ConfigurationStore boot;
+        measure(loads, [&]() { boot.load(loaded); });
+    }
+
+    // power cut after random bytes of erase or program work, reboot loads the previous
+    // configuration or the one being saved, never defaults
+    eraseStore();
+    store.load(config);
+    problems += !store.save(config);
+    Configuration saved = config;
+    int torn = 0, lost = 0, kept = 0;
+    for (int i = 0; i < BENCH_STORE_CUTS; i++) {
+        Configuration attempt = saved;
+        changeConfiguration(attempt, seed);
+        hal::cutPowerAfter(random32(seed) % (SPI_FLASH_SEC_SIZE + sizeof(ConfigurationRecord) + sizeof(Configuration)));
+        bool done = store.save(attempt);
+        hal::restorePower();
+        torn += !done;
+
+        store = ConfigurationStore();
+        if (!store.load(loaded)) {
+            lost++;
+        }
+        else if (sameConfiguration(loaded, attempt)) {
+            saved = attempt;
+        }
+        else if (!sameConfiguration(loaded, saved) || done) {
+            lost++;
+        }
+        else kept++;
+    }
+    problems += lost + (torn == 0);
+
+    // layout of LittleFS reaching EEPROM, its last block below is never touched
+    uint32_t pattern[SPI_FLASH_SEC_SIZE / 4], block[SPI_FLASH_SEC_SIZE / 4];
+    for (uint32_t i = 0; i < SPI_FLASH_SEC_SIZE / 4; i++) {
+        pattern[i] = random32(seed);
+    }
+    eraseStore();
+    ESP.flashWrite((CONFIG_STORE_SECTOR - 1) * SPI_FLASH_SEC_SIZE, pattern, sizeof(pattern));
+    ConfigurationStore single(CONFIG_STORE_SECTOR);
+    single.load(config);
+    erases = hal::flashErases();
+    for (int i = 0; i < BENCH_STORE_SAVES; i++) {
+        changeConfiguration(config, seed);
+        problems += !single.save(config);
+    }
+    uint32_t singleErases = hal::flashErases() - erases;
+    ESP.flashRead((CONFIG_STORE_SECTOR - 1) * SPI_FLASH_SEC_SIZE, block, sizeof(block));
+    bool spared = memcmp(block, pattern, sizeof(block)) == 0;
+    problems += !spared || single.getSectorCount() != 1 || store.getSectorCount() != CONFIG_STORE_SECTORS ||
+        !ConfigurationStore(CONFIG_STORE_SECTOR).load(loaded) || !sameConfiguration(loaded, config);
+
+    // firmware store left with its configuration only
+    eraseStore();
+    configStore.load(loaded);
+    configStore.save(state);
+
+    bitwise.report("crc16(), bit by bit, 220 bytes");
+    table.report("crc16(), table, 220 bytes");
+    saves.report("ConfigurationStore::save()");
+    loads.report("ConfigurationStore::load(), 2 sectors");
+    note("flash time per save", "EEPROM commit %.2f ms, journal record %.2f ms",
+        eepromMicros / 1000.0 / BENCH_STORE_SAVES, storeMicros / 1000.0 / BENCH_STORE_SAVES);
+    note("sector erases", "EEPROM commit %u, journal %u of %d saves, unchanged saves written %u",
+        eepromErases, storeErases, BENCH_STORE_SAVES, unchangedWrites);
+    note("EEPROM image migrated", "%s", migrated ? "yes" : "no");
+    note("filesystem reaching EEPROM", "1 sector, %u erases of %d saves, filesystem block kept %s",
+        singleErases, BENCH_STORE_SAVES, spared ? "yes" : "no");
+    note("power cuts", "%d, saves torn %d, previous kept %d, lost %d", BENCH_STORE_CUTS, torn, kept, lost);
+    note("store problems", "%d", problems);
+}
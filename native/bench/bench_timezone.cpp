@@ -0,0 +1,117 @@
+/******************************************************************************
+ * (c) Skatech Research Lab, 2000-2026.
+ * Last change: 2026.10.16
+ * Host-native benchmark of TimeZone rules against glibc localtime()
+ *****************************************************************************/
+
+#include <string>
+
+#include "bench.h"
+#include "DateTime.h"
+
+void useZone(const char* rule) {
+    setenv("TZ", rule, 1);
+    tzset();
+    TimeZone::local().parse(rule);
+    DateTime::calendar().reset();
+}
+
+static bool sameAsLibc(time_t sec) {
+    struct tm expected;
+    localtime_r(&sec, &expected);
+    bool dst;
+    int32_t offset = TimeZone::local().getOffset(sec, &dst);
+    return offset == expected.tm_gmtoff && dst == (expected.tm_isdst > 0) &&
+        strcmp(TimeZone::local().getName(dst), expected.tm_zone) == 0;
+}
+
+// count seconds converted unlike glibc, sampled every step, around each glibc offset
+// change second by second
+static int mismatches(time_t from, time_t to, time_t step, uint32_t* transitions) {
+    int count = 0;
+    long previous = 0;
+    for (time_t sec = from; sec < to; sec += step) {
+        struct tm t;
+        localtime_r(&sec, &t);
+        if (sec != from && t.tm_gmtoff != previous) {
+            (*transitions)++;
+            for (time_t s = sec - step - 3600; s < sec + 3600; s++) {
+                count += !sameAsLibc(s);
+            }
+        }
+        previous = t.tm_gmtoff;
+        count += !sameAsLibc(sec);
+    }
+    return count;
+}
+
+BENCHMARK(timezone) {
+    std::string zone = TimeZone::local().getRule();
+    static const char* zones[] = {
+        "MSK-3",
+        "UTC0",
+        "CET-1CEST,M3.5.0,M10.5.0/3",
+        "EST5EDT,M3.2.0,M11.1.0",
+        "PST8PDT,M3.2.0/2:00:00,M11.1.0/2:00:00",
+        "IST-5:30",
+        "<+0545>-5:45",
+        "<-0930>9:30",
+        "AEST-10AEDT,M10.1.0,M4.1.0/3",
+        "<+1030>-10:30<+11>-11,M10.1.0,M4.1.0",
+        "<+1245>-12:45<+1345>,M9.5.0/2:45,M4.1.0/3:45",
+        "<-04>4<-03>,M9.1.6/24,M4.1.6/24",
+        "<-03>3<-02>,M3.5.0/-2,M10.5.0/-1",
+        "IST-1GMT0,M10.5.0,M3.5.0/1",
+        "<+00>0<+02>-2,J60,J300/1:30",
+        "<+01>-1<+02>,59/0,299",
+        "<-02>2<-01>,M3.5.0/-1,M10.5.0",
+        "<+13>-13<+14>,M11.1.0,M1.3.0/3",
+    };
+    int failures = 0;
+    uint32_t transitions = 0;
+    for (const char* rule : zones) {
+        useZone(rule);
+        if (strcmp(TimeZone::local().getRule(), rule) != 0) {
+            note("rule rejected", "%s", rule);
+            failures++;
+            continue;
+        }
+        // 1970 to 2100 sparsely, then random seconds in any order
+        int before = failures;
+        failures += mismatches(0, 4102444800, 3593, &transitions);
+        for (int i = 0; i < 20000; i++) {
+            time_t sec = (time_t)(((uint64_t)i * 2654435761U) % 4102444800U);
+            failures += !sameAsLibc(sec);
+        }
+        if (failures != before) {
+            note("rule converted unlike glibc", "%s, %d seconds", rule, failures - before);
+        }
+    }
+    note("zones compared", "%u, %u transitions", (unsigned)(sizeof(zones) / sizeof(zones[0])), (unsigned)transitions);
+    note("seconds converted unlike glibc", "%d", failures);
+
+    int accepted = 0;
+    for (const char* rule : { "", "M", "MSK", "MSK-", "MSK-3x", "<+03-3", "<+\"3>-3", "CET-1CEST,M3.5.0",
+            "CET-1CEST,M13.5.0,M10.5.0", "CET-1CEST,M3.6.0,M10.5.0", "CET-1CEST,J0,J100", "CET-1CEST,366,100",
+            "CET-25", "CET-1CEST,M3.5.0/168,M10.5.0", "VERYLONGZONENAMEOFRULE-1VERYLONGDAYLIGHTNAME,M3.5.0,M10.5.0/3" }) {
+        TimeZone check;
+        accepted += check.parse(rule);
+    }
+    note("invalid rules accepted", "%d", accepted);
+
+    useZone("CET-1CEST,M3.5.0,M10.5.0/3");
+    Samples libc(100000), table(100000);
+    for (int i = 0; i < 100000; i++) {
+        time_t sec = 1767225600 + (time_t)(((uint64_t)i * 2654435761U) % 157766400U);
+        measure(libc, [&]() { struct tm t; localtime_r(&sec, &t); });
+    }
+    for (int i = 0; i < 100000; i++) {
+        time_t sec = 1767225600 + (time_t)(((uint64_t)i * 2654435761U) % 157766400U);
+        measure(table, [&]() { TimeZone::local().getOffset(sec); });
+    }
+    libc.report("offset, glibc localtime_r, random seconds 2026-2030");
+    table.report("offset, transition table, random seconds 2026-2030");
+    note("transition table", "%u bytes", (unsigned)sizeof(TimeZone));
+
+    useZone(zone.c_str());
+}
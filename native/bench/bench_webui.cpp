@@ -0,0 +1,93 @@
+/******************************************************************************
+ * (c) Skatech Research Lab, 2000-2026.
+ * Last change: 2026.10.16
+ * Host-native benchmark of web UI page loads, plain files against gzipped
+ * assets with ETag revalidation
+ *****************************************************************************/
+
+#include <ESP8266WebServer.h>
+#include <LittleFS.h>
+
+#include "bench.h"
+
+#define BENCH_WEBUI_LOADS 1000
+#define BENCH_WEAK_LINK 256             // kbit/s of a weak WiFi link, transfer time estimate
+
+extern ESP8266WebServer server;
+
+static const char* pageFiles[] = { "/", "/css/styles.css", "/js/script.js" };
+
+static std::string responseHeader(const ESP8266WebServer::Response& response, const char* name) {
+    for (const auto& header : response.headers) {
+        if (header.first == name) {
+            return header.second;
+        }
+    }
+    return "";
+}
+
+// browser load of the page and the files it references, repeated loads send ETags seen
+// and skip files cached for good, return bytes of the bodies received
+static size_t loadPage(ESP8266WebServer& web, Samples& samples, std::string* etags, int* failures) {
+    size_t bytes = 0;
+    for (int i = 0; i < 3; i++) {
+        bool immutable = etags[i].size() && i > 0;
+        if (immutable) {
+            continue;
+        }
+        std::vector<std::pair<std::string, std::string>> headers;
+        if (etags[i].size()) {
+            headers.push_back({ "If-None-Match", etags[i] });
+        }
+        web.simulate({ HTTP_GET, pageFiles[i], { }, headers, false });
+        hal::advance(hal::radioReceiveMicros(hal::uptimeMicros()) - hal::uptimeMicros());
+        measure(samples, [&]() { web.handleClient(); });
+        const ESP8266WebServer::Response& response = web.lastResponse();
+        *failures += response.code != (etags[i].size() ? 304 : 200);
+        bytes += response.body.size();
+        std::string cache = responseHeader(response, "Cache-Control");
+        if (cache.find("immutable") != std::string::npos || (i == 0 && responseHeader(response, "ETag").size())) {
+            etags[i] = responseHeader(response, "ETag");
+        }
+    }
+    return bytes;
+}
+
+static void report(const char* label, size_t first, size_t repeated, Samples& samples) {
+    note(label, "first load %zu bytes (%.0f ms), repeated %zu bytes (%.0f ms)", first,
+        first * 8.0 / BENCH_WEAK_LINK, repeated, repeated * 8.0 / BENCH_WEAK_LINK);
+    samples.report("  handleClient(), page files");
+}
+
+BENCHMARK(webui) {
+    firmwareBoot();
+    int failures = 0;
+
+    // previous: plain data/ files served by serveStatic with no-cache
+    FS plain;
+    plain.begin();
+    copyHostFiles(plain, "data");
+    ESP8266WebServer previous(80);
+    previous.serveStatic("/", plain, "/", "no-cache");
+    Samples before(BENCH_WEBUI_LOADS * 3), after(BENCH_WEBUI_LOADS * 3);
+    std::string none[3];
+    size_t first = loadPage(previous, before, none, &failures), repeated = 0;
+    for (int i = 1; i < BENCH_WEBUI_LOADS; i++) {
+        repeated = loadPage(previous, before, none, &failures);
+    }
+    report("plain files (previous)", first, repeated, before);
+
+    if (!LittleFS.exists("/assets.txt")) {
+        note("gzipped assets", "not built, run tools/webui.py");
+        return;
+    }
+    std::string etags[3];
+    first = loadPage(server, after, etags, &failures);
+    std::string encoding = responseHeader(server.lastResponse(), "Content-Encoding");
+    for (int i = 1; i < BENCH_WEBUI_LOADS; i++) {
+        repeated = loadPage(server, after, etags, &failures);
+    }
+    note("content encoding", "%s", encoding.c_str());
+    report("gzipped, ETag and versioned URLs", first, repeated, after);
+    note("unexpected status codes", "%d", failures);
+}
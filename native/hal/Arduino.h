@@ -0,0 +1,104 @@
+/******************************************************************************
+ * (c) Skatech Research Lab, 2000-2026.
+ * Last change: 2026.10.17
+ * Host-native HAL - Arduino core subset used by the clock sources
+ *****************************************************************************/
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <ctype.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <sys/time.h>
+#include <algorithm>
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+using std::min;
+using std::max;
+
+typedef uint8_t u8;
+typedef uint16_t u16;
+typedef uint32_t u32;
+typedef int8_t s8;
+typedef int16_t s16;
+typedef int32_t s32;
+
+#define HIGH 0x1
+#define LOW  0x0
+#define INPUT  0x00
+#define OUTPUT 0x01
+
+#define LED_BUILTIN 2
+#define D1 5
+#define D2 4
+
+#define PROGMEM
+#define PSTR(s) (s)
+#define F(s) (s)
+#define pgm_read_byte(addr) (*(const uint8_t*)(addr))
+#define pgm_read_word(addr) (*(const uint16_t*)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t*)(addr))
+#define memcpy_P memcpy
+#define strcpy_P strcpy
+#define strlen_P strlen
+
+#include "WString.h"
+#include "Print.h"
+#include "Stream.h"
+#include "IPAddress.h"
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void yield();
+
+void setTZ(const char* tz);
+void configTime(int timezone_sec, int daylightOffset_sec,
+    const char* server1, const char* server2 = nullptr, const char* server3 = nullptr);
+void configTime(const char* tz, const char* server1,
+    const char* server2 = nullptr, const char* server3 = nullptr);
+
+// UART with the 128 byte transmit FIFO of the chip, write waits as long as it is full
+class HardwareSerial : public Stream {
+    public:
+    void begin(unsigned long baud);
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t* buffer, size_t size) override;
+    int availableForWrite();
+    int available() override { return 0; }
+    int read() override { return -1; }
+    int peek() override { return -1; }
+    using Print::write;
+};
+
+extern HardwareSerial Serial;
+
+#define SPI_FLASH_SEC_SIZE 4096
+#define HAL_EEPROM_SECTOR 0x3FB         // sector eagle.flash.4m2m.ld places EEPROM at
+#define HAL_FS_END_SECTOR 0x3FA         // first sector past LittleFS of the same layout
+
+// Flash access of the SDK, words aligned. Programming only clears bits, sectors are
+// erased to 0xFF
+class EspClass {
+    public:
+    uint32_t getFreeHeap();
+    uint32_t getMaxFreeBlockSize();
+    uint8_t getHeapFragmentation();
+    uint32_t getCycleCount();
+    uint32_t getCpuFreqMHz() { return 80; }
+    void restart() { }
+    bool flashEraseSector(uint32_t sector);
+    bool flashWrite(uint32_t address, const uint32_t* data, size_t size);
+    bool flashRead(uint32_t address, uint32_t* data, size_t size);
+};
+
+extern EspClass ESP;
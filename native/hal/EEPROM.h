@@ -0,0 +1,40 @@
+/******************************************************************************
+ * (c) Skatech Research Lab, 2000-2026.
+ * Last change: 2026.10.17
+ * Host-native HAL - emulated EEPROM, RAM copy of its flash sector erased and
+ * written whole on commit as the core does
+ *****************************************************************************/
+
+#pragma once
+
+#include <Arduino.h>
+
+class EEPROMClass {
+    private:
+    uint8_t _data[SPI_FLASH_SEC_SIZE] __attribute__((aligned(4)));
+    size_t _size = 0;
+    bool _dirty = false;
+
+    public:
+    void begin(size_t size);
+    bool commit();
+    bool end();
+    size_t length() const { return _size; }
+    uint8_t read(int address) const { return _data[address]; }
+    void write(int address, uint8_t value) { _data[address] = value; _dirty = true; }
+    uint8_t* getDataPtr() { _dirty = true; return _data; }
+    const uint8_t* getConstDataPtr() const { return _data; }
+
+    template<typename T> T& get(int address, T& t) {
+        memcpy((void*)&t, _data + address, sizeof(T));
+        return t;
+    }
+
+    template<typename T> const T& put(int address, const T& t) {
+        memcpy(_data + address, (const void*)&t, sizeof(T));
+        _dirty = true;
+        return t;
+    }
+};
+
+extern EEPROMClass EEPROM;
@@ -0,0 +1,43 @@
+/******************************************************************************
+ * (c) Skatech Research Lab, 2000-2026.
+ * Last change: 2026.10.16
+ * Host-native HAL - blocking HTTP client answering with the canned response
+ *****************************************************************************/
+
+#pragma once
+
+#include <Arduino.h>
+#include <ESP8266WiFi.h>
+
+#define HTTPC_ERROR_CONNECTION_FAILED   (-1)
+#define HTTPC_ERROR_SEND_HEADER_FAILED  (-2)
+#define HTTPC_ERROR_NOT_CONNECTED       (-4)
+#define HTTPC_ERROR_CONNECTION_LOST     (-5)
+#define HTTPC_ERROR_NO_HTTP_SERVER      (-7)
+#define HTTPC_ERROR_READ_TIMEOUT        (-11)
+
+typedef enum {
+    HTTP_CODE_OK = 200,
+    HTTP_CODE_NOT_MODIFIED = 304,
+    HTTP_CODE_BAD_REQUEST = 400,
+    HTTP_CODE_NOT_FOUND = 404,
+    HTTP_CODE_INTERNAL_SERVER_ERROR = 500
+} t_http_codes;
+
+class HTTPClient {
+    private:
+    WiFiClient* _client = nullptr;
+    int _size = -1;
+
+    public:
+    bool begin(WiFiClient& client, const String& url);
+    int GET();
+    int getSize() { return _size; }
+    WiFiClient& getStream() { return *_client; }
+    String getString();
+    void end();
+    void setTimeout(uint16_t timeout) { }
+    void useHTTP10(bool usehttp10 = true) { }
+    bool connected() { return _client && _client->connected(); }
+    static String errorToString(int error);
+};
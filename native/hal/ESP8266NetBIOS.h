@@ -0,0 +1,17 @@
+/******************************************************************************
+ * (c) Skatech Research Lab, 2000-2026.
+ * Last change: 2026.10.16
+ * Host-native HAL - NetBIOS name service stand-in
+ *****************************************************************************/
+
+#pragma once
+
+#include <Arduino.h>
+
+class ESP8266NetBIOS {
+    public:
+    bool begin(const char* name) { return true; }
+    void end() { }
+};
+
+extern ESP8266NetBIOS NBNS;
@@ -0,0 +1,140 @@
+/******************************************************************************
+ * (c) Skatech Research Lab, 2000-2026.
+ * Last change: 2026.10.16
+ * Host-native HAL - web server dispatching simulated requests to handlers
+ *****************************************************************************/
+
+#pragma once
+
+#include <Arduino.h>
+#include <ESP8266WiFi.h>
+#include <FS.h>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+enum HTTPMethod {
+    HTTP_ANY, HTTP_GET, HTTP_HEAD, HTTP_POST, HTTP_PUT, HTTP_PATCH, HTTP_DELETE, HTTP_OPTIONS
+};
+
+enum HTTPAuthMethod {
+    BASIC_AUTH, DIGEST_AUTH
+};
+
+#define CONTENT_LENGTH_UNKNOWN ((size_t) -1)
+#define CONTENT_LENGTH_NOT_SET ((size_t) -2)
+
+class ESP8266WebServer {
+    public:
+    typedef std::function<void(void)> THandlerFunction;
+
+    // request queued by simulate() and served by next handleClient() call once the radio
+    // received it
+    struct Request {
+        HTTPMethod method;
+        std::string uri;
+        std::vector<std::pair<std::string, std::string>> args;
+        std::vector<std::pair<std::string, std::string>> headers;
+        bool authorized;
+    };
+
+    // response captured from handler, body includes chunked content
+    struct Response {
+        int code;
+        std::string contentType;
+        std::vector<std::pair<std::string, std::string>> headers;
+        std::string body;
+        bool chunked;                   // content length unknown, sent by chunks
+        uint16_t chunks;                // excluding the last empty one
+        bool finished;                  // last empty chunk sent
+    };
+
+    private:
+    struct Route {
+        std::string uri;
+        HTTPMethod method;
+        THandlerFunction handler;
+    };
+
+    struct StaticRoute {
+        std::string uri, path, cacheHeader;
+        FS* fs;
+    };
+
+    std::vector<Route> _routes;
+    std::vector<StaticRoute> _statics;
+    std::vector<Request> _queue;
+    std::vector<uint64_t> _queueReady;
+    std::vector<std::shared_ptr<hal::Connection>> _queueConnections;
+    std::shared_ptr<hal::Connection> _connection;
+    std::vector<std::pair<std::string, std::string>> _pendingHeaders;
+    Request _current;
+    Response _response;
+    size_t _contentLength = CONTENT_LENGTH_NOT_SET;
+    uint32_t _served = 0;
+    uint64_t _servedAt = 0;
+
+    bool serveStatic(const StaticRoute& route);
+    void dispatch();
+
+    public:
+    ESP8266WebServer(int port = 80) { }
+
+    void begin() { }
+    void close() { }
+    void handleClient();
+
+    void on(const String& uri, THandlerFunction handler) { on(uri, HTTP_ANY, handler); }
+    void on(const String& uri, HTTPMethod method, THandlerFunction handler);
+    void serveStatic(const char* uri, FS& fs, const char* path, const char* cache_header = nullptr);
+    void onNotFound(THandlerFunction handler) { _routes.push_back({ "", HTTP_ANY, handler }); }
+
+    bool authenticate(const char* username, const char* password) { return _current.authorized; }
+    void requestAuthentication(HTTPAuthMethod mode = BASIC_AUTH, const char* realm = nullptr,
+        const String& authFailMsg = String(""));
+
+    String uri() const { return String(_current.uri.c_str()); }
+    HTTPMethod method() const { return _current.method; }
+    WiFiClient client();
+    String arg(const String& name) const;
+    bool hasArg(const String& name) const;
+    String arg(int i) const { return String(_current.args[i].second.c_str()); }
+    String argName(int i) const { return String(_current.args[i].first.c_str()); }
+    int args() const { return (int)_current.args.size(); }
+    String header(const String& name) const;
+    bool hasHeader(const String& name) const;
+
+    void sendHeader(const String& name, const String& value, bool first = false);
+    void setContentLength(size_t contentLength) { _contentLength = contentLength; }
+    void send(int code, const char* content_type = nullptr, const String& content = String(""));
+    void send(int code, const char* content_type, const char* content);
+    void send(int code, const char* content_type, const char* content, size_t contentLength);
+    void sendContent(const String& content) { sendContent(content.c_str(), content.length()); }
+    void sendContent(const char* content, size_t size);
+    void collectHeaders(const char* headerKeys[], const size_t headerKeysCount) { }
+
+    // as the core does, gzipped file gets Content-Encoding unless sent as archive
+    template<typename T> size_t streamFile(T& file, const String& contentType, const int code = 200) {
+        size_t length = strlen(file.name());
+        if (length > 3 && strcmp(file.name() + length - 3, ".gz") == 0 &&
+                contentType != "application/x-gzip" && contentType != "application/octet-stream") {
+            sendHeader("Content-Encoding", "gzip");
+        }
+        setContentLength(file.size());
+        send(code, contentType.c_str(), "");
+        uint8_t buffer[1460];
+        size_t count, sent = 0;
+        while ((count = file.readBytes(buffer, sizeof(buffer))) > 0) {
+            sendContent((const char*)buffer, count);
+            sent += count;
+        }
+        return sent;
+    }
+
+    // simulation interface
+    std::shared_ptr<hal::Connection> simulate(const Request& request);
+    const Response& lastResponse() const { return _response; }
+    uint32_t served() const { return _served; }
+    uint64_t servedAt() const { return _servedAt; }
+};
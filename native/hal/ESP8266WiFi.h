@@ -0,0 +1,101 @@
+/******************************************************************************
+ * (c) Skatech Research Lab, 2000-2026.
+ * Last change: 2026.10.17
+ * Host-native HAL - WiFi station and TCP client stand-ins
+ *****************************************************************************/
+
+#pragma once
+
+#include <Arduino.h>
+#include <memory>
+#include <string>
+
+typedef enum {
+    WL_NO_SHIELD = 255,
+    WL_IDLE_STATUS = 0,
+    WL_NO_SSID_AVAIL = 1,
+    WL_SCAN_COMPLETED = 2,
+    WL_CONNECTED = 3,
+    WL_CONNECT_FAILED = 4,
+    WL_CONNECTION_LOST = 5,
+    WL_WRONG_PASSWORD = 6,
+    WL_DISCONNECTED = 7
+} wl_status_t;
+
+typedef enum {
+    WIFI_OFF = 0, WIFI_STA = 1, WIFI_AP = 2, WIFI_AP_STA = 3
+} WiFiMode_t;
+
+typedef enum {
+    WIFI_NONE_SLEEP = 0, WIFI_LIGHT_SLEEP = 1, WIFI_MODEM_SLEEP = 2
+} WiFiSleepType_t;
+
+class ESP8266WiFiClass {
+    public:
+    bool disconnect(bool wifioff = false);
+    bool mode(WiFiMode_t mode);
+    bool hostname(const char* name);
+    bool config(IPAddress local, IPAddress gateway, IPAddress subnet, IPAddress dns1 = (uint32_t)0);
+    wl_status_t begin(const char* ssid, const char* passphrase = nullptr);
+    wl_status_t status();
+    bool setSleepMode(WiFiSleepType_t type, uint8_t listenInterval = 0);
+    WiFiSleepType_t getSleepMode();
+    String macAddress();
+    IPAddress localIP();
+    int32_t RSSI();
+};
+
+extern ESP8266WiFiClass WiFi;
+
+#define HAL_TCP_SEND_BUFFER 2920     // lwIP send buffer, two segments
+
+namespace hal {
+    // accepted connection of a simulated web client, firmware writes land in received
+    // until the client reads them, unread bytes shrink the send window
+    struct Connection {
+        std::string received;
+        size_t capacity = HAL_TCP_SEND_BUFFER;
+        bool open = true;
+        bool kept = false;              // handler took server.client(), stays open
+    };
+}
+
+// TCP client talking to the simulated HTTP server configured by hal::setHttpResponse(),
+// response becomes readable after latency since the request header terminator written,
+// served from HAL storage so it never counts as firmware heap
+class WiFiClient : public Stream {
+    private:
+    char _header[160] = "";
+    const char* _body = nullptr;
+    size_t _headerSize = 0, _bodySize = 0, _position = 0;
+    uint64_t _readyAt = 0;
+    uint32_t _terminator = 0;
+    bool _connected = false;
+    std::shared_ptr<hal::Connection> _peer;     // accepted by web server, copies share it
+
+    public:
+    WiFiClient() { }
+    WiFiClient(std::shared_ptr<hal::Connection> peer) : _peer(peer) { }
+
+    int connect(const char* host, uint16_t port);
+    int connect(IPAddress ip, uint16_t port);
+    uint8_t connected();
+    void stop();
+    void setNoDelay(bool nodelay) { }
+    void setSync(bool sync) { }
+    size_t availableForWrite();
+
+    size_t write(uint8_t c) override { return write(&c, 1); }
+    size_t write(const uint8_t* buffer, size_t size) override;
+    int available() override;
+    int read() override { uint8_t c; return readBytes(&c, 1) ? c : -1; }
+    int peek() override;
+    size_t readBytes(uint8_t* buffer, size_t length) override;
+    using Print::write;
+    using Stream::readBytes;
+
+    // serve given data as the readable side of the connection closed by server
+    void load(const char* data, size_t size) {
+        _headerSize = 0; _body = data; _bodySize = size; _position = 0; _readyAt = 0; _connected = false;
+    }
+};
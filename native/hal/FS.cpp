@@ -0,0 +1,113 @@
+/******************************************************************************
+ * (c) Skatech Research Lab, 2000-2026.
+ * Last change: 2026.10.17
+ * Host-native HAL - in-memory file system with Arduino FS interface
+ *****************************************************************************/
+
+#include <LittleFS.h>
+
+#include "hal.h"
+
+#define HAL_FS_TOTAL_BYTES 1024000
+#define HAL_FS_BLOCK_SIZE 8192
+
+static uint32_t s_bytesWritten = 0, s_bytesRead = 0;
+
+uint32_t hal::fsBytesWritten() {
+    return s_bytesWritten;
+}
+
+uint32_t hal::fsBytesRead() {
+    return s_bytesRead;
+}
+
+bool File::seek(uint32_t pos, SeekMode mode) {
+    if (!_data) {
+        return false;
+    }
+    size_t base = mode == SeekSet ? 0 : mode == SeekCur ? _position : _data->size();
+    if (base + pos > _data->size()) {
+        return false;
+    }
+    _position = base + pos;
+    return true;
+}
+
+size_t File::write(const uint8_t* buffer, size_t size) {
+    if (!_data || !_writable) {
+        return 0;
+    }
+    if (_position + size > _data->size()) {
+        _data->resize(_position + size);
+    }
+    memcpy(_data->data() + _position, buffer, size);
+    _position += size;
+    s_bytesWritten += size;
+    return size;
+}
+
+size_t File::readBytes(uint8_t* buffer, size_t length) {
+    size_t count = (size_t)available() < length ? (size_t)available() : length;
+    if (count > 0) {
+        memcpy(buffer, _data->data() + _position, count);
+        _position += count;
+        s_bytesRead += count;
+    }
+    return count;
+}
+
+Dir::Dir(std::map<std::string, FileData>* files, const std::string& path) : _files(files) {
+    std::string prefix = path.empty() || path.back() == '/' ? path : path + "/";
+    for (const auto& entry : *files) {
+        if (entry.first.compare(0, prefix.size(), prefix) == 0 &&
+                entry.first.find('/', prefix.size()) == std::string::npos) {
+            _names.push_back(entry.first.substr(prefix.size()));
+        }
+    }
+}
+
+size_t Dir::fileSize() const {
+    return 0;
+}
+
+bool FS::info(FSInfo& info) {
+    size_t used = 0;
+    for (const auto& entry : _files) {
+        used += (entry.second->size() + HAL_FS_BLOCK_SIZE - 1) / HAL_FS_BLOCK_SIZE * HAL_FS_BLOCK_SIZE;
+    }
+    info = { HAL_FS_TOTAL_BYTES, used, HAL_FS_BLOCK_SIZE, 256, 5, 32 };
+    return _mounted;
+}
+
+File FS::open(const char* path, const char* mode) {
+    if (!_mounted) {
+        return File();
+    }
+    auto found = _files.find(path);
+    if (mode[0] == 'r') {
+        if (found == _files.end()) {
+            return File();
+        }
+        return File(path, found->second, mode[1] == '+', 0);
+    }
+    if (found == _files.end()) {
+        found = _files.emplace(path, std::make_shared<std::vector<uint8_t>>()).first;
+    }
+    if (mode[0] == 'w') {
+        found->second->clear();
+    }
+    return File(path, found->second, true, found->second->size());
+}
+
+bool FS::rename(const char* from, const char* to) {
+    auto found = _files.find(from);
+    if (found == _files.end()) {
+        return false;
+    }
+    FileData data = found->second;
+    _files.erase(found);
+    _files[to] = data;
+    return true;
+}
+
+FS LittleFS;
@@ -0,0 +1,93 @@
+/******************************************************************************
+ * (c) Skatech Research Lab, 2000-2026.
+ * Last change: 2026.10.16
+ * Host-native HAL - in-memory file system with Arduino FS interface
+ *****************************************************************************/
+
+#pragma once
+
+#include <Arduino.h>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+enum SeekMode {
+    SeekSet = 0, SeekCur = 1, SeekEnd = 2
+};
+
+struct FSInfo {
+    size_t totalBytes;
+    size_t usedBytes;
+    size_t blockSize;
+    size_t pageSize;
+    size_t maxOpenFiles;
+    size_t maxPathLength;
+};
+
+typedef std::shared_ptr<std::vector<uint8_t>> FileData;
+
+class File : public Stream {
+    private:
+    std::string _name;
+    FileData _data;
+    size_t _position = 0;
+    bool _writable = false;
+
+    public:
+    File() { }
+    File(const std::string& name, FileData data, bool writable, size_t position)
+        : _name(name), _data(data), _position(position), _writable(writable) { }
+
+    operator bool() const { return (bool)_data; }
+    const char* name() const { return _name.c_str(); }
+    size_t size() const { return _data ? _data->size() : 0; }
+    size_t position() const { return _position; }
+    bool isFile() const { return (bool)_data; }
+    void close() { _data.reset(); }
+    void flush() { }
+    bool seek(uint32_t pos, SeekMode mode = SeekSet);
+
+    size_t write(uint8_t c) override { return write(&c, 1); }
+    size_t write(const uint8_t* buffer, size_t size) override;
+    int available() override { return _data ? (int)(_data->size() - _position) : 0; }
+    int read() override { return available() > 0 ? (*_data)[_position++] : -1; }
+    int peek() override { return available() > 0 ? (*_data)[_position] : -1; }
+    size_t read(uint8_t* buffer, size_t size) { return readBytes(buffer, size); }
+    size_t readBytes(uint8_t* buffer, size_t length) override;
+    using Print::write;
+    using Stream::readBytes;
+};
+
+class Dir {
+    private:
+    std::vector<std::string> _names;
+    size_t _index = 0;
+    std::map<std::string, FileData>* _files = nullptr;
+
+    public:
+    Dir() { }
+    Dir(std::map<std::string, FileData>* files, const std::string& path);
+    bool next() { return ++_index <= _names.size(); }
+    String fileName() const { return String(_names[_index - 1].c_str()); }
+    size_t fileSize() const;
+};
+
+class FS {
+    private:
+    std::map<std::string, FileData> _files;
+    bool _mounted = false;
+
+    public:
+    bool begin() { _mounted = true; return true; }
+    void end() { _mounted = false; }
+    bool format() { _files.clear(); return true; }
+    bool info(FSInfo& info);
+    File open(const char* path, const char* mode);
+    File open(const String& path, const char* mode) { return open(path.c_str(), mode); }
+    Dir openDir(const char* path) { return Dir(&_files, path); }
+    bool exists(const char* path) { return _files.count(path) > 0; }
+    bool exists(const String& path) { return exists(path.c_str()); }
+    bool remove(const char* path) { return _files.erase(path) > 0; }
+    bool rename(const char* from, const char* to);
+};
@@ -0,0 +1,40 @@
+/******************************************************************************
+ * (c) Skatech Research Lab, 2000-2026.
+ * Last change: 2026.10.16
+ * Host-native HAL - IPv4 address
+ *****************************************************************************/
+
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include "Print.h"
+#include "lwip/dns.h"
+
+// lwIP network byte order initializer, little-endian host
+#define IPADDR4_INIT_BYTES(a,b,c,d) ((uint32_t)(a) | ((uint32_t)(b) << 8) | \
+    ((uint32_t)(c) << 16) | ((uint32_t)(d) << 24))
+
+class IPAddress : public Printable {
+    private:
+    uint32_t _address;
+
+    public:
+    IPAddress(uint32_t address = 0) : _address(address) { }
+    IPAddress(const ip_addr_t* address) : _address(address->addr) { }
+    IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : _address(IPADDR4_INIT_BYTES(a, b, c, d)) { }
+
+    operator uint32_t() const { return _address; }
+    uint8_t operator [](int index) const { return (uint8_t)(_address >> (index * 8)); }
+
+    String toString() const {
+        char buffer[16];
+        snprintf(buffer, sizeof(buffer), "%u.%u.%u.%u", (*this)[0], (*this)[1], (*this)[2], (*this)[3]);
+        return String(buffer);
+    }
+
+    size_t printTo(Print& p) const override {
+        return p.print(toString());
+    }
+};
@@ -0,0 +1,11 @@
+/******************************************************************************
+ * (c) Skatech Research Lab, 2000-2026.
+ * Last change: 2026.10.16
+ * Host-native HAL - LittleFS instance
+ *****************************************************************************/
+
+#pragma once
+
+#include <FS.h>
+
+extern FS LittleFS;
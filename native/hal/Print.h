@@ -0,0 +1,47 @@
+/******************************************************************************
+ * (c) Skatech Research Lab, 2000-2026.
+ * Last change: 2026.10.16
+ * Host-native HAL - Arduino Print/Printable
+ *****************************************************************************/
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "WString.h"
+
+class Print;
+
+class Printable {
+    public:
+    virtual ~Printable() { }
+    virtual size_t printTo(Print& p) const = 0;
+};
+
+class Print {
+    public:
+    virtual ~Print() { }
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t* buffer, size_t size);
+    size_t write(const char* str) { return str ? write((const uint8_t*)str, strlen(str)) : 0; }
+    size_t write(const char* buffer, size_t size) { return write((const uint8_t*)buffer, size); }
+
+    size_t printf(const char* format, ...) __attribute__((format(printf, 2, 3)));
+
+    size_t print(const char* str) { return write(str); }
+    size_t print(const String& str) { return write(str.c_str(), str.length()); }
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(int value) { return printf("%d", value); }
+    size_t print(unsigned int value) { return printf("%u", value); }
+    size_t print(long value) { return printf("%ld", value); }
+    size_t print(unsigned long value) { return printf("%lu", value); }
+    size_t print(long long value) { return printf("%lld", value); }
+    size_t print(unsigned long long value) { return printf("%llu", value); }
+    size_t print(double value, int digits = 2) { return printf("%.*f", digits, value); }
+    size_t print(const Printable& value) { return value.printTo(*this); }
+
+    size_t println() { return write("\r\n"); }
+    template<typename T> size_t println(const T& value) { return print(value) + println(); }
+};
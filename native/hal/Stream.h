@@ -0,0 +1,48 @@
+/******************************************************************************
+ * (c) Skatech Research Lab, 2000-2026.
+ * Last change: 2026.10.16
+ * Host-native HAL - Arduino Stream
+ *****************************************************************************/
+
+#pragma once
+
+#include "Print.h"
+
+class Stream : public Print {
+    protected:
+    unsigned long _timeout = 1000;
+
+    public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+
+    virtual size_t readBytes(uint8_t* buffer, size_t length) {
+        size_t count = 0;
+        while (count < length && available() > 0) {
+            buffer[count++] = (uint8_t)read();
+        }
+        return count;
+    }
+
+    size_t readBytes(char* buffer, size_t length) {
+        return readBytes((uint8_t*)buffer, length);
+    }
+
+    // read until terminator, it is consumed but not stored
+    size_t readBytesUntil(char terminator, char* buffer, size_t length) {
+        size_t count = 0;
+        while (count < length && available() > 0) {
+            int c = read();
+            if (c == terminator) {
+                break;
+            }
+            buffer[count++] = (char)c;
+        }
+        return count;
+    }
+
+    void setTimeout(unsigned long timeout) {
+        _timeout = timeout;
+    }
+};
@@ -0,0 +1,175 @@
+/******************************************************************************
+ * (c) Skatech Research Lab, 2000-2026.
+ * Last change: 2026.10.17
+ * Host-native HAL - memory-only U8g2 display with SSD1306 tile buffer layout
+ *****************************************************************************/
+
+#include <U8g2lib.h>
+
+#include "hal.h"
+
+// SSD1306 page addressing: column and page address commands before each tile row
+#define SSD1306_ROW_COMMAND_BYTES 6
+
+const u8g2_cb_t u8g2_cb_r0;
+
+const uint8_t u8g2_font_logisoso32_tn[] = { 20, 32, 32, ' ', ':' };
+const uint8_t u8g2_font_inb33_mn[] = { 27, 33, 33, ' ', ':' };
+const uint8_t u8g2_font_crox5h_tr[] = { 10, 16, 13, ' ', '~' };
+const uint8_t u8g2_font_crox5hb_tr[] = { 11, 16, 13, ' ', '~' };
+const uint8_t u8g2_font_5x7_tr[] = { 5, 7, 6, ' ', '~' };
+
+// tiles land in the panel image, rows of given stride
+void U8G2::transfer(uint8_t tx, uint8_t ty, uint8_t tw, uint8_t th, const uint8_t* tiles, uint16_t stride) {
+    for (uint8_t row = 0; row < th && ty + row < 8; row++) {
+        uint8_t count = min(tw, (uint8_t)(16 - min(tx, (uint8_t)16)));
+        memcpy(hal::displayPanel() + (ty + row) * 128 + tx * 8, tiles + row * stride, count * 8);
+    }
+    hal::countDisplayTransfer((uint32_t)th * (tw * 8 + SSD1306_ROW_COMMAND_BYTES), _busClock);
+}
+
+uint8_t u8x8_DrawTile(u8x8_t* u8x8, uint8_t x, uint8_t y, uint8_t cnt, uint8_t* tile_ptr) {
+    u8x8->owner->transfer(x, y, cnt, 1, tile_ptr, cnt * 8);
+    return 1;
+}
+
+// full buffer mode only, the page buffer holds no whole area
+void U8G2::updateDisplayArea(uint8_t tx, uint8_t ty, uint8_t tw, uint8_t th) {
+    if (_bufferTileRows == 8) {
+        transfer(tx, ty, tw, th, _buffer + (ty * 16 + tx) * 8, 128);
+    }
+}
+
+void U8G2::clearDisplay() {
+    firstPage();
+    while (nextPage()) {
+    }
+}
+
+void U8G2::firstPage() {
+    _currentTileRow = 0;
+    clearBuffer();
+}
+
+uint8_t U8G2::nextPage() {
+    transfer(0, _currentTileRow, 16, _bufferTileRows, _buffer, 128);
+    _currentTileRow += _bufferTileRows;
+    if (_currentTileRow >= 8) {
+        _currentTileRow = 0;
+        return 0;
+    }
+    clearBuffer();
+    return 1;
+}
+
+u8g2_uint_t U8G2::getStrWidth(const char* s) const {
+    u8g2_uint_t width = 0;
+    for (; _font && *s; s++) {
+        if (*s >= _font[3] && *s <= _font[4]) {
+            width += _font[0];
+        }
+    }
+    return width;
+}
+
+// placeholder glyph decoding, costs a pixel test for every glyph box pixel
+u8g2_uint_t U8G2::drawGlyph(u8g2_uint_t x, u8g2_uint_t y, uint16_t encoding) {
+    if (_font == nullptr || encoding < _font[3] || encoding > _font[4]) {
+        return 0;
+    }
+    int top = _fontPosTop ? y : y - _font[2];
+    if (encoding != ' ') {
+        for (int gy = 0; gy < _font[1]; gy++) {
+            for (int gx = 1; gx < _font[0] - 1; gx++) {
+                if ((gx * 5 + gy * 3 + encoding) % 7 < 3) {
+                    drawPixel(x + gx, top + gy);
+                }
+            }
+        }
+    }
+    return _font[0];
+}
+
+u8g2_uint_t U8G2::drawStr(u8g2_uint_t x, u8g2_uint_t y, const char* s) {
+    u8g2_uint_t width = 0;
+    while (*s) {
+        width += drawGlyph(x + width, y, (uint8_t)*s++);
+    }
+    return width;
+}
+
+void U8G2::drawPixel(u8g2_uint_t x, u8g2_uint_t y) {
+    int row = y / 8 - _currentTileRow;
+    if (x >= 128 || y >= 64 || row < 0 || row >= _bufferTileRows) {
+        return;
+    }
+    uint8_t& cell = _buffer[row * 128 + x];
+    uint8_t mask = 1 << (y & 7);
+    if (_drawColor == 0) {
+        cell &= ~mask;
+    }
+    else if (_drawColor == 1) {
+        cell |= mask;
+    }
+    else cell ^= mask;
+}
+
+void U8G2::drawLine(u8g2_uint_t x1, u8g2_uint_t y1, u8g2_uint_t x2, u8g2_uint_t y2) {
+    int dx = abs(x2 - x1), dy = -abs(y2 - y1);
+    int sx = x1 < x2 ? 1 : -1, sy = y1 < y2 ? 1 : -1;
+    int error = dx + dy, x = x1, y = y1;
+    while (true) {
+        drawPixel(x, y);
+        if (x == x2 && y == y2) {
+            break;
+        }
+        int twice = 2 * error;
+        if (twice >= dy) {
+            error += dy;
+            x += sx;
+        }
+        if (twice <= dx) {
+            error += dx;
+            y += sy;
+        }
+    }
+}
+
+void U8G2::drawHLine(u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w) {
+    while (w--) {
+        drawPixel(x++, y);
+    }
+}
+
+void U8G2::drawVLine(u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t h) {
+    while (h--) {
+        drawPixel(x, y++);
+    }
+}
+
+void U8G2::drawBox(u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h) {
+    while (h--) {
+        drawHLine(x, y++, w);
+    }
+}
+
+void U8G2::drawFrame(u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h) {
+    drawHLine(x, y, w);
+    drawHLine(x, y + h - 1, w);
+    drawVLine(x, y, h);
+    drawVLine(x + w - 1, y, h);
+}
+
+// solid bitmap mode, background pixels drawn with the inverted color
+void U8G2::drawXBM(u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h, const uint8_t* bitmap) {
+    uint8_t color = _drawColor;
+    uint8_t stride = (w + 7) / 8;
+    for (u8g2_uint_t by = 0; by < h; by++) {
+        for (u8g2_uint_t bx = 0; bx < w; bx++) {
+            bool on = bitmap[by * stride + bx / 8] & (1 << (bx & 7));
+            _drawColor = on ? color : (color == 0 ? 1 : 0);
+            drawPixel(x + bx, y + by);
+        }
+    }
+    _drawColor = color;
+}
@@ -0,0 +1,141 @@
+/******************************************************************************
+ * (c) Skatech Research Lab, 2000-2026.
+ * Last change: 2026.10.17
+ * Host-native HAL - memory-only U8g2 display with SSD1306 tile buffer layout,
+ * fonts are placeholder glyph boxes with the metrics of the real fonts
+ *****************************************************************************/
+
+#pragma once
+
+#include <Arduino.h>
+#include "hal.h"
+
+#define U8X8_PIN_NONE 255
+#define U8X8_HAVE_HW_I2C
+
+// effective bus clock of the bit-banged I2C driver, estimate
+#define HAL_SW_I2C_CLOCK 100000
+
+typedef uint8_t u8g2_uint_t;
+
+struct u8g2_cb_t { };
+extern const u8g2_cb_t u8g2_cb_r0;
+#define U8G2_R0 (&u8g2_cb_r0)
+
+// placeholder font layout: advance, height, ascent, first char, last char
+extern const uint8_t u8g2_font_logisoso32_tn[];
+extern const uint8_t u8g2_font_inb33_mn[];
+extern const uint8_t u8g2_font_crox5h_tr[];
+extern const uint8_t u8g2_font_crox5hb_tr[];
+extern const uint8_t u8g2_font_5x7_tr[];
+
+class U8G2;
+
+// display layer below the frame buffer, tiles go to the panel as given
+struct u8x8_t {
+    U8G2* owner;
+};
+
+uint8_t u8x8_DrawTile(u8x8_t* u8x8, uint8_t x, uint8_t y, uint8_t cnt, uint8_t* tile_ptr);
+
+// frame buffer of given tile rows, 8 full buffer (_F_), 1 or 2 page buffer (_1_, _2_)
+// drawn page by page with the current tile row moved over the display
+class U8G2 {
+    protected:
+    uint8_t _buffer[128 * 8];
+    uint8_t _bufferTileRows;
+    uint8_t _currentTileRow = 0;
+    uint32_t _busClock;
+    const uint8_t* _font = nullptr;
+    uint8_t _drawColor = 1;
+    bool _fontPosTop = false;
+    u8x8_t _u8x8 = { this };
+
+    U8G2(uint8_t bufferTileRows, uint32_t busClock)
+        : _bufferTileRows(bufferTileRows), _busClock(busClock) {
+        memset(_buffer, 0, sizeof(_buffer));
+    }
+
+    void transfer(uint8_t tx, uint8_t ty, uint8_t tw, uint8_t th, const uint8_t* tiles, uint16_t stride);
+    friend uint8_t u8x8_DrawTile(u8x8_t* u8x8, uint8_t x, uint8_t y, uint8_t cnt, uint8_t* tile_ptr);
+
+    public:
+    bool begin() { clearDisplay(); return true; }
+    void clearDisplay();
+    void clearBuffer() { memset(_buffer, 0, 128 * _bufferTileRows); }
+    void sendBuffer() { transfer(0, _currentTileRow, 16, _bufferTileRows, _buffer, 128); }
+    void updateDisplay() { sendBuffer(); }
+    void updateDisplayArea(uint8_t tx, uint8_t ty, uint8_t tw, uint8_t th);
+    void firstPage();
+    uint8_t nextPage();
+
+    uint8_t* getBufferPtr() { return _buffer; }
+    uint8_t getBufferTileWidth() const { return 16; }
+    uint8_t getBufferTileHeight() const { return _bufferTileRows; }
+    uint8_t getBufferCurrTileRow() const { return _currentTileRow; }
+    void setBufferCurrTileRow(uint8_t row) { _currentTileRow = row; }
+    u8x8_t* getU8x8() { return &_u8x8; }
+    u8g2_uint_t getDisplayWidth() const { return 128; }
+    u8g2_uint_t getDisplayHeight() const { return 64; }
+
+    void setBusClock(uint32_t clock) { _busClock = clock; }
+    void setContrast(uint8_t value) { hal::displayContrast() = value; }
+    void setPowerSave(uint8_t is_enable) { }
+
+    void setFont(const uint8_t* font) { _font = font; }
+    void setFontRefHeightExtendedText() { }
+    void setFontPosTop() { _fontPosTop = true; }
+    void setFontPosBaseline() { _fontPosTop = false; }
+    void setFontDirection(uint8_t dir) { }
+    void setDrawColor(uint8_t color) { _drawColor = color; }
+    int8_t getAscent() const { return _font ? _font[2] : 0; }
+    int8_t getMaxCharHeight() const { return _font ? _font[1] : 0; }
+    int8_t getMaxCharWidth() const { return _font ? _font[0] : 0; }
+    u8g2_uint_t getStrWidth(const char* s) const;
+    u8g2_uint_t drawStr(u8g2_uint_t x, u8g2_uint_t y, const char* s);
+    u8g2_uint_t drawGlyph(u8g2_uint_t x, u8g2_uint_t y, uint16_t encoding);
+
+    void drawPixel(u8g2_uint_t x, u8g2_uint_t y);
+    void drawLine(u8g2_uint_t x1, u8g2_uint_t y1, u8g2_uint_t x2, u8g2_uint_t y2);
+    void drawHLine(u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w);
+    void drawVLine(u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t h);
+    void drawBox(u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h);
+    void drawFrame(u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h);
+    void drawXBM(u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h, const uint8_t* bitmap);
+};
+
+class U8G2_SSD1306_128X64_NONAME_F_SW_I2C : public U8G2 {
+    public:
+    U8G2_SSD1306_128X64_NONAME_F_SW_I2C(const u8g2_cb_t* rotation, uint8_t clock, uint8_t data,
+        uint8_t reset = U8X8_PIN_NONE) : U8G2(8, HAL_SW_I2C_CLOCK) { }
+};
+
+class U8G2_SSD1306_128X64_NONAME_F_HW_I2C : public U8G2 {
+    public:
+    U8G2_SSD1306_128X64_NONAME_F_HW_I2C(const u8g2_cb_t* rotation, uint8_t reset = U8X8_PIN_NONE,
+        uint8_t clock = U8X8_PIN_NONE, uint8_t data = U8X8_PIN_NONE) : U8G2(8, 400000) { }
+};
+
+class U8G2_SSD1306_128X64_NONAME_1_SW_I2C : public U8G2 {
+    public:
+    U8G2_SSD1306_128X64_NONAME_1_SW_I2C(const u8g2_cb_t* rotation, uint8_t clock, uint8_t data,
+        uint8_t reset = U8X8_PIN_NONE) : U8G2(1, HAL_SW_I2C_CLOCK) { }
+};
+
+class U8G2_SSD1306_128X64_NONAME_1_HW_I2C : public U8G2 {
+    public:
+    U8G2_SSD1306_128X64_NONAME_1_HW_I2C(const u8g2_cb_t* rotation, uint8_t reset = U8X8_PIN_NONE,
+        uint8_t clock = U8X8_PIN_NONE, uint8_t data = U8X8_PIN_NONE) : U8G2(1, 400000) { }
+};
+
+class U8G2_SSD1306_128X64_NONAME_2_SW_I2C : public U8G2 {
+    public:
+    U8G2_SSD1306_128X64_NONAME_2_SW_I2C(const u8g2_cb_t* rotation, uint8_t clock, uint8_t data,
+        uint8_t reset = U8X8_PIN_NONE) : U8G2(2, HAL_SW_I2C_CLOCK) { }
+};
+
+class U8G2_SSD1306_128X64_NONAME_2_HW_I2C : public U8G2 {
+    public:
+    U8G2_SSD1306_128X64_NONAME_2_HW_I2C(const u8g2_cb_t* rotation, uint8_t reset = U8X8_PIN_NONE,
+        uint8_t clock = U8X8_PIN_NONE, uint8_t data = U8X8_PIN_NONE) : U8G2(2, 400000) { }
+};
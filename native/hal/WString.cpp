@@ -0,0 +1,275 @@
+/******************************************************************************
+ * (c) Skatech Research Lab, 2000-2026.
+ * Last change: 2026.10.16
+ * Host-native HAL - Arduino String, buffers allocated through hal heap
+ *****************************************************************************/
+
+#include <Arduino.h>
+#include <ctype.h>
+#include <stdarg.h>
+
+#include "hal.h"
+
+String::String(const char* cstr) {
+    init();
+    if (cstr) {
+        copy(cstr, strlen(cstr));
+    }
+}
+
+String::String(const String& str) {
+    init();
+    copy(str.c_str(), str._length);
+}
+
+String::String(String&& rval) {
+    init();
+    *this = static_cast<String&&>(rval);
+}
+
+String::String(char c) {
+    init();
+    copy(&c, 1);
+}
+
+String::String(unsigned char value, unsigned char base) : String((unsigned long)value, base) {
+}
+
+String::String(int value, unsigned char base) : String((long)value, base) {
+}
+
+String::String(unsigned int value, unsigned char base) : String((unsigned long)value, base) {
+}
+
+String::String(long value, unsigned char base) {
+    init();
+    if (base == 16) {
+        initNumber("%lx", value);
+    }
+    else initNumber("%ld", value);
+}
+
+String::String(unsigned long value, unsigned char base) {
+    init();
+    if (base == 16) {
+        initNumber("%lx", value);
+    }
+    else initNumber("%lu", value);
+}
+
+String::String(long long value) {
+    init();
+    initNumber("%lld", value);
+}
+
+String::String(unsigned long long value) {
+    init();
+    initNumber("%llu", value);
+}
+
+String::String(float value, unsigned char decimalPlaces) : String((double)value, decimalPlaces) {
+}
+
+// dtostrf() of the core rounds half away from zero, printf() rounds exact ties to even
+String::String(double value, unsigned char decimalPlaces) {
+    init();
+    double scale = pow(10, decimalPlaces);
+    initNumber("%s%.*f", value < 0 ? "-" : "", (int)decimalPlaces, floor(fabs(value) * scale + 0.5) / scale);
+}
+
+String::~String() {
+    if (_buffer != _sso) {
+        hal::heapFree(_buffer);
+    }
+}
+
+void String::initNumber(const char* fmt, ...) {
+    char buffer[40];
+    va_list args;
+    va_start(args, fmt);
+    vsnprintf(buffer, sizeof(buffer), fmt, args);
+    va_end(args);
+    copy(buffer, strlen(buffer));
+}
+
+bool String::reserveExact(unsigned int size) {
+    char* buffer = (char*)hal::heapRealloc(_buffer == _sso ? nullptr : _buffer, size + 1);
+    if (buffer == nullptr) {
+        return false;
+    }
+    if (_buffer == _sso) {
+        memcpy(buffer, _sso, _length + 1);
+    }
+    _buffer = buffer;
+    _capacity = size;
+    return true;
+}
+
+bool String::reserve(unsigned int size) {
+    return _capacity >= size || reserveExact(size);
+}
+
+String& String::copy(const char* cstr, unsigned int length) {
+    if (!reserve(length)) {
+        return *this;
+    }
+    memmove(_buffer, cstr, length);
+    _buffer[_length = length] = 0;
+    return *this;
+}
+
+String& String::operator =(const String& rhs) {
+    return this == &rhs ? *this : copy(rhs.c_str(), rhs._length);
+}
+
+String& String::operator =(String&& rval) {
+    if (this == &rval) {
+        return *this;
+    }
+    if (rval._buffer == rval._sso) {
+        return copy(rval._sso, rval._length);
+    }
+    if (_buffer != _sso) {
+        hal::heapFree(_buffer);
+    }
+    _buffer = rval._buffer; _capacity = rval._capacity; _length = rval._length;
+    rval.init();
+    return *this;
+}
+
+String& String::operator =(const char* cstr) {
+    return copy(cstr ? cstr : "", cstr ? strlen(cstr) : 0);
+}
+
+bool String::concat(const char* cstr, unsigned int length) {
+    if (length == 0) {
+        return true;
+    }
+    if (!reserve(_length + length)) {
+        return false;
+    }
+    memmove(_buffer + _length, cstr, length);
+    _buffer[_length += length] = 0;
+    return true;
+}
+
+bool String::concat(const String& str) {
+    return concat(str.c_str(), str._length);
+}
+
+bool String::concat(const char* cstr) {
+    return cstr && concat(cstr, strlen(cstr));
+}
+
+bool String::concat(char c) {
+    return concat(&c, 1);
+}
+
+bool String::equals(const String& str) const {
+    return _length == str._length && memcmp(c_str(), str.c_str(), _length) == 0;
+}
+
+bool String::equals(const char* cstr) const {
+    return strcmp(c_str(), cstr ? cstr : "") == 0;
+}
+
+bool String::startsWith(const String& prefix) const {
+    return prefix._length <= _length && memcmp(c_str(), prefix.c_str(), prefix._length) == 0;
+}
+
+char String::charAt(unsigned int index) const {
+    return index < _length ? _buffer[index] : 0;
+}
+
+int String::indexOf(char c, unsigned int fromIndex) const {
+    if (fromIndex >= _length) {
+        return -1;
+    }
+    const char* found = strchr(_buffer + fromIndex, c);
+    return found ? (int)(found - _buffer) : -1;
+}
+
+int String::indexOf(const String& str, unsigned int fromIndex) const {
+    if (fromIndex >= _length) {
+        return -1;
+    }
+    const char* found = strstr(_buffer + fromIndex, str.c_str());
+    return found ? (int)(found - _buffer) : -1;
+}
+
+String String::substring(unsigned int beginIndex, unsigned int endIndex) const {
+    if (beginIndex > endIndex) {
+        unsigned int swap = beginIndex; beginIndex = endIndex; endIndex = swap;
+    }
+    if (endIndex > _length) {
+        endIndex = _length;
+    }
+    String result;
+    if (beginIndex < endIndex) {
+        result.copy(_buffer + beginIndex, endIndex - beginIndex);
+    }
+    return result;
+}
+
+// rebuilds the string in a single pass over all occurrences
+void String::replace(const String& find, const String& replace) {
+    if (_length == 0 || find._length == 0) {
+        return;
+    }
+    int index = indexOf(find);
+    if (index < 0) {
+        return;
+    }
+    String result;
+    result.reserve(_length);
+    unsigned int from = 0;
+    while (index >= 0) {
+        result.concat(_buffer + from, index - from);
+        result.concat(replace);
+        from = index + find._length;
+        index = indexOf(find, from);
+    }
+    result.concat(_buffer + from, _length - from);
+    *this = static_cast<String&&>(result);
+}
+
+void String::trim() {
+    if (_length == 0) {
+        return;
+    }
+    unsigned int begin = 0, end = _length;
+    while (begin < end && isspace((unsigned char)_buffer[begin])) {
+        begin++;
+    }
+    while (end > begin && isspace((unsigned char)_buffer[end - 1])) {
+        end--;
+    }
+    memmove(_buffer, _buffer + begin, end - begin);
+    _buffer[_length = end - begin] = 0;
+}
+
+long String::toInt() const {
+    return atol(c_str());
+}
+
+float String::toFloat() const {
+    return (float)atof(c_str());
+}
+
+String operator +(const String& lhs, const String& rhs) {
+    String result(lhs);
+    result.concat(rhs);
+    return result;
+}
+
+String operator +(const String& lhs, const char* rhs) {
+    String result(lhs);
+    result.concat(rhs);
+    return result;
+}
+
+String operator +(const char* lhs, const String& rhs) {
+    String result(lhs);
+    result.concat(rhs);
+    return result;
+}
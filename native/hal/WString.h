@@ -0,0 +1,82 @@
+/******************************************************************************
+ * (c) Skatech Research Lab, 2000-2026.
+ * Last change: 2026.10.16
+ * Host-native HAL - Arduino String, buffers allocated through hal heap
+ *****************************************************************************/
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+class String {
+    private:
+    // short strings stay inline like the ESP8266 core SSO, no heap allocation
+    enum { SSO_CAPACITY = 11 };
+    char _sso[SSO_CAPACITY + 1];
+    char* _buffer;
+    unsigned int _capacity;
+    unsigned int _length;
+
+    void init() { _sso[0] = 0; _buffer = _sso; _capacity = SSO_CAPACITY; _length = 0; }
+
+    bool reserveExact(unsigned int size);
+    String& copy(const char* cstr, unsigned int length);
+    void initNumber(const char* fmt, ...);
+
+    public:
+    String(const char* cstr = "");
+    String(const String& str);
+    String(String&& rval);
+    explicit String(char c);
+    explicit String(unsigned char value, unsigned char base = 10);
+    explicit String(int value, unsigned char base = 10);
+    explicit String(unsigned int value, unsigned char base = 10);
+    explicit String(long value, unsigned char base = 10);
+    explicit String(unsigned long value, unsigned char base = 10);
+    explicit String(long long value);
+    explicit String(unsigned long long value);
+    explicit String(float value, unsigned char decimalPlaces = 2);
+    explicit String(double value, unsigned char decimalPlaces = 2);
+    ~String();
+
+    String& operator =(const String& rhs);
+    String& operator =(String&& rval);
+    String& operator =(const char* cstr);
+
+    bool reserve(unsigned int size);
+    unsigned int length() const { return _length; }
+    const char* c_str() const { return _buffer; }
+    char* begin() { return _buffer; }
+
+    bool concat(const String& str);
+    bool concat(const char* cstr);
+    bool concat(const char* cstr, unsigned int length);
+    bool concat(char c);
+    String& operator +=(const String& rhs) { concat(rhs); return *this; }
+    String& operator +=(const char* cstr) { concat(cstr); return *this; }
+    String& operator +=(char c) { concat(c); return *this; }
+
+    bool equals(const String& str) const;
+    bool equals(const char* cstr) const;
+    bool operator ==(const String& rhs) const { return equals(rhs); }
+    bool operator ==(const char* cstr) const { return equals(cstr); }
+    bool operator !=(const String& rhs) const { return !equals(rhs); }
+    bool operator !=(const char* cstr) const { return !equals(cstr); }
+    bool startsWith(const String& prefix) const;
+
+    char charAt(unsigned int index) const;
+    char operator [](unsigned int index) const { return charAt(index); }
+    int indexOf(char c, unsigned int fromIndex = 0) const;
+    int indexOf(const String& str, unsigned int fromIndex = 0) const;
+    String substring(unsigned int beginIndex) const { return substring(beginIndex, _length); }
+    String substring(unsigned int beginIndex, unsigned int endIndex) const;
+    void replace(const String& find, const String& replace);
+    void trim();
+    long toInt() const;
+    float toFloat() const;
+
+    friend String operator +(const String& lhs, const String& rhs);
+    friend String operator +(const String& lhs, const char* rhs);
+    friend String operator +(const char* lhs, const String& rhs);
+};
@@ -0,0 +1,58 @@
+/******************************************************************************
+ * (c) Skatech Research Lab, 2000-2026.
+ * Last change: 2026.10.16
+ * Host-native HAL - UDP socket stand-in talking to simulated NTP servers
+ *****************************************************************************/
+
+#pragma once
+
+#include <Arduino.h>
+
+#define HAL_UDP_PACKET 64
+
+// Datagrams sent to port 123 of the address of hal::setNtpServer() host are answered
+// by the NTP stand-in, replies become readable by parsePacket() when their simulated
+// travel time passed, other datagrams are dropped
+class WiFiUDP : public Stream {
+    private:
+    uint8_t _out[HAL_UDP_PACKET], _in[HAL_UDP_PACKET];
+    size_t _outSize = 0, _inSize = 0, _inPosition = 0;
+    IPAddress _outAddress, _remote;
+    uint16_t _outPort = 0, _localPort = 0;
+
+    public:
+    ~WiFiUDP() { stop(); }
+
+    uint8_t begin(uint16_t port) { _localPort = port; return 1; }
+    void stop();
+
+    int beginPacket(IPAddress ip, uint16_t port) {
+        _outAddress = ip; _outPort = port; _outSize = 0;
+        return 1;
+    }
+    int endPacket();
+    int parsePacket();
+
+    size_t write(uint8_t c) override { return write(&c, 1); }
+    size_t write(const uint8_t* buffer, size_t size) override {
+        size_t count = min(size, sizeof(_out) - _outSize);
+        memcpy(_out + _outSize, buffer, count);
+        _outSize += count;
+        return count;
+    }
+    using Print::write;
+
+    int available() override { return (int)(_inSize - _inPosition); }
+    int read() override { return available() > 0 ? _in[_inPosition++] : -1; }
+    int read(uint8_t* buffer, size_t length) {
+        size_t count = min(length, _inSize - _inPosition);
+        memcpy(buffer, _in + _inPosition, count);
+        _inPosition += count;
+        return (int)count;
+    }
+    int peek() override { return available() > 0 ? _in[_inPosition] : -1; }
+    void flush() { _inPosition = _inSize; }
+
+    IPAddress remoteIP() const { return _remote; }
+    uint16_t remotePort() const { return 123; }
+};
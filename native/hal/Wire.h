@@ -0,0 +1,22 @@
+/******************************************************************************
+ * (c) Skatech Research Lab, 2000-2026.
+ * Last change: 2026.10.16
+ * Host-native HAL - hardware I2C controller stand-in
+ *****************************************************************************/
+
+#pragma once
+
+#include <Arduino.h>
+
+class TwoWire {
+    private:
+    uint32_t _clock = 100000;
+
+    public:
+    void begin() { }
+    void begin(int sda, int scl) { }
+    void setClock(uint32_t frequency) { _clock = frequency; }
+    uint32_t getClock() const { return _clock; }
+};
+
+extern TwoWire Wire;
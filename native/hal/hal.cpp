@@ -0,0 +1,532 @@
+/******************************************************************************
+ * (c) Skatech Research Lab, 2000-2026.
+ * Last change: 2026.10.17
+ * Host-native HAL - simulated clock, heap accounting and core stand-ins
+ *****************************************************************************/
+
+#include <Arduino.h>
+#include <EEPROM.h>
+#include <ESP8266NetBIOS.h>
+#include <Wire.h>
+#include <sntp.h>
+#include <new>
+#include <stdarg.h>
+
+#include "hal.h"
+
+#define HAL_HEAP_SIZE 51200     // typical free heap of the firmware after boot
+#define HAL_HEAP_HEADER 16
+#define HAL_LIGHT_SLEEP_MIN 10  // ms of delay() the SDK enters light sleep for
+#define HAL_BEACON_MICROS 102400
+#define HAL_UART_BAUD 115200
+#define HAL_UART_FIFO 128
+#define HAL_FLASH_SECTORS 4             // distinct sectors written in a run
+#define HAL_FLASH_ERASE_MICROS 40000    // 4 KB sector erase
+#define HAL_FLASH_BYTE_NANOS 3000       // page program, 256 bytes in about 0.8 ms
+
+static uint64_t s_uptime = 0;
+static int64_t s_epochOffset = 0;     // microseconds of epoch at uptime zero
+static int64_t s_referenceOffset = 0; // microseconds of reference epoch at uptime zero
+static int32_t s_skewPpb = 0;
+static uint32_t s_allocations = 0, s_heapUsed = 0, s_heapPeak = 0;
+static bool s_serialEcho = false;
+static uint32_t s_serialBytes = 0;
+static uint64_t s_serialBlocked = 0;
+static uint32_t s_uartByteNanos = 1000000000 / (HAL_UART_BAUD / 10);
+static uint64_t s_uartIdleNanos = 0;        // uptime the transmit FIFO runs empty at
+static uint32_t s_eepromCommits = 0;
+static struct { uint32_t number; bool used; uint8_t data[SPI_FLASH_SEC_SIZE]; } s_flash[HAL_FLASH_SECTORS];
+static uint32_t s_flashErases = 0, s_flashWrites = 0, s_flashBytes = 0;
+static int64_t s_flashBudget = -1;          // bytes of flash work before power is cut, negative never
+static hal::DisplayStats s_display = { 0 };
+static uint8_t s_panel[128 * 8];
+static uint8_t s_contrast = 0;
+static hal::PowerStats s_power = { 0 };
+static uint64_t s_powerReset = 0;
+static uint8_t s_sleepType = 2, s_listenInterval = 1;  // modem sleep, as the Arduino core starts
+
+uint64_t hal::uptimeMicros() {
+    return s_uptime;
+}
+
+void hal::advance(uint64_t micros) {
+    s_uptime += micros;
+}
+
+// device wall clock, oscillator error accumulated over uptime
+static int64_t wallMicros() {
+    return s_epochOffset + (int64_t)s_uptime + (int64_t)s_uptime * s_skewPpb / 1000000000;
+}
+
+void hal::setEpochTime(int64_t seconds, uint32_t micros) {
+    s_epochOffset += seconds * 1000000 + micros - wallMicros();
+}
+
+void hal::setClockSkew(int32_t ppb) {
+    int64_t wall = wallMicros();
+    s_skewPpb = ppb;
+    s_epochOffset += wall - wallMicros();
+}
+
+void hal::setReferenceTime(int64_t seconds) {
+    s_referenceOffset = seconds * 1000000 - (int64_t)s_uptime;
+}
+
+int64_t hal::referenceMicros() {
+    return s_referenceOffset + (int64_t)s_uptime;
+}
+
+int64_t hal::clockErrorMicros() {
+    return wallMicros() - referenceMicros();
+}
+
+hal::PowerStats hal::powerStats() {
+    PowerStats stats = s_power;
+    stats.activeMicros = s_uptime - s_powerReset - s_power.idleMicros - s_power.lightMicros;
+    return stats;
+}
+
+void hal::resetPowerStats() {
+    s_power = { 0 };
+    s_powerReset = s_uptime;
+}
+
+void hal::setRadioSleep(uint8_t type, uint8_t listenInterval) {
+    s_sleepType = type;
+    s_listenInterval = type == 1 && listenInterval ? listenInterval : 1;
+}
+
+// none sleep receives at once, modem sleep wakes for every beacon, light sleep for
+// every listen interval of them
+uint64_t hal::radioReceiveMicros(uint64_t sentMicros) {
+    if (s_sleepType == 0) {
+        return sentMicros;
+    }
+    uint64_t period = (uint64_t)HAL_BEACON_MICROS * s_listenInterval;
+    return (sentMicros + period - 1) / period * period;
+}
+
+uint32_t hal::allocations() {
+    return s_allocations;
+}
+
+uint32_t hal::heapUsed() {
+    return s_heapUsed;
+}
+
+uint32_t hal::heapPeak() {
+    return s_heapPeak;
+}
+
+void hal::resetHeapPeak() {
+    s_heapPeak = s_heapUsed;
+}
+
+void* hal::heapAlloc(size_t size) {
+    uint8_t* block = (uint8_t*)malloc(size + HAL_HEAP_HEADER);
+    if (block == nullptr) {
+        return nullptr;
+    }
+    *(size_t*)block = size;
+    s_allocations++;
+    s_heapUsed += size;
+    if (s_heapUsed > s_heapPeak) {
+        s_heapPeak = s_heapUsed;
+    }
+    return block + HAL_HEAP_HEADER;
+}
+
+void* hal::heapRealloc(void* ptr, size_t size) {
+    if (ptr == nullptr) {
+        return heapAlloc(size);
+    }
+    uint8_t* block = (uint8_t*)ptr - HAL_HEAP_HEADER;
+    size_t old = *(size_t*)block;
+    block = (uint8_t*)realloc(block, size + HAL_HEAP_HEADER);
+    if (block == nullptr) {
+        return nullptr;
+    }
+    *(size_t*)block = size;
+    s_allocations++;
+    s_heapUsed = s_heapUsed - old + size;
+    if (s_heapUsed > s_heapPeak) {
+        s_heapPeak = s_heapUsed;
+    }
+    return block + HAL_HEAP_HEADER;
+}
+
+void hal::heapFree(void* ptr) {
+    if (ptr != nullptr) {
+        uint8_t* block = (uint8_t*)ptr - HAL_HEAP_HEADER;
+        s_heapUsed -= *(size_t*)block;
+        free(block);
+    }
+}
+
+void hal::setSerialEcho(bool echo) {
+    s_serialEcho = echo;
+}
+
+uint32_t hal::serialBytes() {
+    return s_serialBytes;
+}
+
+uint64_t hal::serialBlockedMicros() {
+    return s_serialBlocked;
+}
+
+const hal::DisplayStats& hal::displayStats() {
+    return s_display;
+}
+
+void hal::resetDisplayStats() {
+    s_display = { 0 };
+}
+
+// every byte costs 9 bus clocks (8 data bits + ACK), transfer blocks the CPU
+void hal::countDisplayTransfer(uint32_t bytes, uint32_t busClock) {
+    uint64_t micros = (uint64_t)bytes * 9 * 1000000 / busClock;
+    s_display.frames++;
+    s_display.bytes += bytes;
+    s_display.busMicros += micros;
+    advance(micros);
+}
+
+uint8_t* hal::displayPanel() {
+    return s_panel;
+}
+
+uint8_t& hal::displayContrast() {
+    return s_contrast;
+}
+
+uint32_t hal::eepromCommits() {
+    return s_eepromCommits;
+}
+
+uint32_t hal::flashErases() {
+    return s_flashErases;
+}
+
+uint32_t hal::flashWrites() {
+    return s_flashWrites;
+}
+
+uint32_t hal::flashBytesWritten() {
+    return s_flashBytes;
+}
+
+void hal::cutPowerAfter(uint32_t bytes) {
+    s_flashBudget = bytes;
+}
+
+void hal::restorePower() {
+    s_flashBudget = -1;
+}
+
+// image of given sector, NULL for one never written when not to be created
+static uint8_t* flashSector(uint32_t number, bool create) {
+    for (auto& sector : s_flash) {
+        if (sector.used && sector.number == number) {
+            return sector.data;
+        }
+    }
+    for (auto& sector : s_flash) {
+        if (create && !sector.used) {
+            sector.used = true;
+            sector.number = number;
+            memset(sector.data, 0xFF, sizeof(sector.data));
+            return sector.data;
+        }
+    }
+    return NULL;
+}
+
+// bytes of flash work done before power is cut
+static size_t flashWork(size_t bytes) {
+    if (s_flashBudget < 0) {
+        return bytes;
+    }
+    size_t done = (size_t)min((int64_t)bytes, s_flashBudget);
+    s_flashBudget -= done;
+    return done;
+}
+
+void* operator new(size_t size) {
+    void* ptr = hal::heapAlloc(size);
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* ptr) noexcept {
+    hal::heapFree(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    hal::heapFree(ptr);
+}
+
+void operator delete(void* ptr, size_t size) noexcept {
+    hal::heapFree(ptr);
+}
+
+void operator delete[](void* ptr, size_t size) noexcept {
+    hal::heapFree(ptr);
+}
+
+// libc time functions are redirected here by the linker (--wrap)
+extern "C" {
+    time_t __wrap_time(time_t* t) {
+        time_t sec = (time_t)(wallMicros() / 1000000);
+        if (t) {
+            *t = sec;
+        }
+        return sec;
+    }
+
+    int __wrap_gettimeofday(struct timeval* tv, void* tz) {
+        int64_t now = wallMicros();
+        tv->tv_sec = (time_t)(now / 1000000);
+        tv->tv_usec = (suseconds_t)(now % 1000000);
+        return 0;
+    }
+
+    int __wrap_settimeofday(const struct timeval* tv, const struct timezone* tz) {
+        if (tv) {
+            hal::setEpochTime(tv->tv_sec, tv->tv_usec);
+        }
+        return 0;
+    }
+}
+
+void pinMode(uint8_t pin, uint8_t mode) {
+}
+
+void digitalWrite(uint8_t pin, uint8_t value) {
+}
+
+// 32-bit counters wrap as on the device, micros() after 71 minutes
+unsigned long millis() {
+    return (uint32_t)(s_uptime / 1000);
+}
+
+unsigned long micros() {
+    return (uint32_t)s_uptime;
+}
+
+void delay(unsigned long ms) {
+    if (s_sleepType == 1 && ms >= HAL_LIGHT_SLEEP_MIN) {
+        s_power.lightMicros += (uint64_t)ms * 1000;
+        s_power.wakeups++;
+    }
+    else s_power.idleMicros += (uint64_t)ms * 1000;
+    hal::advance((uint64_t)ms * 1000);
+    hal::pollNetwork();
+}
+
+void delayMicroseconds(unsigned int us) {
+    hal::advance(us);
+}
+
+void yield() {
+    hal::pollNetwork();
+}
+
+void configTime(int timezone_sec, int daylightOffset_sec,
+        const char* server1, const char* server2, const char* server3) {
+    int offset = timezone_sec + daylightOffset_sec;
+    char tz[24];
+    snprintf(tz, sizeof(tz), "UTC%c%d:%02d", offset > 0 ? '-' : '+',
+        abs(offset) / 3600, abs(offset) % 3600 / 60);
+    configTime(tz, server1, server2, server3);
+}
+
+void setTZ(const char* tz) {
+    setenv("TZ", tz, 1);
+    tzset();
+}
+
+void configTime(const char* tz, const char* server1, const char* server2, const char* server3) {
+    setTZ(tz);
+    sntp_setservername(0, server1);
+    sntp_setservername(1, server2);
+    sntp_setservername(2, server3);
+    sntp_init();
+}
+
+size_t Print::write(const uint8_t* buffer, size_t size) {
+    size_t count = 0;
+    while (size--) {
+        count += write(*buffer++);
+    }
+    return count;
+}
+
+size_t Print::printf(const char* format, ...) {
+    char buffer[256];
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+    if (length < 0) {
+        return 0;
+    }
+    return write((const uint8_t*)buffer, (size_t)length < sizeof(buffer) ? length : sizeof(buffer) - 1);
+}
+
+size_t HardwareSerial::write(uint8_t c) {
+    return write(&c, 1);
+}
+
+void HardwareSerial::begin(unsigned long baud) {
+    s_uartByteNanos = 1000000000 / (baud / 10);
+}
+
+int HardwareSerial::availableForWrite() {
+    uint64_t now = s_uptime * 1000;
+    uint64_t queued = s_uartIdleNanos > now ? (s_uartIdleNanos - now + s_uartByteNanos - 1) / s_uartByteNanos : 0;
+    return queued < HAL_UART_FIFO ? HAL_UART_FIFO - (int)queued : 0;
+}
+
+size_t HardwareSerial::write(const uint8_t* buffer, size_t size) {
+    // last byte enters the FIFO once all but a FIFO of bytes ahead are sent
+    uint64_t now = s_uptime * 1000;
+    s_uartIdleNanos = (s_uartIdleNanos > now ? s_uartIdleNanos : now) + (uint64_t)size * s_uartByteNanos;
+    uint64_t accepted = s_uartIdleNanos - (uint64_t)HAL_UART_FIFO * s_uartByteNanos;
+    if (accepted > now) {
+        uint64_t micros = (accepted - now + 999) / 1000;
+        s_serialBlocked += micros;
+        hal::advance(micros);
+    }
+    s_serialBytes += size;
+    if (s_serialEcho) {
+        fwrite(buffer, 1, size, stdout);
+    }
+    return size;
+}
+
+HardwareSerial Serial;
+
+uint32_t EspClass::getFreeHeap() {
+    // benchmark harness allocates from the same host heap
+    return s_heapUsed < HAL_HEAP_SIZE ? HAL_HEAP_SIZE - s_heapUsed : 0;
+}
+
+uint32_t EspClass::getMaxFreeBlockSize() {
+    return getFreeHeap();
+}
+
+uint8_t EspClass::getHeapFragmentation() {
+    return 0;
+}
+
+uint32_t EspClass::getCycleCount() {
+    return (uint32_t)(s_uptime * 80);
+}
+
+bool EspClass::flashEraseSector(uint32_t sector) {
+    uint8_t* data = flashSector(sector, true);
+    if (data == NULL) {
+        return false;
+    }
+    size_t erased = flashWork(SPI_FLASH_SEC_SIZE);
+    memset(data, 0xFF, erased);
+    s_flashErases++;
+    hal::advance(HAL_FLASH_ERASE_MICROS);
+    return erased == SPI_FLASH_SEC_SIZE;
+}
+
+bool EspClass::flashWrite(uint32_t address, const uint32_t* data, size_t size) {
+    uint32_t offset = address % SPI_FLASH_SEC_SIZE;
+    uint8_t* sector = flashSector(address / SPI_FLASH_SEC_SIZE, true);
+    if (sector == NULL || address % 4 || size % 4 || offset + size > SPI_FLASH_SEC_SIZE) {
+        return false;
+    }
+    size_t written = flashWork(size);
+    for (size_t i = 0; i < written; i++) {
+        sector[offset + i] &= ((const uint8_t*)data)[i];
+    }
+    s_flashWrites++;
+    s_flashBytes += written;
+    hal::advance((uint64_t)written * HAL_FLASH_BYTE_NANOS / 1000);
+    return written == size;
+}
+
+bool EspClass::flashRead(uint32_t address, uint32_t* data, size_t size) {
+    uint32_t offset = address % SPI_FLASH_SEC_SIZE;
+    if (address % 4 || size % 4 || offset + size > SPI_FLASH_SEC_SIZE) {
+        return false;
+    }
+    const uint8_t* sector = flashSector(address / SPI_FLASH_SEC_SIZE, false);
+    if (sector) {
+        memcpy(data, sector + offset, size);
+    }
+    else memset(data, 0xFF, size);
+    return true;
+}
+
+EspClass ESP;
+
+static bool s_sntpEnabled = false;
+static const char* s_sntpServers[3] = { nullptr };
+
+bool sntp_enabled() {
+    return s_sntpEnabled;
+}
+
+void sntp_init() {
+    s_sntpEnabled = true;
+}
+
+void sntp_stop() {
+    s_sntpEnabled = false;
+}
+
+int8_t sntp_get_timezone() {
+    return (int8_t)(-timezone / 3600);
+}
+
+void sntp_setservername(unsigned char index, const char* server) {
+    s_sntpServers[index] = server;
+}
+
+const char* sntp_getservername(unsigned char index) {
+    return s_sntpServers[index];
+}
+
+void EEPROMClass::begin(size_t size) {
+    _size = size < sizeof(_data) ? size : sizeof(_data);
+    ESP.flashRead(HAL_EEPROM_SECTOR * SPI_FLASH_SEC_SIZE, (uint32_t*)_data, (_size + 3) & ~3);
+    _dirty = false;
+}
+
+bool EEPROMClass::commit() {
+    if (_size == 0) {
+        return false;
+    }
+    if (_dirty) {
+        s_eepromCommits++;
+        if (!ESP.flashEraseSector(HAL_EEPROM_SECTOR) ||
+                !ESP.flashWrite(HAL_EEPROM_SECTOR * SPI_FLASH_SEC_SIZE, (const uint32_t*)_data, (_size + 3) & ~3)) {
+            return false;
+        }
+        _dirty = false;
+    }
+    return true;
+}
+
+bool EEPROMClass::end() {
+    bool result = commit();
+    _size = 0;
+    return result;
+}
+
+EEPROMClass EEPROM;
+ESP8266NetBIOS NBNS;
+TwoWire Wire;
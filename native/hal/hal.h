@@ -0,0 +1,114 @@
+/******************************************************************************
+ * (c) Skatech Research Lab, 2000-2026.
+ * Last change: 2026.10.17
+ * Host-native HAL - simulation control and instrumentation of the Linux
+ * stand-ins for the ESP8266 Arduino core (clock, heap, network, display bus)
+ *****************************************************************************/
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+namespace hal {
+
+    // simulated clock, advanced only by delay() and explicit advance() calls
+    uint64_t uptimeMicros();
+    void advance(uint64_t micros);
+    void setEpochTime(int64_t seconds, uint32_t micros = 0);
+
+    // device oscillator error, wall clock runs fast by given parts per billion
+    void setClockSkew(int32_t ppb);
+
+    // true UTC of the simulation, advances with uptime, NTP stand-ins answer with it
+    void setReferenceTime(int64_t seconds);
+    int64_t referenceMicros();
+
+    // device wall clock minus reference time
+    int64_t clockErrorMicros();
+
+    // heap accounting of every String buffer and operator new allocation
+    uint32_t allocations();
+    uint32_t heapUsed();
+    uint32_t heapPeak();
+    void resetHeapPeak();
+    void* heapAlloc(size_t size);
+    void* heapRealloc(void* ptr, size_t size);
+    void heapFree(void* ptr);
+
+    // serial output is counted and dropped unless echo enabled, writes to a full transmit
+    // FIFO advance simulated time until the UART sends enough at the baud rate set
+    void setSerialEcho(bool echo);
+    uint32_t serialBytes();
+    uint64_t serialBlockedMicros();
+
+    // wifi station, connects after given delay of simulated time since WiFi.begin()
+    void setWiFiConnectDelay(uint32_t millis);
+
+    // canned response served for every HTTPClient request, raw WiFiClient receives it
+    // latency after request sent, HTTPClient blocks for it
+    void setHttpResponse(int code, const char* body, uint32_t latencyMillis = 0);
+    uint32_t httpRequests();
+
+    // DNS resolver answer delay and blocking TCP connect duration, connect fails when
+    // it takes longer than client timeout
+    void setNetworkDelays(uint32_t dnsMillis, uint32_t connectMillis);
+
+    // time handleClient() is held by every request served, socket reads and writes
+    void setWebServeDelay(uint32_t millis);
+
+    // NTP stand-in answering UDP port 123 of the address its host name resolves to,
+    // reply is off reference time by bias, each way takes half of delay plus pseudo-random
+    // share of jitter, given percent of requests is lost
+    void setNtpServer(const char* host, int32_t biasMicros, uint32_t delayMillis,
+        uint32_t jitterMillis = 0, uint8_t lossPercent = 0);
+    void clearNtpServers();
+    uint32_t ntpRequests();
+
+    // deliver due asynchronous network events, called from delay() and yield()
+    void pollNetwork();
+
+    // display bus traffic, sendBuffer and updateDisplayArea transfers
+    struct DisplayStats {
+        uint32_t frames;
+        uint32_t bytes;
+        uint64_t busMicros;
+    };
+    const DisplayStats& displayStats();
+    void resetDisplayStats();
+    void countDisplayTransfer(uint32_t bytes, uint32_t busClock);
+    // panel image of 8 tile rows by 128 columns, transfers written into it
+    uint8_t* displayPanel();
+    // panel contrast, set by setContrast()
+    uint8_t& displayContrast();
+
+    // radio power save set by WiFi.setSleepMode(), delay() of HAL_LIGHT_SLEEP_MIN ms or more
+    // sleeps in light sleep, frames sent to a power saving station are buffered by the
+    // access point until the next beacon it listens to
+    struct PowerStats {
+        uint64_t activeMicros;          // outside delay()
+        uint64_t idleMicros;            // in delay(), radio on or modem sleep
+        uint64_t lightMicros;           // in delay(), light sleep
+        uint32_t wakeups;               // light sleeps ended
+    };
+    PowerStats powerStats();
+    void resetPowerStats();
+    void setRadioSleep(uint8_t type, uint8_t listenInterval);
+    uint64_t radioReceiveMicros(uint64_t sentMicros);
+
+    // emulated flash sector erase/write counter of EEPROM.commit()
+    uint32_t eepromCommits();
+
+    // emulated SPI flash, sectors read erased until first written, erase and programming
+    // take simulated time. Power is cut after given bytes of further erase or program work,
+    // the operation under way is left torn and later ones fail until power is restored
+    uint32_t flashErases();
+    uint32_t flashWrites();
+    uint32_t flashBytesWritten();
+    void cutPowerAfter(uint32_t bytes);
+    void restorePower();
+
+    // bytes written to and read from files of the in-memory file system
+    uint32_t fsBytesWritten();
+    uint32_t fsBytesRead();
+}
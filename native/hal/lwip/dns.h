@@ -0,0 +1,26 @@
+/******************************************************************************
+ * (c) Skatech Research Lab, 2000-2026.
+ * Last change: 2026.10.16
+ * Host-native HAL - lwIP asynchronous DNS resolver stand-in
+ *****************************************************************************/
+
+#pragma once
+
+#include <stdint.h>
+
+typedef int8_t err_t;
+
+#define ERR_OK          0
+#define ERR_INPROGRESS  (-5)
+#define ERR_ARG         (-16)
+
+struct ip_addr_t {
+    uint32_t addr;
+};
+
+typedef void (*dns_found_callback)(const char* name, const ip_addr_t* ipaddr, void* callback_arg);
+
+// Answers from cache with ERR_OK when resolver delay is zero, otherwise ERR_INPROGRESS
+// and callback is called from delay() or yield() once delay of simulated time passed,
+// NTP stand-in hosts resolve to their own addresses, any other host to the web server
+err_t dns_gethostbyname(const char* hostname, ip_addr_t* addr, dns_found_callback found, void* callback_arg);
@@ -0,0 +1,586 @@
+/******************************************************************************
+ * (c) Skatech Research Lab, 2000-2026.
+ * Last change: 2026.10.17
+ * Host-native HAL - simulated WiFi station, HTTP client and web server
+ *****************************************************************************/
+
+#include <ESP8266WiFi.h>
+#include <ESP8266HTTPClient.h>
+#include <ESP8266WebServer.h>
+#include <WiFiUdp.h>
+#include <strings.h>
+#include <vector>
+
+#include "hal.h"
+
+static bool s_wifiStarted = false;
+static uint64_t s_wifiConnectAt = 0;
+static uint32_t s_wifiConnectDelay = 1500;
+
+static int s_httpCode = HTTP_CODE_OK;
+static std::string s_httpBody;
+static uint32_t s_httpLatency = 0;
+static uint32_t s_httpRequests = 0;
+
+static uint32_t s_dnsDelay = 0, s_connectDelay = 0;
+static uint32_t s_webServeDelay = 0;
+static WiFiSleepType_t s_sleepType = WIFI_MODEM_SLEEP;
+
+struct DnsQuery {
+    dns_found_callback found;
+    void* argument;
+    uint64_t at;
+    ip_addr_t address;
+};
+static std::vector<DnsQuery> s_dnsQueries;
+
+struct NtpServer {
+    std::string host;
+    ip_addr_t address;
+    int32_t bias;
+    uint32_t delay, jitter;
+    uint8_t loss;
+};
+static std::vector<NtpServer> s_ntpServers;
+static uint32_t s_ntpRequests = 0;
+static uint32_t s_random = 12345;
+
+struct Datagram {
+    WiFiUDP* owner;
+    uint64_t at;
+    ip_addr_t from;
+    uint8_t data[48];
+};
+static std::vector<Datagram> s_datagrams;
+
+void hal::setWiFiConnectDelay(uint32_t millis) {
+    s_wifiConnectDelay = millis;
+}
+
+void hal::setHttpResponse(int code, const char* body, uint32_t latencyMillis) {
+    s_httpCode = code;
+    s_httpBody = body;
+    s_httpLatency = latencyMillis;
+}
+
+uint32_t hal::httpRequests() {
+    return s_httpRequests;
+}
+
+void hal::setNetworkDelays(uint32_t dnsMillis, uint32_t connectMillis) {
+    s_dnsDelay = dnsMillis;
+    s_connectDelay = connectMillis;
+}
+
+void hal::setWebServeDelay(uint32_t millis) {
+    s_webServeDelay = millis;
+}
+
+static const ip_addr_t s_serverAddress = { IPADDR4_INIT_BYTES(188, 114, 96, 3) };
+
+void hal::setNtpServer(const char* host, int32_t biasMicros, uint32_t delayMillis,
+        uint32_t jitterMillis, uint8_t lossPercent) {
+    for (NtpServer& server : s_ntpServers) {
+        if (server.host == host) {
+            server.bias = biasMicros; server.delay = delayMillis; server.jitter = jitterMillis;
+            server.loss = lossPercent;
+            return;
+        }
+    }
+    ip_addr_t address = { IPADDR4_INIT_BYTES(10, 0, 0, s_ntpServers.size() + 1) };
+    s_ntpServers.push_back({ host, address, biasMicros, delayMillis, jitterMillis, lossPercent });
+}
+
+void hal::clearNtpServers() {
+    s_ntpServers.clear();
+    s_datagrams.clear();
+}
+
+uint32_t hal::ntpRequests() {
+    return s_ntpRequests;
+}
+
+static uint32_t nextRandom() {
+    s_random = s_random * 1103515245 + 12345;
+    return s_random >> 8;
+}
+
+void hal::pollNetwork() {
+    for (size_t i = 0; i < s_dnsQueries.size(); ) {
+        if (hal::uptimeMicros() >= s_dnsQueries[i].at) {
+            DnsQuery query = s_dnsQueries[i];
+            s_dnsQueries.erase(s_dnsQueries.begin() + i);
+            query.found("", WiFi.status() == WL_CONNECTED ? &query.address : nullptr, query.argument);
+        }
+        else i++;
+    }
+}
+
+err_t dns_gethostbyname(const char* hostname, ip_addr_t* addr, dns_found_callback found, void* callback_arg) {
+    if (hostname == nullptr || *hostname == 0) {
+        return ERR_ARG;
+    }
+    ip_addr_t address = s_serverAddress;
+    for (const NtpServer& server : s_ntpServers) {
+        if (server.host == hostname) {
+            address = server.address;
+        }
+    }
+    if (s_dnsDelay == 0) {
+        *addr = address;
+        return ERR_OK;
+    }
+    s_dnsQueries.push_back({ found, callback_arg, hal::uptimeMicros() + (uint64_t)s_dnsDelay * 1000, address });
+    return ERR_INPROGRESS;
+}
+
+static void putTimestamp(uint8_t* data, int64_t micros) {
+    uint32_t seconds = (uint32_t)(micros / 1000000 + 2208988800LL);
+    uint32_t fraction = (uint32_t)(((uint64_t)(micros % 1000000) << 32) / 1000000);
+    for (int i = 0; i < 4; i++) {
+        data[i] = (uint8_t)(seconds >> (24 - i * 8));
+        data[4 + i] = (uint8_t)(fraction >> (24 - i * 8));
+    }
+}
+
+int WiFiUDP::endPacket() {
+    if (WiFi.status() != WL_CONNECTED) {
+        return 0;
+    }
+    for (const NtpServer& server : s_ntpServers) {
+        if (uint32_t(_outAddress) != server.address.addr || _outPort != 123 || _outSize < 48) {
+            continue;
+        }
+        s_ntpRequests++;
+        if (nextRandom() % 100 < server.loss) {
+            return 1;
+        }
+        uint64_t out = server.delay * 500ULL + (server.jitter ? nextRandom() % (server.jitter * 1000) : 0);
+        uint64_t back = server.delay * 500ULL + (server.jitter ? nextRandom() % (server.jitter * 1000) : 0);
+        Datagram reply = { this, hal::uptimeMicros() + out + 30 + back, server.address, { 0 } };
+        int64_t received = hal::referenceMicros() + (int64_t)out + server.bias;
+        reply.data[0] = 0x24;           // no leap warning, version 4, server mode
+        reply.data[1] = 2;              // stratum
+        reply.data[2] = _out[2];
+        reply.data[3] = 0xEC;           // precision 2^-20
+        memcpy(reply.data + 12, "SIM\0", 4);
+        putTimestamp(reply.data + 16, received - 16000000);
+        memcpy(reply.data + 24, _out + 40, 8);
+        putTimestamp(reply.data + 32, received);
+        putTimestamp(reply.data + 40, received + 30);
+        s_datagrams.push_back(reply);
+    }
+    return 1;
+}
+
+int WiFiUDP::parsePacket() {
+    size_t first = s_datagrams.size();
+    for (size_t i = 0; i < s_datagrams.size(); i++) {
+        if (s_datagrams[i].owner == this && s_datagrams[i].at <= hal::uptimeMicros() &&
+                (first == s_datagrams.size() || s_datagrams[i].at < s_datagrams[first].at)) {
+            first = i;
+        }
+    }
+    if (first == s_datagrams.size()) {
+        _inSize = _inPosition = 0;
+        return 0;
+    }
+    memcpy(_in, s_datagrams[first].data, 48);
+    _remote = IPAddress(&s_datagrams[first].from);
+    _inSize = 48;
+    _inPosition = 0;
+    s_datagrams.erase(s_datagrams.begin() + first);
+    return 48;
+}
+
+void WiFiUDP::stop() {
+    for (size_t i = 0; i < s_datagrams.size(); ) {
+        if (s_datagrams[i].owner == this) {
+            s_datagrams.erase(s_datagrams.begin() + i);
+        }
+        else i++;
+    }
+}
+
+bool ESP8266WiFiClass::disconnect(bool wifioff) {
+    s_wifiStarted = false;
+    return true;
+}
+
+bool ESP8266WiFiClass::mode(WiFiMode_t mode) {
+    return true;
+}
+
+bool ESP8266WiFiClass::hostname(const char* name) {
+    return true;
+}
+
+bool ESP8266WiFiClass::config(IPAddress local, IPAddress gateway, IPAddress subnet, IPAddress dns1) {
+    return true;
+}
+
+wl_status_t ESP8266WiFiClass::begin(const char* ssid, const char* passphrase) {
+    s_wifiStarted = true;
+    s_wifiConnectAt = hal::uptimeMicros() + (uint64_t)s_wifiConnectDelay * 1000;
+    return status();
+}
+
+wl_status_t ESP8266WiFiClass::status() {
+    if (!s_wifiStarted) {
+        return WL_IDLE_STATUS;
+    }
+    return hal::uptimeMicros() >= s_wifiConnectAt ? WL_CONNECTED : WL_DISCONNECTED;
+}
+
+bool ESP8266WiFiClass::setSleepMode(WiFiSleepType_t type, uint8_t listenInterval) {
+    s_sleepType = type;
+    hal::setRadioSleep(type, listenInterval);
+    return true;
+}
+
+WiFiSleepType_t ESP8266WiFiClass::getSleepMode() {
+    return s_sleepType;
+}
+
+String ESP8266WiFiClass::macAddress() {
+    return String("5C:CF:7F:00:00:01");
+}
+
+IPAddress ESP8266WiFiClass::localIP() {
+    return status() == WL_CONNECTED ? IPAddress(192, 168, 0, 83) : IPAddress();
+}
+
+// signal of a room away from the access point while connected
+int32_t ESP8266WiFiClass::RSSI() {
+    return status() == WL_CONNECTED ? -61 : 31;
+}
+
+ESP8266WiFiClass WiFi;
+
+int WiFiClient::connect(const char* host, uint16_t port) {
+    if (WiFi.status() != WL_CONNECTED) {
+        return 0;
+    }
+    stop();
+    _terminator = 0;
+    _connected = true;
+    return 1;
+}
+
+int WiFiClient::connect(IPAddress ip, uint16_t port) {
+    if (WiFi.status() != WL_CONNECTED || s_httpCode == HTTPC_ERROR_CONNECTION_FAILED) {
+        return 0;
+    }
+    if (s_connectDelay > _timeout) {
+        delay(_timeout);
+        return 0;
+    }
+    delay(s_connectDelay);
+    return connect("", port);
+}
+
+void WiFiClient::stop() {
+    if (_peer) {
+        _peer->open = false;
+        _peer.reset();
+    }
+    _connected = false;
+    _headerSize = _bodySize = _position = 0;
+    _readyAt = 0;
+}
+
+size_t WiFiClient::availableForWrite() {
+    if (_peer) {
+        return _peer->open ? _peer->capacity - min(_peer->received.size(), _peer->capacity) : 0;
+    }
+    return _connected ? HAL_TCP_SEND_BUFFER : 0;
+}
+
+uint8_t WiFiClient::connected() {
+    if (_peer) {
+        return _peer->open;
+    }
+    return (_connected && (_readyAt == 0 || hal::uptimeMicros() < _readyAt)) || available() > 0;
+}
+
+int WiFiClient::available() {
+    if (_readyAt > hal::uptimeMicros()) {
+        return 0;
+    }
+    return (int)(_headerSize + _bodySize - _position);
+}
+
+size_t WiFiClient::write(const uint8_t* buffer, size_t size) {
+    if (_peer) {
+        size_t count = min(size, availableForWrite());
+        _peer->received.append((const char*)buffer, count);
+        return count;
+    }
+    if (!_connected) {
+        return 0;
+    }
+    for (size_t i = 0; i < size && _terminator != 0x0D0A0D0A; i++) {
+        _terminator = (_terminator << 8) | buffer[i];
+        if (_terminator == 0x0D0A0D0A) {
+            s_httpRequests++;
+            _readyAt = hal::uptimeMicros() + (uint64_t)s_httpLatency * 1000;
+            if (s_httpCode <= 0) {
+                _headerSize = _bodySize = 0;
+                continue;
+            }
+            _headerSize = snprintf(_header, sizeof(_header), "HTTP/1.1 %d %s\r\nContent-Type: application/json\r\n"
+                "Content-Length: %u\r\nConnection: close\r\n\r\n", s_httpCode,
+                s_httpCode == HTTP_CODE_OK ? "OK" : "ERROR", (unsigned)s_httpBody.size());
+            _body = s_httpBody.data();
+            _bodySize = s_httpBody.size();
+            _position = 0;
+        }
+    }
+    return size;
+}
+
+int WiFiClient::peek() {
+    if (available() <= 0) {
+        return -1;
+    }
+    return (uint8_t)(_position < _headerSize ? _header[_position] : _body[_position - _headerSize]);
+}
+
+size_t WiFiClient::readBytes(uint8_t* buffer, size_t length) {
+    size_t count = 0;
+    while (count < length && available() > 0) {
+        size_t part;
+        if (_position < _headerSize) {
+            part = min(length - count, _headerSize - _position);
+            memcpy(buffer + count, _header + _position, part);
+        }
+        else {
+            part = min(length - count, _headerSize + _bodySize - _position);
+            memcpy(buffer + count, _body + _position - _headerSize, part);
+        }
+        count += part;
+        _position += part;
+    }
+    return count;
+}
+
+bool HTTPClient::begin(WiFiClient& client, const String& url) {
+    _client = &client;
+    _size = -1;
+    return url.startsWith("http://");
+}
+
+int HTTPClient::GET() {
+    if (_client == nullptr || WiFi.status() != WL_CONNECTED) {
+        return HTTPC_ERROR_CONNECTION_FAILED;
+    }
+    s_httpRequests++;
+    hal::advance((uint64_t)(s_dnsDelay + s_connectDelay + s_httpLatency) * 1000);
+    if (s_httpCode <= 0) {
+        return s_httpCode;
+    }
+    _client->load(s_httpBody.data(), s_httpBody.size());
+    _size = (int)s_httpBody.size();
+    return s_httpCode;
+}
+
+String HTTPClient::getString() {
+    String result;
+    if (_client == nullptr || _size <= 0) {
+        return result;
+    }
+    result.reserve(_size);
+    char buffer[128];
+    size_t count;
+    while ((count = _client->readBytes(buffer, sizeof(buffer))) > 0) {
+        result.concat(buffer, count);
+    }
+    return result;
+}
+
+void HTTPClient::end() {
+    if (_client) {
+        _client->stop();
+    }
+    _client = nullptr;
+}
+
+String HTTPClient::errorToString(int error) {
+    switch (error) {
+        case HTTPC_ERROR_CONNECTION_FAILED: return String("connection failed");
+        case HTTPC_ERROR_SEND_HEADER_FAILED: return String("send header failed");
+        case HTTPC_ERROR_NOT_CONNECTED: return String("not connected");
+        case HTTPC_ERROR_CONNECTION_LOST: return String("connection lost");
+        case HTTPC_ERROR_NO_HTTP_SERVER: return String("no HTTP server");
+        case HTTPC_ERROR_READ_TIMEOUT: return String("read Timeout");
+    }
+    return String();
+}
+
+void ESP8266WebServer::on(const String& uri, HTTPMethod method, THandlerFunction handler) {
+    _routes.push_back({ uri.c_str(), method, handler });
+}
+
+void ESP8266WebServer::serveStatic(const char* uri, FS& fs, const char* path, const char* cache_header) {
+    _statics.push_back({ uri, path, cache_header ? cache_header : "", &fs });
+}
+
+std::shared_ptr<hal::Connection> ESP8266WebServer::simulate(const Request& request) {
+    _queue.push_back(request);
+    _queueReady.push_back(hal::radioReceiveMicros(hal::uptimeMicros()));
+    _queueConnections.push_back(std::make_shared<hal::Connection>());
+    return _queueConnections.back();
+}
+
+WiFiClient ESP8266WebServer::client() {
+    if (_connection) {
+        _connection->kept = true;
+    }
+    return WiFiClient(_connection);
+}
+
+void ESP8266WebServer::handleClient() {
+    if (_queue.empty() || _queueReady.front() > hal::uptimeMicros()) {
+        return;
+    }
+    _current = _queue.front();
+    _queue.erase(_queue.begin());
+    _queueReady.erase(_queueReady.begin());
+    _connection = _queueConnections.front();
+    _queueConnections.erase(_queueConnections.begin());
+    _response = Response();
+    _pendingHeaders.clear();
+    _contentLength = CONTENT_LENGTH_NOT_SET;
+    _served++;
+    _servedAt = hal::uptimeMicros();
+    hal::advance((uint64_t)s_webServeDelay * 1000);
+    dispatch();
+    // connection closes after the response unless the handler kept its client
+    if (!_connection->kept) {
+        _connection->open = false;
+    }
+    _connection.reset();
+}
+
+void ESP8266WebServer::dispatch() {
+    for (const Route& route : _routes) {
+        if (route.uri == _current.uri && (route.method == HTTP_ANY || route.method == _current.method)) {
+            route.handler();
+            return;
+        }
+    }
+    for (const StaticRoute& route : _statics) {
+        if (_current.method == HTTP_GET && serveStatic(route)) {
+            return;
+        }
+    }
+    for (const Route& route : _routes) {
+        if (route.uri.empty()) {
+            route.handler();
+            return;
+        }
+    }
+    send(404, "text/plain", "Not found");
+}
+
+bool ESP8266WebServer::serveStatic(const StaticRoute& route) {
+    if (_current.uri.compare(0, route.uri.size(), route.uri) != 0) {
+        return false;
+    }
+    std::string path = route.path + _current.uri.substr(route.uri.size());
+    if (path.empty() || path.back() == '/') {
+        path += "index.html";
+    }
+    File file = route.fs->open(path.c_str(), "r");
+    if (!file) {
+        return false;
+    }
+    if (!route.cacheHeader.empty()) {
+        sendHeader("Cache-Control", route.cacheHeader.c_str());
+    }
+    send(200, "text/plain", "");
+    uint8_t buffer[256];
+    size_t count;
+    while ((count = file.readBytes(buffer, sizeof(buffer))) > 0) {
+        sendContent((const char*)buffer, count);
+    }
+    return true;
+}
+
+String ESP8266WebServer::arg(const String& name) const {
+    for (const auto& arg : _current.args) {
+        if (arg.first == name.c_str()) {
+            return String(arg.second.c_str());
+        }
+    }
+    return String();
+}
+
+bool ESP8266WebServer::hasArg(const String& name) const {
+    for (const auto& arg : _current.args) {
+        if (arg.first == name.c_str()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+String ESP8266WebServer::header(const String& name) const {
+    for (const auto& header : _current.headers) {
+        if (strcasecmp(header.first.c_str(), name.c_str()) == 0) {
+            return String(header.second.c_str());
+        }
+    }
+    return String();
+}
+
+bool ESP8266WebServer::hasHeader(const String& name) const {
+    for (const auto& header : _current.headers) {
+        if (strcasecmp(header.first.c_str(), name.c_str()) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void ESP8266WebServer::requestAuthentication(HTTPAuthMethod mode, const char* realm, const String& authFailMsg) {
+    sendHeader("WWW-Authenticate", String("Basic realm=\"") + (realm ? realm : "Login Required") + "\"");
+    send(401, "text/html", authFailMsg);
+}
+
+void ESP8266WebServer::sendHeader(const String& name, const String& value, bool first) {
+    auto header = std::make_pair(std::string(name.c_str()), std::string(value.c_str()));
+    if (first) {
+        _pendingHeaders.insert(_pendingHeaders.begin(), header);
+    }
+    else _pendingHeaders.push_back(header);
+}
+
+void ESP8266WebServer::send(int code, const char* content_type, const String& content) {
+    send(code, content_type, content.c_str(), content.length());
+}
+
+void ESP8266WebServer::send(int code, const char* content_type, const char* content) {
+    send(code, content_type, content, content ? strlen(content) : 0);
+}
+
+void ESP8266WebServer::send(int code, const char* content_type, const char* content, size_t contentLength) {
+    _response.code = code;
+    _response.contentType = content_type ? content_type : "text/html";
+    _response.headers = _pendingHeaders;
+    _response.body.assign(content ? content : "", contentLength);
+    _response.chunked = _contentLength == CONTENT_LENGTH_UNKNOWN;
+    _response.chunks = 0;
+    _response.finished = false;
+    _pendingHeaders.clear();
+}
+
+void ESP8266WebServer::sendContent(const char* content, size_t size) {
+    _response.body.append(content, size);
+    if (_response.chunked) {
+        if (size == 0) {
+            _response.finished = true;
+        }
+        else _response.chunks++;
+    }
+}
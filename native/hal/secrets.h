@@ -0,0 +1,13 @@
+#pragma once
+
+// host-native build settings, never used on the device
+#define WIFI_SSID           "NATIVE"
+#define WIFI_PASSWORD       "NATIVE-PASSWORD"
+
+#define WEBUI_PORT          80
+#define WEBUI_HOSTNAME      "nativeclock"
+#define WEBUI_USER          "admin"
+#define WEBUI_PASSWORD      "admin"
+
+#define FORECAST_LATITUDE   78.14F
+#define FORECAST_LONGITUDE  15.26F
@@ -0,0 +1,16 @@
+/******************************************************************************
+ * (c) Skatech Research Lab, 2000-2026.
+ * Last change: 2026.10.16
+ * Host-native HAL - lwIP SNTP service controls, service never syncs
+ *****************************************************************************/
+
+#pragma once
+
+#include <Arduino.h>
+
+bool sntp_enabled();
+void sntp_init();
+void sntp_stop();
+int8_t sntp_get_timezone();
+void sntp_setservername(unsigned char index, const char* server);
+const char* sntp_getservername(unsigned char index);
@@ -0,0 +1,59 @@
+/******************************************************************************
+ * (c) Skatech Research Lab, 2000-2026.
+ * Last change: 2026.10.16
+ * ChunkedResponse class - Print sending web server response of unknown length
+ * by chunked transfer encoding from a fixed buffer
+ *****************************************************************************/
+
+#pragma once
+
+#include <Arduino.h>
+#include <ESP8266WebServer.h>
+
+#define RESPONSE_CHUNK_SIZE 256         // bytes collected before a chunk is sent
+
+// Headers are sent by the constructor, content as buffer fills, end() sends the rest
+// and the last empty chunk
+class ChunkedResponse : public Print {
+    private:
+    ESP8266WebServer& _server;
+    char _buffer[RESPONSE_CHUNK_SIZE];
+    size_t _length;
+
+    void flush() {
+        if (_length) {
+            _server.sendContent(_buffer, _length);
+            _length = 0;
+        }
+    }
+
+    public:
+    ChunkedResponse(ESP8266WebServer& server, int code, const char* contentType)
+        : _server(server), _length(0) {
+        _server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+        _server.send(code, contentType, "");
+    }
+
+    size_t write(uint8_t c) override {
+        return write(&c, 1);
+    }
+
+    size_t write(const uint8_t* data, size_t size) override {
+        for (size_t left = size; left > 0; ) {
+            size_t count = min(left, sizeof(_buffer) - _length);
+            memcpy(_buffer + _length, data, count);
+            _length += count;
+            data += count;
+            left -= count;
+            if (_length == sizeof(_buffer)) {
+                flush();
+            }
+        }
+        return size;
+    }
+
+    void end() {
+        flush();
+        _server.sendContent("", 0);
+    }
+};
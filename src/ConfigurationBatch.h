@@ -0,0 +1,144 @@
+/******************************************************************************
+ * (c) Skatech Research Lab, 2000-2026.
+ * Last change: 2026.10.17
+ * ConfigurationBatch class - set of settings changes checked as a whole on a
+ * staged copy of the configuration before any of them is applied
+ *****************************************************************************/
+
+#pragma once
+
+#include <Arduino.h>
+
+#include "configuration.h"
+#include "DateTime.h"
+#include "TimeZone.h"
+
+#define BATCH_COLORS_LENGTH 30          // hex digits of five display colors
+
+// Fields are named as members of GET /get-state, only given ones change. Nothing
+// is applied until every field is accepted, so a rejected batch leaves no trace
+class ConfigurationBatch {
+    private:
+    Configuration _staged;
+    DateTime _date;
+    bool _synchronize;
+    char _rejected[16];                 // name of the first field rejected
+
+    static bool parseFlag(const char* value, uint8_t* flag) {
+        if (strcmp(value, "1") == 0 || strcmp(value, "true") == 0) {
+            *flag = 1;
+        }
+        else if (strcmp(value, "0") == 0 || strcmp(value, "false") == 0) {
+            *flag = 0;
+        }
+        else return false;
+        return true;
+    }
+
+    // Strings are padded with zeros, equal values give equal bytes to compare
+    static bool parseString(const char* value, char* text, size_t size) {
+        if (strlen(value) >= size) {
+            return false;
+        }
+        strncpy(text, value, size);
+        return true;
+    }
+
+    static bool parseBrightness(const char* value, uint8_t* brightness) {
+        char* end;
+        unsigned long number = strtoul(value, &end, 10);
+        if (*value < '0' || *value > '9' || *end != 0 || number > 255) {
+            return false;
+        }
+        *brightness = number;
+        return true;
+    }
+
+    static bool parseColors(const char* value, uint32_t* colors) {
+        if (strlen(value) != BATCH_COLORS_LENGTH || strspn(value, "0123456789abcdefABCDEF") != BATCH_COLORS_LENGTH) {
+            return false;
+        }
+        for (uint8_t i = 0; i < BATCH_COLORS_LENGTH / 6; i++) {
+            char hex[7];
+            memcpy(hex, value + i * 6, 6);
+            hex[6] = 0;
+            colors[i] = strtoul(hex, NULL, 16);
+        }
+        return true;
+    }
+
+    public:
+    ConfigurationBatch(const Configuration& current)
+        : _staged(current), _date(NOT_A_TIME), _synchronize(false), _rejected() {
+    }
+
+    // Stage field change, return false and keep field name when value or name is invalid
+    bool set(const char* name, const char* value) {
+        bool accepted = false;
+        if (strcmp(name, "tzrule") == 0) {
+            TimeZone zone;
+            accepted = zone.parse(value) && parseString(value, _staged.timezoneRule, sizeof(_staged.timezoneRule));
+        }
+        else if (strcmp(name, "ntpenabled") == 0) {
+            accepted = parseFlag(value, &_staged.ntpenabled);
+        }
+        else if (strcmp(name, "ntpserver1") == 0) {
+            accepted = parseString(value, _staged.timeServer1, sizeof(_staged.timeServer1));
+        }
+        else if (strcmp(name, "ntpserver2") == 0) {
+            accepted = parseString(value, _staged.timeServer2, sizeof(_staged.timeServer2));
+        }
+        else if (strcmp(name, "ntpserver3") == 0) {
+            accepted = parseString(value, _staged.timeServer3, sizeof(_staged.timeServer3));
+        }
+        else if (strcmp(name, "brightness") == 0) {
+            accepted = parseBrightness(value, &_staged.displayBrightness);
+        }
+        else if (strcmp(name, "colors") == 0) {
+            accepted = parseColors(value, _staged.displayColors);
+        }
+        else if (strcmp(name, "date") == 0) {
+            _date = DateTime::parseISOString(value);
+            accepted = _date.isDateTime();
+        }
+        else if (strcmp(name, "synchronize") == 0) {
+            uint8_t flag = 0;
+            accepted = parseFlag(value, &flag);
+            _synchronize = flag;
+        }
+        if (!accepted && !_rejected[0]) {
+            strncpy(_rejected, name, sizeof(_rejected) - 1);
+        }
+        return accepted;
+    }
+
+    // Return name of the first field rejected, NULL when batch is valid
+    const char* getRejected() const {
+        return _rejected[0] ? _rejected : NULL;
+    }
+
+    const Configuration& getStaged() const {
+        return _staged;
+    }
+
+    // Return true when given part of the staged configuration differs from the current one
+    bool changes(const Configuration& current, size_t offset, size_t size) const {
+        return memcmp((const uint8_t*)&_staged + offset, (const uint8_t*)&current + offset, size) != 0;
+    }
+
+    bool changes(const Configuration& current) const {
+        return changes(current, 0, sizeof(Configuration));
+    }
+
+    bool hasDate() const {
+        return _date.isDateTime();
+    }
+
+    DateTime getDate() const {
+        return _date;
+    }
+
+    bool hasSynchronize() const {
+        return _synchronize;
+    }
+};
@@ -0,0 +1,258 @@
+/******************************************************************************
+ * (c) Skatech Research Lab, 2000-2026.
+ * Last change: 2026.10.17
+ * ConfigurationStore class - configuration journal appended to two flash
+ * sectors, newest whole record loaded at boot. Second sector is the one below
+ * EEPROM, free only when the filesystem ends before it as on 4 MB layouts. On
+ * 1 MB and 2 MB layouts LittleFS reaches EEPROM and the journal keeps to the
+ * EEPROM sector alone, power lost while it is erased loses the configuration
+ *****************************************************************************/
+
+#pragma once
+
+#include <Arduino.h>
+#include <stddef.h>
+
+#include "configuration.h"
+#include "Logger.h"
+
+#ifndef CONFIG_STORE_SECTOR
+#ifdef HAL_EEPROM_SECTOR
+#define CONFIG_STORE_SECTOR HAL_EEPROM_SECTOR   // host build, no linker symbols
+#define CONFIG_STORE_FS_END HAL_FS_END_SECTOR
+#else
+extern "C" uint32_t _EEPROM_start;
+extern "C" uint32_t _FS_end;
+#define CONFIG_STORE_SECTOR ((uint32_t)((uintptr_t)&_EEPROM_start - 0x40200000) / SPI_FLASH_SEC_SIZE)
+#define CONFIG_STORE_FS_END ((uint32_t)((uintptr_t)&_FS_end - 0x40200000) / SPI_FLASH_SEC_SIZE)
+#endif
+#endif
+
+#define CONFIG_STORE_SECTORS 2          // at most, EEPROM sector and the one below when past the filesystem
+#define CONFIG_RECORD_MAGIC 0xC0F1
+#define CONFIG_READ_CHUNK 64            // bytes of flash read at once, stack buffer
+
+// Header of every record, payload follows padded to whole words
+struct ConfigurationRecord {
+    uint16_t magic;
+    uint16_t crc16;                     // checksum of the rest of header and payload
+    uint16_t size;                      // payload bytes, format dependent
+    uint16_t reserved;                  // 0xFFFF
+    uint32_t sequence;                  // grows by one with every record written
+};
+
+// Records are appended to the erased tail of the active sector, no erase needed. Once it
+// is full the other sector, holding older records only, is erased and takes the next one,
+// so a newest whole record survives power lost at any point. A record is whole when its
+// checksum matches, a torn one ends the sector and the next save moves to the other one.
+// Journal of the EEPROM sector alone erases it when full and starts over
+// Image of previous firmware, configuration at start of EEPROM sector, loads as a record
+class ConfigurationStore {
+    private:
+    uint8_t _sectors;                   // journal sectors the flash layout leaves free
+    uint32_t _sequence;                 // newest record
+    uint32_t _newest;                   // flash address of newest record, 0 none
+    uint8_t _active;                    // sector index records are appended to
+    uint16_t _free[CONFIG_STORE_SECTORS];   // offset erased tail starts at, sector size when not clean
+
+    uint32_t sectorAddress(uint8_t index) const {
+        return (CONFIG_STORE_SECTOR - _sectors + 1 + index) * SPI_FLASH_SEC_SIZE;
+    }
+
+    static uint16_t recordLength(uint16_t size) {
+        return (sizeof(ConfigurationRecord) + size + 3) & ~3;
+    }
+
+    // Copy flash bytes of any length, chunk by chunk through aligned buffer
+    static bool read(uint32_t address, void* data, size_t size) {
+        uint32_t chunk[CONFIG_READ_CHUNK / 4];
+        for (size_t done = 0; done < size; done += sizeof(chunk)) {
+            size_t count = min(size - done, sizeof(chunk));
+            if (!ESP.flashRead(address + done, chunk, (count + 3) & ~3)) {
+                return false;
+            }
+            memcpy((uint8_t*)data + done, chunk, count);
+        }
+        return true;
+    }
+
+    // Checksum of flash bytes continued from given one, false on read error
+    static bool checksum(uint32_t address, size_t size, uint16_t& crc) {
+        uint32_t chunk[CONFIG_READ_CHUNK / 4];
+        for (size_t done = 0; done < size; done += sizeof(chunk)) {
+            size_t count = min(size - done, sizeof(chunk));
+            if (!ESP.flashRead(address + done, chunk, (count + 3) & ~3)) {
+                return false;
+            }
+            crc = Configuration::crc16((const uint8_t*)chunk, count, crc);
+        }
+        return true;
+    }
+
+    static bool isErased(uint32_t address, size_t size) {
+        uint32_t chunk[CONFIG_READ_CHUNK / 4];
+        for (size_t done = 0; done < size; done += sizeof(chunk)) {
+            size_t count = min(size - done, sizeof(chunk));
+            if (!ESP.flashRead(address + done, chunk, count)) {
+                return false;
+            }
+            for (size_t i = 0; i < count / 4; i++) {
+                if (chunk[i] != 0xFFFFFFFF) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    static uint16_t headerChecksum(const ConfigurationRecord& header) {
+        return Configuration::crc16((const uint8_t*)&header.size,
+            sizeof(ConfigurationRecord) - offsetof(ConfigurationRecord, size));
+    }
+
+    // Walk whole records of sector, keep the newest, note where its erased tail starts
+    void scan(uint8_t index) {
+        uint32_t base = sectorAddress(index);
+        uint16_t offset = 0;
+        ConfigurationRecord header;
+        while (offset + sizeof(header) <= SPI_FLASH_SEC_SIZE && read(base + offset, &header, sizeof(header))) {
+            uint16_t crc = headerChecksum(header);
+            if (header.magic != CONFIG_RECORD_MAGIC || header.size > SPI_FLASH_SEC_SIZE - offset - sizeof(header) ||
+                    !checksum(base + offset + sizeof(header), header.size, crc) || crc != header.crc16) {
+                break;
+            }
+            if (_newest == 0 || header.sequence > _sequence) {
+                _sequence = header.sequence;
+                _newest = base + offset;
+                _active = index;
+            }
+            offset += recordLength(header.size);
+        }
+        _free[index] = isErased(base + offset, SPI_FLASH_SEC_SIZE - offset) ? offset : SPI_FLASH_SEC_SIZE;
+    }
+
+    // Configuration of previous firmware kept by EEPROM class, payload size of its format
+    size_t readImage(Configuration& config) const {
+        Configuration image;
+        if (!read(sectorAddress(_sectors - 1), &image, sizeof(image))) {
+            return 0;
+        }
+        size_t size = image.stateFormat == STATE_FORMAT_NO_RULE ? offsetof(Configuration, timezoneRule) :
+            image.stateFormat == STATE_FORMAT_VERSION ? sizeof(Configuration) : 0;
+        if (size == 0 || !image.checkIntegrity(size)) {
+            return 0;
+        }
+        memcpy(&config, &image, size);
+        return size;
+    }
+
+    // Return true when newest record holds the same configuration
+    bool isNewest(const Configuration& config) const {
+        ConfigurationRecord header;
+        Configuration stored;
+        return _newest && read(_newest, &header, sizeof(header)) && header.size == sizeof(stored) &&
+            read(_newest + sizeof(header), &stored, sizeof(stored)) && memcmp(&stored, &config, sizeof(stored)) == 0;
+    }
+
+    public:
+    // Sector below EEPROM joins the journal only when given first sector past the filesystem
+    // is not above it
+    ConfigurationStore(uint32_t filesystemEnd = CONFIG_STORE_FS_END)
+            : _sectors(filesystemEnd < CONFIG_STORE_SECTOR ? CONFIG_STORE_SECTORS : 1), _sequence(0), _newest(0),
+            _active(0) {
+        memset(_free, 0, sizeof(_free));
+    }
+
+    uint8_t getSectorCount() const {
+        return _sectors;
+    }
+
+    // Load newest record or image of previous firmware migrated to the current format, or
+    // defaults when none is whole. Return true when stored configuration loaded
+    bool load(Configuration& config) {
+        _sequence = _newest = 0;
+        if (_sectors < CONFIG_STORE_SECTORS) {
+            LOG_WARN("Configuration journal in EEPROM sector only, filesystem reaches it");
+        }
+        for (uint8_t index = 0; index < _sectors; index++) {
+            scan(index);
+        }
+        if (_newest == 0) {
+            _active = _sectors - 1;     // image of previous firmware kept until a record is written
+        }
+        config.loadDefaults();
+        ConfigurationRecord header;
+        size_t size = 0;
+        if (_newest && read(_newest, &header, sizeof(header))) {
+            size = min((size_t)header.size, sizeof(Configuration));
+            if (!read(_newest + sizeof(header), &config, size)) {
+                size = 0;
+            }
+        }
+        else size = readImage(config);
+
+        uint16_t format = config.stateFormat;
+        if (size && config.migrate(size)) {
+            if (_newest == 0) {
+                LOG_INFO("Configuration loaded from EEPROM image, format %04X", format);
+            }
+            else if (format != STATE_FORMAT_VERSION) {
+                LOG_INFO("Configuration loaded, format %04X migrated", format);
+            }
+            else LOG_INFO("Configuration loaded, record %u", (unsigned)_sequence);
+            return true;
+        }
+        if (size) {
+            LOG_WARN("Configuration load failed (format %04X unknown)", format);
+        }
+        else LOG_WARN("Configuration load failed (no whole record)");
+        config.loadDefaults();
+        LOG_INFO("Loaded default configuration");
+        return false;
+    }
+
+    // Append record unless newest one holds the same configuration, erase a sector only when
+    // the active one is full. Return false on flash error, newest whole record stays
+    bool save(Configuration& config) {
+        config.stateFormat = STATE_FORMAT_VERSION;
+        config.stateCrc16 = config.calculateChecksum();
+        if (isNewest(config)) {
+            return true;
+        }
+        uint32_t record[(sizeof(ConfigurationRecord) + sizeof(Configuration) + 3) / 4];
+        memset(record, 0xFF, sizeof(record));
+        ConfigurationRecord* header = (ConfigurationRecord*)record;
+        header->magic = CONFIG_RECORD_MAGIC;
+        header->size = sizeof(Configuration);
+        header->sequence = _sequence + 1;
+        memcpy(header + 1, &config, sizeof(Configuration));
+        header->crc16 = Configuration::crc16((const uint8_t*)(header + 1), sizeof(Configuration), headerChecksum(*header));
+
+        uint8_t index = _active;
+        if (_free[index] + sizeof(record) > SPI_FLASH_SEC_SIZE) {
+            index = (_active + 1) % _sectors;
+            if (_free[index] != 0) {
+                _free[index] = SPI_FLASH_SEC_SIZE;
+                if (!ESP.flashEraseSector(sectorAddress(index) / SPI_FLASH_SEC_SIZE)) {
+                    return false;
+                }
+                _free[index] = 0;
+            }
+        }
+        uint32_t address = sectorAddress(index) + _free[index];
+        if (!ESP.flashWrite(address, record, sizeof(record))) {
+            _free[index] = SPI_FLASH_SEC_SIZE;
+            return false;
+        }
+        _free[index] += sizeof(record);
+        _active = index;
+        _newest = address;
+        _sequence++;
+        return true;
+    }
+
+    // Return sequence number of newest record, 0 none
+    uint32_t getSequence() const {
+        return _sequence;
+    }
+};
@@ -1,18 +1,85 @@
 /******************************************************************************
- * (c) Skatech Research Lab, 2000-2023.
- * Last change: 2023.01.02
+ * (c) Skatech Research Lab, 2000-2026.
+ * Last change: 2026.10.16
  * DateTime class - date time operations and formatting helper class
  *****************************************************************************/
 
 #include <Arduino.h>
 #include <time.h>
 
+#include "TimeZone.h"
+
 #pragma once
 
 #define NOT_A_TIME -1
+#define DATETIME_FORMAT_BUFFER 32   // characters of the String returned by toString()
 
 extern int settimeofday(const struct timeval* tv, const struct timezone* tz);
 
+// Broken-down local time of the last converted second. Within a window of constant
+// UTC offset, usually a whole local day, seconds are converted by arithmetic only,
+// the next second by increment with carries, zone rules are consulted on leaving window
+class CalendarCache {
+    private:
+    time_t _base, _from, _until, _last;     // local midnight, window start and end
+    struct tm _baseTime, _time;
+    int32_t _offset;
+    bool _valid;
+
+    void rebuild(time_t sec) {
+        time_t from, until;
+        bool dst;
+        _offset = TimeZone::local().getOffset(sec, &dst, &from, &until);
+        time_t local = sec + _offset;
+        gmtime_r(&local, &_time);
+        _time.tm_isdst = dst;
+        _baseTime = _time;
+        _baseTime.tm_hour = _baseTime.tm_min = _baseTime.tm_sec = 0;
+        _base = sec - (_time.tm_hour * 3600 + _time.tm_min * 60 + _time.tm_sec);
+        _from = from > _base ? from : _base;
+        _until = until && until < _base + 86400 ? until : _base + 86400;
+        _valid = true;
+    }
+
+    public:
+    CalendarCache() : _base(0), _from(0), _until(0), _last(0), _offset(0), _valid(false) {
+    }
+
+    // Forget window, required after time zone rules changed
+    void reset() {
+        _valid = false;
+    }
+
+    const struct tm& resolve(time_t sec) {
+        if (!_valid || sec < _from || sec >= _until) {
+            rebuild(sec);
+        }
+        else if (sec == _last + 1) {
+            if (++_time.tm_sec == 60) {
+                _time.tm_sec = 0;
+                if (++_time.tm_min == 60) {
+                    _time.tm_min = 0;
+                    _time.tm_hour++;
+                }
+            }
+        }
+        else if (sec != _last) {
+            uint32_t offset = sec - _base;
+            _time = _baseTime;
+            _time.tm_hour += offset / 3600;
+            _time.tm_min = offset / 60 % 60;
+            _time.tm_sec = offset % 60;
+        }
+        _last = sec;
+        return _time;
+    }
+
+    // Return UTC offset in seconds east of the last converted second
+    int32_t getOffset() const {
+        return _offset;
+    }
+};
+
 class DateTime {
     private:
     time_t _sec;
@@ -42,8 +109,15 @@ class DateTime {
         return _sec;
     }
 
-    tm* toDetails() {
-        return localtime(&_sec);
+    // Return local broken-down time, valid until next DateTime conversion
+    const tm* toDetails() const {
+        return &calendar().resolve(_sec);
+    }
+
+    // Shared conversion cache of all DateTime instances
+    static CalendarCache& calendar() {
+        static CalendarCache cache;
+        return cache;
     }
 
     /* Return custom formatted time string, options:
@@ -85,12 +159,79 @@ class DateTime {
     %Z	Timezone name or abbreviation * If timezone cannot be determined, no characters	CDT
     %%	A % sign	                                                % */
     String toString(const char* format = "%Y-%m-%d %H:%M:%S") const {
-        struct tm *t = localtime(&_sec);
-        char v[24];
-        strftime(v, sizeof(v), format, t);
+        char v[DATETIME_FORMAT_BUFFER];
+        toString(v, sizeof(v), format);
         return String(v);
     }
 
+    // Format into given buffer, options as for toString(), common ones formatted
+    // directly, others by strftime(), return formatted string length
+    size_t toString(char* buffer, size_t size, const char* format) const {
+        static const char months[] = "JanFebMarAprMayJunJulAugSepOctNovDec";
+        static const char weekdays[] = "SunMonTueWedThuFriSat";
+        if (size == 0) {
+            return 0;
+        }
+        const struct tm& t = calendar().resolve(_sec);
+        size_t length = 0;
+        for (; *format && length + 1 < size; format++) {
+            if (*format != '%' || format[1] == 0) {
+                buffer[length++] = *format;
+                continue;
+            }
+            char option = *++format;
+            int value = -1, digits = 2;
+            const char* text = NULL;
+            size_t textLength = 3;
+            char zone[6];
+            switch (option) {
+                case 'H': value = t.tm_hour; break;
+                case 'M': value = t.tm_min; break;
+                case 'S': value = t.tm_sec; break;
+                case 'd': value = t.tm_mday; break;
+                case 'm': value = t.tm_mon + 1; break;
+                case 'y': value = t.tm_year % 100; break;
+                case 'Y': value = t.tm_year + 1900; digits = 4; break;
+                case 'j': value = t.tm_yday + 1; digits = 3; break;
+                case 'b': case 'h': text = months + t.tm_mon * 3; break;
+                case 'a': text = weekdays + t.tm_wday * 3; break;
+                case '%': text = "%"; textLength = 1; break;
+                case 'Z': text = TimeZone::local().getName(t.tm_isdst > 0); textLength = strlen(text); break;
+                case 'z': text = zoneOffset(zone, calendar().getOffset()); textLength = 5; break;
+                case 'T': length += toString(buffer + length, size - length, "%H:%M:%S"); continue;
+                case 'R': length += toString(buffer + length, size - length, "%H:%M"); continue;
+                case 'F': length += toString(buffer + length, size - length, "%Y-%m-%d"); continue;
+            }
+            if (value >= 0 && value < 10000) {
+                for (int i = digits - 1; i >= 0; i--, value /= 10) {
+                    if (length + i + 1 < size) {
+                        buffer[length + i] = '0' + value % 10;
+                    }
+                }
+                length = min(length + digits, size - 1);
+            }
+            else if (text) {
+                for (size_t i = 0; i < textLength && length + 1 < size; i++) {
+                    buffer[length++] = text[i];
+                }
+            }
+            else {
+                char spec[3] = { '%', option, 0 };
+                length += strftime(buffer + length, size - length, spec, &t);
+            }
+        }
+        buffer[length] = 0;
+        return length;
+    }
+
+    // Write ISO 8601 offset "+hhmm" into given buffer of 6 characters
+    static const char* zoneOffset(char* buffer, int32_t offset) {
+        uint32_t minutes = abs(offset) / 60;
+        snprintf(buffer, 6, "%c%02u%02u", offset < 0 ? '-' : '+',
+            (unsigned)(minutes / 60 % 100), (unsigned)(minutes % 60));
+        return buffer;
+    }
+
     // Return ISO format date-time string "YYYYMMDDTHHMMSSZ"
     String toISOString() {
         return toString("%Y%m%dT%H%M%SZ");
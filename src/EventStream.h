@@ -0,0 +1,157 @@
+/******************************************************************************
+ * (c) Skatech Research Lab, 2000-2026.
+ * Last change: 2026.10.16
+ * EventStream class - Server-Sent Events channel, few subscribers kept open
+ * with bounded send buffers, events written as the connections accept them
+ *****************************************************************************/
+
+#pragma once
+
+#include <Arduino.h>
+#include <ESP8266WiFi.h>
+
+#define EVENT_MAX_SUBSCRIBERS 4
+#define EVENT_CLIENT_BUFFER 768         // bytes queued per subscriber, overflowing one is dropped
+#define EVENT_KEEPALIVE 15000           // ms of silence before a comment line checks connection
+#define EVENT_RETRY 3000                // ms browser waits before it reconnects
+
+struct EventSubscriber {
+    WiFiClient client;
+    char buffer[EVENT_CLIENT_BUFFER];
+    uint16_t length;
+    uint32_t writtenAt;                 // millis() of the last write
+    bool active;
+};
+
+// Subscriber taking events slower than they come would hold memory and the loop,
+// so once its buffer overflows it is dropped, the browser reconnects by itself and
+// gets full state again. Writes never wait, only bytes the connection accepts are sent
+class EventStream {
+    private:
+    EventSubscriber _subscribers[EVENT_MAX_SUBSCRIBERS];
+    uint32_t _published, _dropped, _bytes;
+
+    void drop(EventSubscriber& subscriber) {
+        subscriber.client.stop();
+        subscriber.client = WiFiClient();
+        subscriber.active = false;
+        subscriber.length = 0;
+    }
+
+    bool append(EventSubscriber& subscriber, const char* text, size_t length) {
+        if (subscriber.length + length > sizeof(subscriber.buffer)) {
+            return false;
+        }
+        memcpy(subscriber.buffer + subscriber.length, text, length);
+        subscriber.length += length;
+        return true;
+    }
+
+    public:
+    EventStream() : _subscribers(), _published(0), _dropped(0), _bytes(0) {
+    }
+
+    // Take connection of the current request, send stream headers, return subscriber
+    // index or -1 when all are taken
+    int8_t subscribe(WiFiClient client) {
+        for (int8_t i = 0; i < EVENT_MAX_SUBSCRIBERS; i++) {
+            EventSubscriber& subscriber = _subscribers[i];
+            if (subscriber.active && subscriber.client.connected()) {
+                continue;
+            }
+            subscriber.client = client;
+            subscriber.client.setNoDelay(true);
+            subscriber.active = true;
+            subscriber.length = 0;
+            subscriber.writtenAt = millis();
+            char header[160];
+            size_t length = snprintf(header, sizeof(header), "HTTP/1.1 200 OK\r\nContent-Type: text/event-stream\r\n"
+                "Cache-Control: no-cache\r\nConnection: keep-alive\r\n\r\nretry: %u\n\n", EVENT_RETRY);
+            append(subscriber, header, length);
+            return i;
+        }
+        return -1;
+    }
+
+    // Queue event for given subscriber, data must be a single line, return false when
+    // subscriber dropped
+    bool send(int8_t index, const char* event, const char* data) {
+        EventSubscriber& subscriber = _subscribers[index];
+        if (!subscriber.active) {
+            return false;
+        }
+        char head[32];
+        size_t length = snprintf(head, sizeof(head), "event: %s\ndata: ", event);
+        size_t size = strlen(data);
+        if (subscriber.length + length + size + 2 > sizeof(subscriber.buffer)) {
+            _dropped++;
+            drop(subscriber);
+            return false;
+        }
+        append(subscriber, head, length);
+        append(subscriber, data, size);
+        append(subscriber, "\n\n", 2);
+        return true;
+    }
+
+    // Queue event for every subscriber, return count it was queued for
+    uint8_t publish(const char* event, const char* data) {
+        uint8_t count = 0;
+        for (int8_t i = 0; i < EVENT_MAX_SUBSCRIBERS; i++) {
+            count += send(i, event, data);
+        }
+        _published++;
+        return count;
+    }
+
+    // Write queued bytes the connections accept, drop closed ones, call often
+    void flush() {
+        uint32_t ms = millis();
+        for (EventSubscriber& subscriber : _subscribers) {
+            if (!subscriber.active) {
+                continue;
+            }
+            if (!subscriber.client.connected()) {
+                drop(subscriber);
+                continue;
+            }
+            if (subscriber.length == 0 && ms - subscriber.writtenAt >= EVENT_KEEPALIVE) {
+                append(subscriber, ":\n\n", 3);
+            }
+            size_t count = min((size_t)subscriber.length, (size_t)subscriber.client.availableForWrite());
+            if (count == 0) {
+                continue;
+            }
+            count = subscriber.client.write((const uint8_t*)subscriber.buffer, count);
+            memmove(subscriber.buffer, subscriber.buffer + count, subscriber.length - count);
+            subscriber.length -= count;
+            subscriber.writtenAt = ms;
+            _bytes += count;
+        }
+    }
+
+    uint8_t getSubscriberCount() const {
+        uint8_t count = 0;
+        for (const EventSubscriber& subscriber : _subscribers) {
+            count += subscriber.active;
+        }
+        return count;
+    }
+
+    // Write statistics as JSON object into given buffer, return its length
+    size_t toJSON(char* buffer, size_t size) const {
+        size_t length = snprintf(buffer, size, "{\"subscribers\":%u, \"published\":%u, \"dropped\":%u, \"bytes\":%u, "
+            "\"queued\":[", getSubscriberCount(), (unsigned)_published, (unsigned)_dropped, (unsigned)_bytes);
+        bool first = true;
+        for (const EventSubscriber& subscriber : _subscribers) {
+            if (subscriber.active && length < size) {
+                length += snprintf(buffer + length, size - length, "%s%u", first ? "" : ", ", subscriber.length);
+                first = false;
+            }
+        }
+        if (length < size) {
+            length += snprintf(buffer + length, size - length, "]}");
+        }
+        return min(length, size - 1);
+    }
+};
@@ -0,0 +1,125 @@
+/******************************************************************************
+ * (c) Skatech Research Lab, 2000-2026.
+ * Last change: 2026.10.17
+ * ForecastFormat class - forecast format string compiled into a token program,
+ * rendered in a single pass without heap allocations
+ *****************************************************************************/
+
+#pragma once
+
+#include <Arduino.h>
+
+#define FORECAST_FORMAT_TOKENS 24       // tokens of the program, rest of longer format is dropped
+#define FORECAST_FORMAT_FIELDS "mwWtsSdeE"
+
+#define FORECAST_FORMAT_TEXT "%W, %t'C, wind %E %sm/s"
+#define FORECAST_FORMAT_JSON "{\"timeStamp\":%m, \"weatherCode\":%w, \"weatherDescription\":\"%W\", " \
+    "\"temperatureCelsius\":%t, \"windSpeed\":%s, \"windDirection\":%d, \"windDirectionSide\":\"%E\", " \
+    "\"windDirectionSideShort\":\"%e\"}"
+
+class ForecastFormatToken {
+    public:
+    uint16_t start = 0;                 // literal start in the format string
+    uint8_t length = 0;                 // literal length, 0 for field
+    char field = 0;                     // field option character, 0 for literal
+};
+
+// Format is split into literal runs and field references once, built-in formats at
+// compile time, format string must outlive the program as literals are not copied
+class ForecastFormat {
+    private:
+    const char* _format;
+    uint8_t _count;
+    ForecastFormatToken _tokens[FORECAST_FORMAT_TOKENS];
+
+    static constexpr bool isField(char c, const char* fields = FORECAST_FORMAT_FIELDS) {
+        return *fields && (*fields == c || isField(c, fields + 1));
+    }
+
+    constexpr void literal(uint16_t start, uint16_t end) {
+        while (start < end && _count < FORECAST_FORMAT_TOKENS) {
+            uint8_t length = end - start > 255 ? 255 : end - start;
+            _tokens[_count++] = { start, length, 0 };
+            start += length;
+        }
+    }
+
+    public:
+    constexpr ForecastFormat(const char* format) : _format(format), _count(0), _tokens() {
+        uint16_t start = 0, i = 0;
+        for (; format[i] && _count < FORECAST_FORMAT_TOKENS; i++) {
+            if (format[i] == '%' && isField(format[i + 1])) {
+                literal(start, i);
+                if (_count < FORECAST_FORMAT_TOKENS) {
+                    _tokens[_count++] = { i, 0, format[i + 1] };
+                }
+                start = ++i + 1;
+            }
+        }
+        literal(start, i);
+    }
+
+    uint8_t getCount() const {
+        return _count;
+    }
+
+    const ForecastFormatToken& getToken(uint8_t index) const {
+        return _tokens[index];
+    }
+
+    const char* getLiteral(const ForecastFormatToken& token) const {
+        return _format + token.start;
+    }
+
+    // Default text format of the display line and the log
+    static const ForecastFormat& text() {
+        static constexpr ForecastFormat format(FORECAST_FORMAT_TEXT);
+        return format;
+    }
+
+    // Format of the web UI forecast state
+    static const ForecastFormat& json() {
+        static constexpr ForecastFormat format(FORECAST_FORMAT_JSON);
+        return format;
+    }
+};
+
+// Print sink into caller supplied buffer, output beyond its size is dropped and
+// told by isTruncated(), buffer always holds terminated string
+class BufferPrint : public Print {
+    private:
+    char* _buffer;
+    size_t _size, _length;
+    bool _truncated;
+
+    public:
+    BufferPrint(char* buffer, size_t size) : _buffer(buffer), _size(size), _length(0), _truncated(false) {
+        if (_size) {
+            _buffer[0] = 0;
+        }
+    }
+
+    size_t write(uint8_t c) override {
+        return write(&c, 1);
+    }
+
+    size_t write(const uint8_t* data, size_t size) override {
+        size_t count = _length + 1 < _size ? min(size, _size - _length - 1) : 0;
+        memcpy(_buffer + _length, data, count);
+        _length += count;
+        _truncated = _truncated || count < size;
+        if (_size) {
+            _buffer[_length] = 0;
+        }
+        return count;
+    }
+    using Print::write;
+
+    size_t length() const {
+        return _length;
+    }
+
+    bool isTruncated() const {
+        return _truncated;
+    }
+};
@@ -0,0 +1,162 @@
+/******************************************************************************
+ * (c) Skatech Research Lab, 2000-2026.
+ * Last change: 2026.10.16
+ * ForecastSeries class - hourly forecast ahead kept in a ring of packed records
+ *****************************************************************************/
+
+#pragma once
+
+#include <Arduino.h>
+
+#define FORECAST_SERIES_HOURS 48        // hours ahead kept, ring capacity
+
+#define FORECAST_SERIES_TEMPERATURE 0x01
+#define FORECAST_SERIES_WINDSPEED   0x02
+#define FORECAST_SERIES_WINDDIR     0x04
+#define FORECAST_SERIES_WEATHERCODE 0x08
+#define FORECAST_SERIES_TIME        0x10
+#define FORECAST_SERIES_ALL         0x1F
+
+#define FORECAST_HOUR_EMPTY 0xFF        // weather code of the slot without data
+
+// Forecast of the single hour, 6 bytes
+class ForecastHour {
+    private:
+    int16_t _temperature;               // 0.1 Celsius
+    uint8_t _windspeed;                 // 0.5 km/h, up to 127.5
+    uint8_t _winddir;                   // 360/256 degrees
+    uint8_t _weathercode;
+    uint8_t _hour;                      // low byte of hours since epoch, tells stale slot
+    friend class ForecastSeries;
+
+    public:
+    float getTemperature() const {
+        return _temperature / 10.0F;
+    }
+
+    float getWindSpeed() const {
+        return _windspeed / 2.0F;
+    }
+
+    float getWindDirection() const {
+        return _winddir * 360.0F / 256.0F;
+    }
+
+    u8 getWeatherCode() const {
+        return _weathercode;
+    }
+};
+
+// Slot of the hour is its number since epoch modulo capacity, so lookup is a single
+// index, ring advances with time without moving records
+class ForecastSeries {
+    private:
+    ForecastHour _hours[FORECAST_SERIES_HOURS];
+    uint32_t _first;                    // first hour of the last complete fill, hours since epoch
+    uint32_t _base, _fillFirst;         // series start and first stored hour of the fill in progress
+    uint8_t _fields;
+    bool _valid;
+
+    ForecastHour* slot(uint32_t hour) {
+        ForecastHour& record = _hours[hour % FORECAST_SERIES_HOURS];
+        if (record._hour != (uint8_t)hour) {
+            record._temperature = 0;
+            record._windspeed = record._winddir = 0;
+            record._weathercode = FORECAST_HOUR_EMPTY;
+            record._hour = (uint8_t)hour;
+        }
+        return &record;
+    }
+
+    static uint8_t quantize(float value, float scale) {
+        return (uint8_t)constrain(lroundf(value * scale), 0L, 255L);
+    }
+
+    public:
+    ForecastSeries() : _first(0), _base(0), _fillFirst(0), _fields(0), _valid(false) {
+        clear();
+    }
+
+    void clear() {
+        for (ForecastHour& record : _hours) {
+            record._weathercode = FORECAST_HOUR_EMPTY;
+            record._hour = 0;
+        }
+        _first = 0;
+    }
+
+    // Return forecast for the hour containing given time, or NULL when not known
+    const ForecastHour* at(time_t time) const {
+        uint32_t hour = time / 3600;
+        if (_first == 0 || hour < _first || hour >= _first + FORECAST_SERIES_HOURS) {
+            return NULL;
+        }
+        const ForecastHour& record = _hours[hour % FORECAST_SERIES_HOURS];
+        return record._hour == (uint8_t)hour && record._weathercode != FORECAST_HOUR_EMPTY ? &record : NULL;
+    }
+
+    // Return number of hours known ahead starting from the hour containing given time
+    uint8_t hoursAhead(time_t time) const {
+        uint8_t count = 0;
+        while (count < FORECAST_SERIES_HOURS && at(time + count * 3600UL)) {
+            count++;
+        }
+        return count;
+    }
+
+    // Start fill from response requested at given time, records before current hour skipped
+    void begin(time_t now) {
+        _fillFirst = now / 3600;
+        _base = now / 86400 * 24;
+        _fields = 0;
+        _valid = true;
+    }
+
+    // Take value of hourly array at given index, arrays may come in any order
+    void set(const char* key, int16_t index, const char* value) {
+        if (!_valid || index < 0) {
+            return;
+        }
+        uint32_t hour = _base + index;
+        if (strcmp(key, "time") == 0) {
+            _fields |= FORECAST_SERIES_TIME;
+            _valid = (uint32_t)(atol(value) / 3600) == hour;
+            return;
+        }
+        if (hour < _fillFirst || hour >= _fillFirst + FORECAST_SERIES_HOURS) {
+            return;
+        }
+        if (strcmp(key, "temperature_2m") == 0) {
+            slot(hour)->_temperature = (int16_t)constrain(lroundf(atof(value) * 10), -32767L, 32767L);
+            _fields |= FORECAST_SERIES_TEMPERATURE;
+        }
+        else if (strcmp(key, "windspeed_10m") == 0) {
+            slot(hour)->_windspeed = quantize(atof(value), 2.0F);
+            _fields |= FORECAST_SERIES_WINDSPEED;
+        }
+        else if (strcmp(key, "winddirection_10m") == 0) {
+            slot(hour)->_winddir = (uint8_t)(lroundf(atof(value) * 256.0F / 360.0F) & 0xFF);
+            _fields |= FORECAST_SERIES_WINDDIR;
+        }
+        else if (strcmp(key, "weathercode") == 0) {
+            slot(hour)->_weathercode = (uint8_t)atoi(value);
+            _fields |= FORECAST_SERIES_WEATHERCODE;
+        }
+    }
+
+    // Complete fill, return true when all arrays received and times match the request,
+    // otherwise previous range is kept, written records are forecasts of their hours anyway
+    bool end() {
+        if (_valid && _fields == FORECAST_SERIES_ALL) {
+            _first = _fillFirst;
+            return true;
+        }
+        return false;
+    }
+
+    // Return query parameters requesting series filled by this class, series start at
+    // midnight UTC, so three days cover capacity from any hour of the day
+    static const char* getRequestParameters() {
+        return "&hourly=temperature_2m,weathercode,windspeed_10m,winddirection_10m&timeformat=unixtime&forecast_days=3";
+    }
+};
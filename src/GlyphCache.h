@@ -0,0 +1,139 @@
+/******************************************************************************
+ * (c) Skatech Research Lab, 2000-2026.
+ * Last change: 2026.10.17
+ * GlyphCache class - pre-rendered font glyphs blitted into U8g2 frame buffer
+ *****************************************************************************/
+
+#pragma once
+
+#include <Arduino.h>
+#include <U8g2lib.h>
+
+#define GLYPH_CACHE_CAPACITY 12
+
+// Glyph bitmaps are kept in the SSD1306 page layout (one byte = 8 vertical pixels),
+// so drawing at tile row aligned position is a byte OR per glyph column and page
+class GlyphCache {
+    private:
+    char _chars[GLYPH_CACHE_CAPACITY + 1];
+    uint8_t _advance[GLYPH_CACHE_CAPACITY];
+    uint8_t _width[GLYPH_CACHE_CAPACITY];
+    uint16_t _offset[GLYPH_CACHE_CAPACITY];
+    uint8_t _pages;
+    uint8_t* _bitmaps;
+
+    int8_t indexOf(char c) const {
+        const char* found = c ? strchr(_chars, c) : NULL;
+        return found ? found - _chars : -1;
+    }
+
+    // Return width of glyph ink in the frame buffer, rendered at left edge
+    static uint8_t measureInk(U8G2& u8g2, uint8_t pages) {
+        const uint8_t* buffer = u8g2.getBufferPtr();
+        uint16_t stride = u8g2.getBufferTileWidth() * 8;
+        for (uint16_t x = stride; x > 0; x--) {
+            for (uint8_t page = 0; page < pages; page++) {
+                if (buffer[page * stride + x - 1]) {
+                    return x;
+                }
+            }
+        }
+        return 0;
+    }
+
+    // Render glyph at left edge, buffer tile rows at a time for a page buffer. Ink width is
+    // measured, or given target, glyph pages of known width copied into it. Return advance
+    uint8_t renderGlyph(U8G2& u8g2, char c, uint8_t* width, uint8_t* target) const {
+        char glyph[2] = { c, 0 };
+        uint16_t stride = u8g2.getBufferTileWidth() * 8;
+        uint8_t rows = u8g2.getBufferTileHeight(), advance = 0;
+        for (uint8_t row = 0; row < _pages; row += rows) {
+            uint8_t pages = min((int)rows, _pages - row);
+            u8g2.setBufferCurrTileRow(row);
+            u8g2.clearBuffer();
+            advance = u8g2.drawStr(0, 0, glyph);
+            if (target == NULL) {
+                *width = max(*width, measureInk(u8g2, pages));
+                continue;
+            }
+            for (uint8_t page = 0; page < pages; page++) {
+                memcpy(target + (row + page) * *width, u8g2.getBufferPtr() + page * stride, *width);
+            }
+        }
+        u8g2.setBufferCurrTileRow(0);
+        return advance;
+    }
+
+    public:
+    GlyphCache() : _pages(0), _bitmaps(NULL) {
+        _chars[0] = 0;
+    }
+
+    ~GlyphCache() {
+        delete[] _bitmaps;
+    }
+
+    bool isReady() const {
+        return _bitmaps != NULL;
+    }
+
+    // Render given characters of the font once, frame buffer is used and left cleared
+    bool build(U8G2& u8g2, const uint8_t* font, const char* chars) {
+        size_t count = strlen(chars);
+        if (count > GLYPH_CACHE_CAPACITY) {
+            return false;
+        }
+
+        u8g2.setFont(font);
+        u8g2.setFontRefHeightExtendedText();
+        u8g2.setDrawColor(1);
+        u8g2.setFontPosTop();
+        u8g2.setFontDirection(0);
+        _pages = min((u8g2.getMaxCharHeight() + 7) / 8, u8g2.getDisplayHeight() / 8);
+
+        uint16_t size = 0;
+        for (size_t i = 0; i < count; i++) {
+            _width[i] = 0;
+            _advance[i] = renderGlyph(u8g2, chars[i], &_width[i], NULL);
+            _offset[i] = size;
+            size += _width[i] * _pages;
+        }
+
+        delete[] _bitmaps;
+        _bitmaps = new uint8_t[size ? size : 1];
+        for (size_t i = 0; i < count; i++) {
+            renderGlyph(u8g2, chars[i], &_width[i], _bitmaps + _offset[i]);
+        }
+        u8g2.clearBuffer();
+
+        memcpy(_chars, chars, count + 1);
+        return true;
+    }
+
+    // Draw string of cached glyphs at x and tile row, unknown characters skipped, return width.
+    // Only glyph pages within buffer tile rows are drawn, a page buffer gets its share
+    uint16_t drawStr(U8G2& u8g2, uint8_t x, uint8_t tileRow, const char* s) const {
+        uint8_t* buffer = u8g2.getBufferPtr();
+        uint16_t stride = u8g2.getBufferTileWidth() * 8;
+        uint8_t first = u8g2.getBufferCurrTileRow();
+        uint8_t from = max(0, first - tileRow);
+        uint8_t pages = max(0, min((int)_pages, first + u8g2.getBufferTileHeight() - tileRow));
+        uint16_t left = x, right = x;
+        for (; *s && right < stride; s++) {
+            int8_t i = indexOf(*s);
+            if (i < 0) {
+                continue;
+            }
+            uint8_t width = min((int)_width[i], stride - right);
+            for (uint8_t page = from; page < pages; page++) {
+                const uint8_t* source = _bitmaps + _offset[i] + page * _width[i];
+                uint8_t* target = buffer + (tileRow + page - first) * stride + right;
+                for (uint8_t column = 0; column < width; column++) {
+                    target[column] |= source[column];
+                }
+            }
+            right += _advance[i];
+        }
+        return right - left;
+    }
+};
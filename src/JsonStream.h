@@ -0,0 +1,289 @@
+/******************************************************************************
+ * (c) Skatech Research Lab, 2000-2026.
+ * Last change: 2026.10.16
+ * JsonStreamParser class - incremental fixed-memory JSON reader, reports every
+ * scalar value with its key path while data arrives in chunks of any size
+ *****************************************************************************/
+
+#pragma once
+
+#include <Arduino.h>
+
+#define JSON_MAX_DEPTH 6        // nesting levels tracked, deeper values are skipped
+#define JSON_MAX_NESTING 32     // nesting levels accepted, deeper documents fail
+#define JSON_MAX_KEY 24         // longer keys are truncated
+#define JSON_MAX_VALUE 32       // longer string values are truncated
+
+// Location of the value in the document, keys of enclosing objects and indexes in arrays
+class JsonPath {
+    public:
+    uint8_t depth;
+    char keys[JSON_MAX_DEPTH][JSON_MAX_KEY];
+    int16_t indexes[JSON_MAX_DEPTH];    // -1 for object levels
+
+    // Return key of the value at given level from the end, 0 - value own key
+    const char* key(uint8_t level = 0) const {
+        return depth > level ? keys[depth - 1 - level] : "";
+    }
+
+    // Return index of the value in enclosing array, or -1 when enclosed by object
+    int16_t index() const {
+        return depth > 0 ? indexes[depth - 1] : -1;
+    }
+
+    // Return true when path keys equal given ones from the root, empty key for array levels
+    bool is(const char* key1, const char* key2 = NULL, const char* key3 = NULL) const {
+        const char* expected[3] = { key1, key2, key3 };
+        uint8_t count = key3 ? 3 : key2 ? 2 : 1;
+        if (depth != count) {
+            return false;
+        }
+        for (uint8_t i = 0; i < count; i++) {
+            if (indexes[i] < 0 ? strcmp(keys[i], expected[i]) != 0 : expected[i][0] != 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+class JsonListener {
+    public:
+    // Called for every string, number, boolean and null value, strings unescaped
+    virtual void onJsonValue(const JsonPath& path, const char* value, bool string) = 0;
+};
+
+class JsonStreamParser {
+    private:
+    enum State : uint8_t {
+        VALUE, ARRAY_VALUE_OR_END, KEY, KEY_OR_END, COLON, COMMA_OR_END,
+        STRING, STRING_ESCAPE, STRING_UNICODE, LITERAL, DONE, FAILED
+    };
+
+    JsonListener* _listener;
+    JsonPath _path;
+    uint8_t _depth;                     // may exceed tracked path depth
+    uint32_t _objects;                  // object (1) or array (0) bit per nesting level
+    State _state;
+    bool _key;
+    uint8_t _length, _unicode;
+    char _token[JSON_MAX_VALUE];
+
+    bool isObject() const {
+        return _objects & (1UL << (_depth - 1));
+    }
+
+    bool tracked() const {
+        return _depth <= JSON_MAX_DEPTH;
+    }
+
+    void push(bool object) {
+        _depth++;
+        uint8_t level = _depth - 1;
+        if (object) {
+            _objects |= 1UL << level;
+        }
+        else _objects &= ~(1UL << level);
+        if (tracked()) {
+            _path.depth = _depth;
+            _path.keys[level][0] = 0;
+            _path.indexes[level] = object ? -1 : 0;
+        }
+        _state = object ? KEY_OR_END : ARRAY_VALUE_OR_END;
+    }
+
+    bool pop(bool object) {
+        if (_depth == 0 || isObject() != object) {
+            return false;
+        }
+        _depth--;
+        _path.depth = min(_depth, (uint8_t)JSON_MAX_DEPTH);
+        _state = _depth ? COMMA_OR_END : DONE;
+        return true;
+    }
+
+    void append(char c) {
+        if (_length < sizeof(_token) - 1) {
+            _token[_length++] = c;
+        }
+    }
+
+    void emit(bool string) {
+        _token[_length] = 0;
+        if (tracked() && _listener) {
+            _listener->onJsonValue(_path, _token, string);
+        }
+        _state = _depth ? COMMA_OR_END : DONE;
+    }
+
+    void endString() {
+        if (_key) {
+            _token[min(_length, (uint8_t)(JSON_MAX_KEY - 1))] = 0;
+            if (tracked()) {
+                strcpy(_path.keys[_depth - 1], _token);
+            }
+            _state = COLON;
+        }
+        else emit(true);
+    }
+
+    static bool isSpace(char c) {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+    }
+
+    bool value(char c) {
+        if (c == '{' || c == '[') {
+            if (_depth == JSON_MAX_NESTING) {
+                return false;
+            }
+            push(c == '{');
+        }
+        else if (c == '"') {
+            _key = false; _length = 0; _state = STRING;
+        }
+        else if (c == '-' || (c >= '0' && c <= '9') || c == 't' || c == 'f' || c == 'n') {
+            _length = 0; append(c); _state = LITERAL;
+        }
+        else return isSpace(c);
+        return true;
+    }
+
+    bool next(char c) {
+        switch (_state) {
+            case VALUE:
+                return value(c);
+            case ARRAY_VALUE_OR_END:
+                return c == ']' ? pop(false) : value(c);
+            case KEY_OR_END:
+                if (c == '}') {
+                    return pop(true);
+                }
+                // fall through
+            case KEY:
+                if (c == '"') {
+                    _key = true; _length = 0; _state = STRING;
+                    return true;
+                }
+                return isSpace(c);
+            case COLON:
+                if (c == ':') {
+                    _state = VALUE;
+                    return true;
+                }
+                return isSpace(c);
+            case COMMA_OR_END:
+                if (c == ',') {
+                    if (isObject()) {
+                        _state = KEY;
+                    }
+                    else {
+                        if (tracked()) {
+                            _path.indexes[_depth - 1]++;
+                        }
+                        _state = VALUE;
+                    }
+                    return true;
+                }
+                if (c == '}' || c == ']') {
+                    return pop(c == '}');
+                }
+                return isSpace(c);
+            case STRING:
+                if (c == '"') {
+                    endString();
+                }
+                else if (c == '\\') {
+                    _state = STRING_ESCAPE;
+                }
+                else append(c);
+                return true;
+            case STRING_ESCAPE:
+                switch (c) {
+                    case 'b': append('\b'); break;
+                    case 'f': append('\f'); break;
+                    case 'n': append('\n'); break;
+                    case 'r': append('\r'); break;
+                    case 't': append('\t'); break;
+                    case 'u': _unicode = 4; _state = STRING_UNICODE; return true;
+                    default: append(c);
+                }
+                _state = STRING;
+                return true;
+            case STRING_UNICODE:
+                if (--_unicode == 0) {
+                    append('?'); // non-ASCII characters are not rendered by display fonts
+                    _state = STRING;
+                }
+                return (c >= '0' && c <= '9') || ((c | 0x20) >= 'a' && (c | 0x20) <= 'f');
+            case LITERAL:
+                if (c == ',' || c == '}' || c == ']' || isSpace(c)) {
+                    emit(false);
+                    return next(c);
+                }
+                append(c);
+                return true;
+            case DONE:
+                return isSpace(c);
+            default:
+                return false;
+        }
+    }
+
+    public:
+    JsonStreamParser(JsonListener* listener = NULL) : _listener(listener) {
+        reset();
+    }
+
+    void reset() {
+        _path.depth = 0;
+        _depth = 0;
+        _state = VALUE;
+        _key = false;
+        _length = 0;
+        _objects = 0;
+    }
+
+    void setListener(JsonListener* listener) {
+        _listener = listener;
+    }
+
+    // Feed next part of the document, return false once document found malformed
+    bool feed(const char* data, size_t size) {
+        while (size-- && _state != FAILED) {
+            if (!next(*data++)) {
+                _state = FAILED;
+            }
+        }
+        return _state != FAILED;
+    }
+
+    // Feed all available data of the stream in chunks of the parser own buffer size
+    bool feed(Stream& stream) {
+        char chunk[64];
+        int available;
+        while ((available = stream.available()) > 0) {
+            size_t count = stream.readBytes(chunk, min((size_t)available, sizeof(chunk)));
+            if (count == 0 || !feed(chunk, count)) {
+                break;
+            }
+        }
+        return _state != FAILED;
+    }
+
+    // Return true when complete top level value parsed, numbers at the end need finish()
+    bool isComplete() const {
+        return _state == DONE;
+    }
+
+    // Signal end of data, completes top level literal value, return true when document valid
+    bool finish() {
+        if (_state == LITERAL && _depth == 0) {
+            emit(false);
+        }
+        return _state == DONE;
+    }
+
+    bool isFailed() const {
+        return _state == FAILED;
+    }
+};
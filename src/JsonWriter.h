@@ -0,0 +1,181 @@
+/******************************************************************************
+ * (c) Skatech Research Lab, 2000-2026.
+ * Last change: 2026.10.16
+ * JsonWriter class - streaming JSON serializer into any Print, separators and
+ * string escaping kept by the writer, no document built in memory
+ *****************************************************************************/
+
+#pragma once
+
+#include <Arduino.h>
+
+#define JSON_WRITER_DEPTH 16            // nesting levels, deeper containers are not tracked
+
+// Values follow keys inside objects and each other inside arrays, separators are
+// written when needed, so members are added by single calls in any order
+class JsonWriter {
+    private:
+    Print& _out;
+    uint16_t _filled;                   // bit per nesting level, container has items
+    uint8_t _depth;
+    bool _keyed;                        // key written, value expected
+
+    void separate() {
+        if (_keyed) {
+            _keyed = false;
+            return;
+        }
+        if (_depth > 0 && _depth <= JSON_WRITER_DEPTH) {
+            uint16_t bit = 1 << (_depth - 1);
+            if (_filled & bit) {
+                _out.write(',');
+            }
+            _filled |= bit;
+        }
+    }
+
+    void open(char bracket) {
+        separate();
+        _out.write(bracket);
+        _depth++;
+        if (_depth <= JSON_WRITER_DEPTH) {
+            _filled &= ~(1 << (_depth - 1));
+        }
+    }
+
+    void close(char bracket) {
+        _out.write(bracket);
+        _depth--;
+    }
+
+    void quoted(const char* text) {
+        static const char hex[] = "0123456789abcdef";
+        _out.write('"');
+        const char* run = text;
+        for (; *text; text++) {
+            uint8_t c = *text;
+            if (c >= 0x20 && c != '"' && c != '\\') {
+                continue;
+            }
+            _out.write(run, text - run);
+            run = text + 1;
+            char escape[6] = { '\\', (char)c, 0 };
+            size_t length = 2;
+            switch (c) {
+                case '\n': escape[1] = 'n'; break;
+                case '\r': escape[1] = 'r'; break;
+                case '\t': escape[1] = 't'; break;
+                case '"': case '\\': break;
+                default:
+                    escape[1] = 'u';
+                    _out.write(escape, 2);
+                    escape[0] = escape[1] = '0';
+                    escape[2] = hex[c >> 4];
+                    escape[3] = hex[c & 15];
+                    length = 4;
+            }
+            _out.write(escape, length);
+        }
+        _out.write(run, text - run);
+        _out.write('"');
+    }
+
+    public:
+    JsonWriter(Print& out) : _out(out), _filled(0), _depth(0), _keyed(false) {
+    }
+
+    JsonWriter& beginObject() {
+        open('{');
+        return *this;
+    }
+
+    JsonWriter& endObject() {
+        close('}');
+        return *this;
+    }
+
+    JsonWriter& beginArray() {
+        open('[');
+        return *this;
+    }
+
+    JsonWriter& endArray() {
+        close(']');
+        return *this;
+    }
+
+    JsonWriter& key(const char* name) {
+        separate();
+        quoted(name);
+        _out.write(':');
+        _keyed = true;
+        return *this;
+    }
+
+    JsonWriter& value(const char* text) {
+        separate();
+        if (text) {
+            quoted(text);
+        }
+        else _out.write("null");
+        return *this;
+    }
+
+    JsonWriter& value(bool flag) {
+        separate();
+        _out.write(flag ? "true" : "false");
+        return *this;
+    }
+
+    JsonWriter& value(int32_t number) {
+        separate();
+        _out.print((long)number);
+        return *this;
+    }
+
+    JsonWriter& value(uint32_t number) {
+        separate();
+        _out.print((unsigned long)number);
+        return *this;
+    }
+
+    // Write fixed point number of given value divided by divisor, like 5.5 for 330 / 60
+    JsonWriter& value(int32_t number, uint16_t divisor) {
+        separate();
+        if (number < 0) {
+            _out.write('-');
+        }
+        uint32_t magnitude = abs(number);
+        _out.print((unsigned long)(magnitude / divisor));
+        uint32_t fraction = magnitude % divisor;
+        if (fraction) {
+            _out.write('.');
+            for (uint8_t digits = 0; fraction && digits < 6; digits++) {
+                fraction *= 10;
+                _out.write((char)('0' + fraction / divisor));
+                fraction %= divisor;
+            }
+        }
+        return *this;
+    }
+
+    JsonWriter& null() {
+        separate();
+        _out.write("null");
+        return *this;
+    }
+
+    // Return output for a complete JSON value printed by caller, like Forecast::printTo()
+    Print& raw() {
+        separate();
+        return _out;
+    }
+
+    template<typename T> JsonWriter& member(const char* name, T data) {
+        return key(name).value(data);
+    }
+
+    bool isComplete() const {
+        return _depth == 0 && !_keyed;
+    }
+};
@@ -0,0 +1,110 @@
+/******************************************************************************
+ * (c) Skatech Research Lab, 2000-2026.
+ * Last change: 2026.10.17
+ * LatencyHistogram class - log2 histogram of signed latencies in microseconds
+ *****************************************************************************/
+
+#pragma once
+
+#include <Arduino.h>
+
+#define HISTOGRAM_BINS 14               // early, below 256 us, doubling up to 0.5 s, above
+#define HISTOGRAM_FIRST_BOUND 256       // us, upper bound of the first non negative bin
+
+// Bin 0 counts negative latencies (early), bin 1 below 256 us, each next bin doubles
+// the bound, the last one counts everything above. Percentiles are bin upper bounds
+class LatencyHistogram {
+    private:
+    uint32_t _bins[HISTOGRAM_BINS];
+    uint32_t _count;
+    int64_t _sum;
+    int32_t _min, _max;
+
+    public:
+    LatencyHistogram() {
+        reset();
+    }
+
+    void reset() {
+        memset(_bins, 0, sizeof(_bins));
+        _count = 0;
+        _sum = 0;
+        _min = INT32_MAX;
+        _max = INT32_MIN;
+    }
+
+    void add(int32_t micros) {
+        uint8_t bin = 0;
+        if (micros >= 0) {
+            uint32_t units = (uint32_t)micros / HISTOGRAM_FIRST_BOUND;
+            bin = units ? 2 + (31 - __builtin_clz(units)) : 1;
+            bin = min(bin, (uint8_t)(HISTOGRAM_BINS - 1));
+        }
+        _bins[bin]++;
+        _count++;
+        _sum += micros;
+        _min = min(_min, micros);
+        _max = max(_max, micros);
+    }
+
+    // Return upper bound of the bin, us, 0 for early one, INT32_MAX for the last
+    static int32_t getBound(uint8_t bin) {
+        return bin == 0 ? 0 : bin == HISTOGRAM_BINS - 1 ? INT32_MAX :
+            HISTOGRAM_FIRST_BOUND << (bin - 1);
+    }
+
+    uint32_t getBin(uint8_t bin) const {
+        return _bins[bin];
+    }
+
+    uint32_t getCount() const {
+        return _count;
+    }
+
+    int64_t getSum() const {
+        return _sum;
+    }
+
+    int32_t getMean() const {
+        return _count ? (int32_t)(_sum / _count) : 0;
+    }
+
+    int32_t getMin() const {
+        return _count ? _min : 0;
+    }
+
+    int32_t getMax() const {
+        return _count ? _max : 0;
+    }
+
+    // Return upper bound of the bin holding given percent of samples, max if it is last
+    int32_t getPercentile(uint8_t percent) const {
+        uint32_t rank = (uint32_t)(((uint64_t)_count * percent + 99) / 100), seen = 0;
+        for (uint8_t bin = 0; bin < HISTOGRAM_BINS; bin++) {
+            seen += _bins[bin];
+            if (seen >= rank && seen > 0) {
+                return min(getBound(bin), getMax());
+            }
+        }
+        return 0;
+    }
+
+    // Write histogram as JSON object into given buffer, return its length
+    size_t toJSON(char* buffer, size_t size) const {
+        size_t length = snprintf(buffer, size, "{\"count\":%u, \"mean\":%ld, \"min\":%ld, \"max\":%ld, "
+            "\"p50\":%ld, \"p99\":%ld, \"bins\":[", (unsigned)_count, (long)getMean(), (long)getMin(),
+            (long)getMax(), (long)getPercentile(50), (long)getPercentile(99));
+        for (uint8_t bin = 0; bin < HISTOGRAM_BINS && length < size; bin++) {
+            if (bin == HISTOGRAM_BINS - 1) {
+                length += snprintf(buffer + length, size - length, ", {\"le\":null, \"count\":%u}",
+                    (unsigned)_bins[bin]);
+            }
+            else length += snprintf(buffer + length, size - length, "%s{\"le\":%ld, \"count\":%u}",
+                bin ? ", " : "", (long)getBound(bin), (unsigned)_bins[bin]);
+        }
+        if (length < size) {
+            length += snprintf(buffer + length, size - length, "]}");
+        }
+        return min(length, size - 1);
+    }
+};
@@ -0,0 +1,162 @@
+/******************************************************************************
+ * (c) Skatech Research Lab, 2000-2026.
+ * Last change: 2026.10.17
+ * Logger class - leveled log lines formatted into a ring buffer, drained to
+ * the UART as its transmit FIFO takes them, recent lines kept for the web UI
+ *****************************************************************************/
+
+#pragma once
+
+#include <Arduino.h>
+#include <stdarg.h>
+
+#define LOG_LEVEL_ERROR 1
+#define LOG_LEVEL_WARN 2
+#define LOG_LEVEL_INFO 3
+#define LOG_LEVEL_DEBUG 4
+
+#ifndef LOG_LEVEL
+#define LOG_LEVEL LOG_LEVEL_INFO        // lines of higher levels are not compiled in
+#endif
+
+#define LOG_BUFFER_SIZE 2048            // bytes of recent lines, power of two
+#define LOG_LINE_LENGTH 120             // longer lines are cut
+#define LOG_DRAIN_PERIOD 10             // ms the UART FIFO takes to send, loop wakes that often while lines wait
+
+#define LOG_ERROR(...) Logger::system().log(LOG_LEVEL_ERROR, __VA_ARGS__)
+#if LOG_LEVEL >= LOG_LEVEL_WARN
+#define LOG_WARN(...) Logger::system().log(LOG_LEVEL_WARN, __VA_ARGS__)
+#else
+#define LOG_WARN(...) ((void)0)
+#endif
+#if LOG_LEVEL >= LOG_LEVEL_INFO
+#define LOG_INFO(...) Logger::system().log(LOG_LEVEL_INFO, __VA_ARGS__)
+#else
+#define LOG_INFO(...) ((void)0)
+#endif
+#if LOG_LEVEL >= LOG_LEVEL_DEBUG
+#define LOG_DEBUG(...) Logger::system().log(LOG_LEVEL_DEBUG, __VA_ARGS__)
+#else
+#define LOG_DEBUG(...) ((void)0)
+#endif
+
+// Lines are written whole into the ring, never waiting for the UART. Positions count
+// bytes ever written, the ring keeps the last LOG_BUFFER_SIZE of them. Lines the UART
+// did not take before they were overwritten are skipped and counted as lost
+class Logger {
+    private:
+    char _ring[LOG_BUFFER_SIZE];
+    uint32_t _written, _sent;           // byte positions
+    uint32_t _lines, _lost;
+    HardwareSerial* _output;
+
+    char at(uint32_t position) const {
+        return _ring[position & (LOG_BUFFER_SIZE - 1)];
+    }
+
+    // Position of the first whole line kept at or after given one, the byte before the
+    // oldest one kept is overwritten, so that line is taken as cut
+    uint32_t lineStart(uint32_t position) const {
+        uint32_t oldest = _written > LOG_BUFFER_SIZE ? _written - LOG_BUFFER_SIZE : 0;
+        if (position >= oldest) {
+            return position;
+        }
+        for (position = oldest; position < _written && at(position) != '\n'; position++);
+        return min(position + 1, _written);
+    }
+
+    void append(const char* text, size_t length) {
+        for (size_t copied = 0; copied < length; ) {
+            size_t offset = _written & (LOG_BUFFER_SIZE - 1);
+            size_t count = min(length - copied, (size_t)LOG_BUFFER_SIZE - offset);
+            memcpy(_ring + offset, text + copied, count);
+            copied += count;
+            _written += count;
+        }
+    }
+
+    public:
+    Logger() : _written(0), _sent(0), _lines(0), _lost(0), _output(NULL) {
+    }
+
+    static Logger& system() {
+        static Logger logger;
+        return logger;
+    }
+
+    static char getLevelLetter(uint8_t level) {
+        return level == LOG_LEVEL_ERROR ? 'E' : level == LOG_LEVEL_WARN ? 'W' :
+            level == LOG_LEVEL_INFO ? 'I' : 'D';
+    }
+
+    // Set UART lines are drained to, NULL keeps them in the ring only
+    void begin(HardwareSerial* output) {
+        _output = output;
+    }
+
+    // Format line with uptime and level, few microseconds, never waits for output
+    __attribute__((format(printf, 3, 4))) void log(uint8_t level, const char* format, ...) {
+        char line[LOG_LINE_LENGTH + 1];
+        uint32_t ms = millis();
+        int head = snprintf(line, sizeof(line), "%5lu.%03lu %c ", (unsigned long)(ms / 1000),
+            (unsigned long)(ms % 1000), getLevelLetter(level));
+        va_list args;
+        va_start(args, format);
+        int body = vsnprintf(line + head, sizeof(line) - head, format, args);
+        va_end(args);
+        size_t length = min((size_t)(head + max(body, 0)), sizeof(line) - 2);
+        line[length++] = '\n';
+        uint32_t unsent = _written - _sent;
+        append(line, length);
+        _lines++;
+        if (unsent + length > LOG_BUFFER_SIZE) {
+            uint32_t next = lineStart(_sent);
+            _lost += next - _sent;
+            _sent = next;
+        }
+    }
+
+    // Send what the output takes without waiting, call from idle time
+    void drain() {
+        if (!_output || _sent == _written) {
+            return;
+        }
+        int space = _output->availableForWrite();
+        while (space > 0 && _sent < _written) {
+            size_t offset = _sent & (LOG_BUFFER_SIZE - 1);
+            size_t count = min(min((size_t)(_written - _sent), (size_t)LOG_BUFFER_SIZE - offset), (size_t)space);
+            count = _output->write((const uint8_t*)_ring + offset, count);
+            if (count == 0) {
+                break;
+            }
+            _sent += count;
+            space -= count;
+        }
+    }
+
+    // Return true while lines wait for the output
+    bool isPending() const {
+        return _output && _sent != _written;
+    }
+
+    // Write whole lines kept in the ring, oldest first
+    size_t printTo(Print& out) const {
+        size_t printed = 0;
+        for (uint32_t position = lineStart(0); position < _written; ) {
+            size_t offset = position & (LOG_BUFFER_SIZE - 1);
+            size_t count = min((size_t)(_written - position), (size_t)LOG_BUFFER_SIZE - offset);
+            printed += out.write((const uint8_t*)_ring + offset, count);
+            position += count;
+        }
+        return printed;
+    }
+
+    uint32_t getLines() const {
+        return _lines;
+    }
+
+    // Return bytes skipped by the output as the ring overwrote them
+    uint32_t getLost() const {
+        return _lost;
+    }
+};
@@ -0,0 +1,170 @@
+/******************************************************************************
+ * (c) Skatech Research Lab, 2000-2026.
+ * Last change: 2026.10.17
+ * Metric, MetricTimer and Metrics classes - named run time histograms of hot
+ * paths and heap gauges written in Prometheus text format
+ *****************************************************************************/
+
+#pragma once
+
+#include <Arduino.h>
+#include <stdarg.h>
+
+#include "LatencyHistogram.h"
+
+#define METRICS_PREFIX "clock_"
+#define METRICS_LINE_BUFFER 192         // bytes of a single output line
+
+// Run time histogram of one series, written once added to Metrics. Labels are
+// written as given, e.g. phase="send"
+class Metric {
+    private:
+    const char* _name;
+    const char* _help;
+    const char* _labels;
+    LatencyHistogram _histogram;
+    Metric* _next = NULL;               // in list of Metrics
+    bool _added = false;
+    friend class Metrics;
+
+    public:
+    Metric(const char* name, const char* help, const char* labels = NULL)
+        : _name(name), _help(help), _labels(labels) {
+    }
+
+    Metric(const Metric&) = delete;
+    Metric& operator=(const Metric&) = delete;
+
+    // Count run of given microseconds, no allocation, few tens of cycles
+    void record(uint32_t micros) {
+        _histogram.add((int32_t)min(micros, (uint32_t)INT32_MAX));
+    }
+
+    const char* getName() const {
+        return _name;
+    }
+
+    const char* getHelp() const {
+        return _help;
+    }
+
+    const char* getLabels() const {
+        return _labels;
+    }
+
+    const LatencyHistogram& getHistogram() const {
+        return _histogram;
+    }
+};
+
+// Records time from construction to the end of the scope
+class MetricTimer {
+    private:
+    Metric& _metric;
+    uint32_t _start;
+
+    public:
+    MetricTimer(Metric& metric) : _metric(metric), _start(micros()) {
+    }
+
+    ~MetricTimer() {
+        _metric.record(micros() - _start);
+    }
+};
+
+// Series are written in order added, those of a family are added one after another
+// so the family is described once. Free heap is a counter read, its minimum is kept
+// by the loop. Largest free block walks the heap, so it is read on request only
+class Metrics {
+    private:
+    Metric* _first;
+    Metric* _last;
+    uint32_t _heapFreeMin;
+
+    // Seconds with microsecond digits, Prometheus base unit
+    static int formatSeconds(char* buffer, size_t size, int64_t micros) {
+        uint64_t magnitude = micros < 0 ? -micros : micros;
+        return snprintf(buffer, size, "%s%lu.%06lu", micros < 0 ? "-" : "",
+            (unsigned long)(magnitude / 1000000), (unsigned long)(magnitude % 1000000));
+    }
+
+    __attribute__((format(printf, 2, 3))) static void printLine(Print& out, const char* format, ...) {
+        char line[METRICS_LINE_BUFFER];
+        va_list args;
+        va_start(args, format);
+        int length = vsnprintf(line, sizeof(line), format, args);
+        va_end(args);
+        if (length > 0) {
+            out.write((const uint8_t*)line, min((size_t)length, sizeof(line) - 1));
+        }
+    }
+
+    static void printGauge(Print& out, const char* name, const char* help, uint32_t value) {
+        printLine(out, "# HELP " METRICS_PREFIX "%s %s\n# TYPE " METRICS_PREFIX "%s gauge\n" METRICS_PREFIX "%s %u\n",
+            name, help, name, name, (unsigned)value);
+    }
+
+    static void printHistogram(Print& out, const Metric& metric) {
+        const LatencyHistogram& histogram = metric.getHistogram();
+        const char* labels = metric.getLabels() ? metric.getLabels() : "";
+        const char* comma = *labels ? "," : "";
+        char bound[24];
+        uint32_t count = histogram.getBin(0);
+        for (uint8_t bin = 1; bin < HISTOGRAM_BINS; bin++) {
+            count += histogram.getBin(bin);
+            if (bin == HISTOGRAM_BINS - 1) {
+                strcpy(bound, "+Inf");
+            }
+            else formatSeconds(bound, sizeof(bound), LatencyHistogram::getBound(bin));
+            printLine(out, METRICS_PREFIX "%s_bucket{%s%sle=\"%s\"} %u\n", metric.getName(), labels, comma,
+                bound, (unsigned)count);
+        }
+        formatSeconds(bound, sizeof(bound), histogram.getSum());
+        printLine(out, METRICS_PREFIX "%s_sum%s%s%s %s\n" METRICS_PREFIX "%s_count%s%s%s %u\n",
+            metric.getName(), *labels ? "{" : "", labels, *labels ? "}" : "", bound,
+            metric.getName(), *labels ? "{" : "", labels, *labels ? "}" : "", (unsigned)histogram.getCount());
+    }
+
+    public:
+    Metrics() : _first(NULL), _last(NULL), _heapFreeMin(UINT32_MAX) {
+    }
+
+    // Add series to the output, metric must outlive the list
+    void add(Metric& metric) {
+        if (metric._added) {
+            return;
+        }
+        metric._added = true;
+        if (_last) {
+            _last->_next = &metric;
+        }
+        else _first = &metric;
+        _last = &metric;
+    }
+
+    // Call every loop pass, keeps lowest free heap since boot
+    void sampleHeap() {
+        _heapFreeMin = min(_heapFreeMin, ESP.getFreeHeap());
+    }
+
+    // Write gauges and every histogram counted at least once
+    void printTo(Print& out) const {
+        printGauge(out, "uptime_seconds", "Time since boot", millis() / 1000);
+        printGauge(out, "heap_free_bytes", "Free heap now", ESP.getFreeHeap());
+        printGauge(out, "heap_free_min_bytes", "Lowest free heap seen by the loop", _heapFreeMin);
+        printGauge(out, "heap_max_block_bytes", "Largest free heap block now", ESP.getMaxFreeBlockSize());
+        printGauge(out, "heap_fragmentation_percent", "Heap fragmentation now", ESP.getHeapFragmentation());
+        const char* described = NULL;
+        for (const Metric* metric = _first; metric; metric = metric->_next) {
+            if (metric->getHistogram().getCount() == 0) {
+                continue;
+            }
+            if (!described || strcmp(described, metric->getName()) != 0) {
+                described = metric->getName();
+                printLine(out, "# HELP " METRICS_PREFIX "%s %s\n# TYPE " METRICS_PREFIX "%s histogram\n",
+                    described, metric->getHelp(), described);
+            }
+            printHistogram(out, *metric);
+        }
+    }
+};
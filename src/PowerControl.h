@@ -0,0 +1,137 @@
+/******************************************************************************
+ * (c) Skatech Research Lab, 2000-2026.
+ * Last change: 2026.10.16
+ * PowerControl class - radio sleep mode, loop idle accounting, duty cycle and
+ * estimated supply current of the module
+ *****************************************************************************/
+
+#pragma once
+
+#include <Arduino.h>
+#include <ESP8266WiFi.h>
+
+#define POWER_MODE_FULL 0               // radio always on, lowest request latency
+#define POWER_MODE_MODEM 1              // radio wakes for every beacon, core default
+#define POWER_MODE_LIGHT 2              // CPU and radio sleep between deadlines
+#ifndef POWER_DEFAULT_MODE
+#define POWER_DEFAULT_MODE POWER_MODE_MODEM
+#endif
+
+#define POWER_LISTEN_INTERVAL 3         // beacons (DTIM) slept through in light sleep
+#define POWER_BEACON_MICROS 102400      // us, usual access point beacon interval
+#define POWER_LIGHT_MIN_SLEEP 10        // ms of idle the SDK enters light sleep for
+#define POWER_LIGHT_HOUSEKEEPING 10000  // ms between watchdog and fetch checks in light sleep
+
+// typical module currents by datasheet, uA
+#define POWER_ACTIVE_CURRENT 70000      // CPU running, radio receiving
+#define POWER_MODEM_CURRENT 15000       // CPU idle, radio sleeping between beacons
+#define POWER_LIGHT_CURRENT 900         // CPU and radio suspended
+#define POWER_BEACON_ON_MICROS 3000     // radio on to receive beacon in light sleep
+#define POWER_WAKE_MICROS 2000          // light sleep resume at active current
+
+// Loop idle time is slept in the mode selected, active time is the rest. Light sleep is
+// entered only for idles of POWER_LIGHT_MIN_SLEEP or more, shorter ones count as modem
+// sleep. Current estimate is the time weighted average of the mode currents
+class PowerControl {
+    private:
+    uint8_t _mode;
+    uint32_t _mark;                     // micros() of the last idle end
+    uint64_t _activeMicros, _idleMicros, _lightMicros;
+    uint32_t _wakeups;
+
+    public:
+    PowerControl() : _mode(POWER_DEFAULT_MODE) {
+        reset();
+    }
+
+    bool setMode(uint8_t mode) {
+        if (mode > POWER_MODE_LIGHT) {
+            return false;
+        }
+        _mode = mode;
+        return WiFi.setSleepMode(mode == POWER_MODE_FULL ? WIFI_NONE_SLEEP : mode == POWER_MODE_MODEM ?
+            WIFI_MODEM_SLEEP : WIFI_LIGHT_SLEEP, mode == POWER_MODE_LIGHT ? POWER_LISTEN_INTERVAL : 0);
+    }
+
+    // Select mode by name, full, modem or light
+    bool setMode(const char* name) {
+        for (uint8_t mode = POWER_MODE_FULL; mode <= POWER_MODE_LIGHT; mode++) {
+            if (strcmp(name, getModeName(mode)) == 0) {
+                return setMode(mode);
+            }
+        }
+        return false;
+    }
+
+    uint8_t getMode() const {
+        return _mode;
+    }
+
+    static const char* getModeName(uint8_t mode) {
+        return mode == POWER_MODE_FULL ? "full" : mode == POWER_MODE_MODEM ? "modem" : "light";
+    }
+
+    void reset() {
+        _mark = micros();
+        _activeMicros = _idleMicros = _lightMicros = 0;
+        _wakeups = 0;
+    }
+
+    // Sleep the loop for given ms, the WiFi stack works meanwhile
+    void idle(uint32_t ms) {
+        uint32_t start = micros();
+        _activeMicros += start - _mark;
+        delay(ms);
+        _mark = micros();
+        if (_mode == POWER_MODE_LIGHT && ms >= POWER_LIGHT_MIN_SLEEP) {
+            _lightMicros += _mark - start;
+            _wakeups++;
+        }
+        else _idleMicros += _mark - start;
+    }
+
+    uint64_t getActiveMicros() const {
+        return _activeMicros;
+    }
+
+    uint64_t getSleepMicros() const {
+        return _idleMicros + _lightMicros;
+    }
+
+    uint32_t getWakeups() const {
+        return _wakeups;
+    }
+
+    // Return part of time the CPU was running, per mille
+    uint16_t getDutyCycle() const {
+        uint64_t total = _activeMicros + _idleMicros + _lightMicros;
+        return total ? (uint16_t)(_activeMicros * 1000 / total) : 1000;
+    }
+
+    // Return average supply current estimated by time spent in each state, uA
+    uint32_t getEstimatedCurrent() const {
+        uint64_t total = _activeMicros + _idleMicros + _lightMicros;
+        if (total == 0) {
+            return POWER_ACTIVE_CURRENT;
+        }
+        uint64_t beacons = _lightMicros / (POWER_BEACON_MICROS * POWER_LISTEN_INTERVAL);
+        uint64_t charge = _activeMicros * POWER_ACTIVE_CURRENT + _lightMicros * POWER_LIGHT_CURRENT +
+            _idleMicros * (_mode == POWER_MODE_FULL ? POWER_ACTIVE_CURRENT : POWER_MODEM_CURRENT) +
+            (beacons * POWER_BEACON_ON_MICROS + (uint64_t)_wakeups * POWER_WAKE_MICROS) *
+            (POWER_ACTIVE_CURRENT - POWER_LIGHT_CURRENT);
+        return (uint32_t)(charge / total);
+    }
+
+    // Write mode and statistics as JSON object into given buffer, return its length
+    size_t toJSON(char* buffer, size_t size) const {
+        uint64_t total = _activeMicros + _idleMicros + _lightMicros;
+        size_t length = snprintf(buffer, size, "{\"mode\":\"%s\", \"seconds\":%u, \"duty\":%u.%u, "
+            "\"light\":%u, \"wakeups\":%u, \"wakeupsPerSecond\":%u.%02u, \"current\":%u.%u}",
+            getModeName(_mode), (unsigned)(total / 1000000), getDutyCycle() / 10, getDutyCycle() % 10,
+            (unsigned)(total ? _lightMicros * 100 / total : 0), (unsigned)_wakeups,
+            (unsigned)(total ? (uint64_t)_wakeups * 1000000 / total : 0),
+            (unsigned)(total ? (uint64_t)_wakeups * 100000000 / total % 100 : 0),
+            (unsigned)(getEstimatedCurrent() / 1000), (unsigned)(getEstimatedCurrent() % 1000 / 100));
+        return min(length, size - 1);
+    }
+};
@@ -0,0 +1,596 @@
+/******************************************************************************
+ * (c) Skatech Research Lab, 2000-2026.
+ * Last change: 2026.10.16
+ * SNTPClient class - multi-server SNTP client disciplining system clock by
+ * slewing with oscillator drift compensation
+ *****************************************************************************/
+
+#pragma once
+
+#include <Arduino.h>
+#include <ESP8266WiFi.h>
+#include <WiFiUdp.h>
+#include <lwip/dns.h>
+#include <sys/time.h>
+
+#include "Logger.h"
+
+#define SNTP_SERVERS 3
+#define SNTP_PORT 123
+#define SNTP_LOCAL_PORT 4123
+#define SNTP_PACKET_SIZE 48
+#define SNTP_UNIX_EPOCH 2208988800LL    // seconds from 1900 to 1970
+
+#define SNTP_REPLY_TIMEOUT 1500         // ms to wait for replies of a poll round
+#define SNTP_MIN_POLL 64                // seconds between rounds, starting interval
+#define SNTP_MAX_POLL 4096              // interval reached while offsets stay small
+#define SNTP_POLL_STRETCH 4             // good rounds in row to double interval
+#define SNTP_SINGLE_POLL 1024           // from this interval only preferred server asked,
+#define SNTP_ALL_ROUNDS 4               // except every fourth round
+#define SNTP_FILTER_SAMPLES 8           // samples kept per server, least delay one used
+#define SNTP_SAMPLE_AGING 15            // us per second added to distance of the old sample
+#define SNTP_MIN_ACCURACY 1000          // us, offset treated as good regardless of jitter
+#define SNTP_STEP_THRESHOLD 128000      // us, larger offset is stepped, smaller slewed
+#define SNTP_SLEW_RATE 500              // us per second, fastest slew as adjtime() does
+#define SNTP_ADJUST_PERIOD 1000         // ms between clock adjustments
+#define SNTP_MAX_DRIFT 500000           // ppb of the oscillator error compensated
+#define SNTP_DRIFT_POINTS 8             // offset history used for drift estimation
+#define SNTP_DRIFT_SPAN 120             // seconds of history needed to estimate drift
+
+// Single measured exchange, offset follows clock adjustments made after it
+class SNTPSample {
+    public:
+    int64_t offset;                     // us reference time minus clock
+    uint32_t delay;                     // us round trip without server processing
+    uint32_t taken;                     // millis() of the reply
+};
+
+class SNTPPeer {
+    public:
+    const char* host = NULL;
+    IPAddress address;
+    volatile bool resolving = false;    // cleared from resolver callback
+    bool pending = false;               // request sent, reply awaited
+    uint64_t stamp = 0;                 // transmit timestamp of the request, NTP format
+    int64_t sentAt = 0;                 // clock at request, us since epoch
+    int64_t appliedAt = 0;              // adjustments applied before request
+    int64_t slewedAt = 0;
+    SNTPSample samples[SNTP_FILTER_SAMPLES];
+    uint8_t count = 0, next = 0;
+    uint8_t reach = 0;                  // replies of last eight requests, bit per request
+    int64_t offset = 0;                 // offset of the least delay sample
+    uint32_t delay = 0, jitter = 0;
+    bool fresh = false;                 // replied in current round
+    bool truechimer = false;            // agreed with the majority on last round
+
+    // Root distance of the least delay sample, half delay plus jitter
+    uint32_t distance() const {
+        return delay / 2 + jitter;
+    }
+};
+
+// Servers are asked in parallel, per server the sample of least delay and age is taken
+// as NTP clock filter does, servers disagreeing with the median are dropped and rest are
+// averaged by distance. Offset is slewed out, oscillator drift is the slope of reference
+// minus uncorrected clock over recent rounds, poll interval doubles while offsets stay
+// within jitter. Works on wall clock by settimeofday(), lwIP SNTP must stay stopped
+class SNTPClient {
+    private:
+    WiFiUDP _udp;
+    SNTPPeer _peers[SNTP_SERVERS];
+    bool _enabled, _listening, _polling, _synced;
+    uint32_t _interval, _pollStart, _adjustedAt, _lastMillis;
+    uint64_t _uptime;                   // ms, millis() extended past wrap
+    uint8_t _good, _rounds, _preferred;
+    uint32_t _packets, _replies, _steps;
+    int64_t _applied;                   // us of all adjustments applied to the clock
+    int64_t _slewed;                    // us of them made by steps and slews
+    int64_t _offset, _slew;
+    int64_t _driftRemainder;            // ns of drift correction not yet applied
+    uint32_t _jitter, _delay;
+    int32_t _drift;                     // ppb correction rate of the oscillator
+    uint64_t _pointTimes[SNTP_DRIFT_POINTS];
+    int64_t _pointErrors[SNTP_DRIFT_POINTS];
+    uint8_t _points, _nextPoint;
+
+    static int64_t clockMicros() {
+        struct timeval tv;
+        gettimeofday(&tv, NULL);
+        return (int64_t)tv.tv_sec * 1000000 + tv.tv_usec;
+    }
+
+    static uint64_t toNTP(int64_t micros) {
+        uint64_t seconds = (uint64_t)(micros / 1000000 + SNTP_UNIX_EPOCH);
+        return (seconds << 32) | (((uint64_t)(micros % 1000000) << 32) / 1000000);
+    }
+
+    // NTP era 0 timestamp to microseconds since Unix epoch
+    static int64_t fromNTP(uint64_t stamp) {
+        return ((int64_t)(stamp >> 32) - SNTP_UNIX_EPOCH) * 1000000 +
+            (int64_t)(((stamp & 0xFFFFFFFFULL) * 1000000) >> 32);
+    }
+
+    static uint64_t readStamp(const uint8_t* data) {
+        uint64_t stamp = 0;
+        for (uint8_t i = 0; i < 8; i++) {
+            stamp = (stamp << 8) | data[i];
+        }
+        return stamp;
+    }
+
+    static void onResolved(const char* name, const ip_addr_t* address, void* peer) {
+        SNTPPeer* self = (SNTPPeer*)peer;
+        self->address = address ? IPAddress(address) : IPAddress();
+        self->resolving = false;
+    }
+
+    // Move wall clock by given microseconds, samples follow the part of slew or step, drift
+    // correction keeps clock on reference time so it does not change offsets
+    void shift(int64_t delta, int64_t slew) {
+        struct timeval tv;
+        int64_t now = clockMicros() + delta;
+        tv.tv_sec = now / 1000000;
+        tv.tv_usec = now % 1000000;
+        settimeofday(&tv, NULL);
+        _applied += delta;
+        _slewed += slew;
+        _offset -= slew;
+        for (SNTPPeer& peer : _peers) {
+            for (uint8_t i = 0; i < peer.count; i++) {
+                peer.samples[i].offset -= slew;
+            }
+            peer.offset -= slew;
+        }
+    }
+
+    // Apply drift correction and slew step once per SNTP_ADJUST_PERIOD
+    void adjust(uint32_t ms) {
+        uint32_t elapsed = ms - _adjustedAt;
+        if (elapsed < SNTP_ADJUST_PERIOD) {
+            return;
+        }
+        _adjustedAt = ms;
+        if (!_synced) {
+            return;
+        }
+        _driftRemainder += (int64_t)_drift * elapsed / 1000;
+        int64_t delta = _driftRemainder / 1000;
+        _driftRemainder -= delta * 1000;
+        int64_t limit = (int64_t)SNTP_SLEW_RATE * elapsed / 1000;
+        int64_t step = _slew > limit ? limit : _slew < -limit ? -limit : _slew;
+        _slew -= step;
+        if (delta + step != 0) {
+            shift(delta + step, step);
+        }
+    }
+
+    void send(SNTPPeer& peer) {
+        uint8_t packet[SNTP_PACKET_SIZE] = { 0 };
+        packet[0] = 0x23;               // no leap warning, version 4, client mode
+        packet[2] = 6;                  // poll exponent
+        peer.sentAt = clockMicros();
+        peer.appliedAt = _applied;
+        peer.slewedAt = _slewed;
+        peer.stamp = toNTP(peer.sentAt);
+        for (uint8_t i = 0; i < 8; i++) {
+            packet[40 + i] = (uint8_t)(peer.stamp >> (56 - i * 8));
+        }
+        _udp.beginPacket(peer.address, SNTP_PORT);
+        _udp.write(packet, sizeof(packet));
+        if (_udp.endPacket()) {
+            peer.pending = true;
+            _packets++;
+        }
+    }
+
+    void receive() {
+        uint8_t packet[SNTP_PACKET_SIZE];
+        while (_udp.parsePacket() > 0) {
+            int64_t received = clockMicros();
+            if (_udp.read(packet, sizeof(packet)) < SNTP_PACKET_SIZE) {
+                continue;
+            }
+            uint32_t from = _udp.remoteIP();
+            for (SNTPPeer& peer : _peers) {
+                if (peer.pending && uint32_t(peer.address) == from && readStamp(packet + 24) == peer.stamp) {
+                    accept(peer, packet, received);
+                }
+            }
+        }
+    }
+
+    // Check reply header and add its sample to the filter of the server
+    void accept(SNTPPeer& peer, const uint8_t* packet, int64_t received) {
+        peer.pending = false;
+        uint8_t mode = packet[0] & 0x07, leap = packet[0] >> 6, stratum = packet[1];
+        uint64_t transmit = readStamp(packet + 40);
+        if (mode != 4 || leap == 3 || stratum == 0 || stratum > 15 || transmit == 0) {
+            return;
+        }
+        _replies++;
+        peer.reach |= 1;
+        peer.fresh = true;
+        // times of clock as it was at request, adjustments made meanwhile taken back
+        int64_t t1 = peer.sentAt, t4 = received - (_applied - peer.appliedAt);
+        int64_t t2 = fromNTP(readStamp(packet + 32)), t3 = fromNTP(transmit);
+        int64_t delay = (t4 - t1) - (t3 - t2);
+        SNTPSample& sample = peer.samples[peer.next];
+        sample.offset = ((t2 - t1) + (t3 - t4)) / 2 - (_slewed - peer.slewedAt);
+        sample.delay = delay > 0 ? (uint32_t)delay : 0;
+        sample.taken = millis();
+        peer.next = (peer.next + 1) % SNTP_FILTER_SAMPLES;
+        if (peer.count < SNTP_FILTER_SAMPLES) {
+            peer.count++;
+        }
+        filter(peer);
+    }
+
+    // Take sample of least delay and age. Jitter is RMS of the half delay excess over the
+    // least delay, bound of path asymmetry, so it does not grow with residual drift
+    void filter(SNTPPeer& peer) {
+        uint32_t now = millis();
+        const SNTPSample* best = NULL;
+        uint64_t bestDistance = 0;
+        uint32_t least = UINT32_MAX;
+        for (uint8_t i = 0; i < peer.count; i++) {
+            const SNTPSample& sample = peer.samples[i];
+            uint64_t distance = sample.delay / 2 + (uint64_t)(now - sample.taken) * SNTP_SAMPLE_AGING / 1000;
+            if (best == NULL || distance < bestDistance) {
+                best = &sample;
+                bestDistance = distance;
+            }
+            least = min(least, sample.delay);
+        }
+        double sum = 0;
+        for (uint8_t i = 0; i < peer.count; i++) {
+            double excess = (peer.samples[i].delay - least) / 2.0;
+            sum += excess * excess;
+        }
+        peer.offset = best->offset;
+        peer.delay = best->delay;
+        peer.jitter = (uint32_t)sqrt(sum / peer.count);
+    }
+
+    void startRound() {
+        if (!_listening) {
+            _listening = _udp.begin(SNTP_LOCAL_PORT);
+        }
+        bool all = _interval < SNTP_SINGLE_POLL || _rounds % SNTP_ALL_ROUNDS == 0 ||
+            !_peers[_preferred].truechimer;
+        for (uint8_t i = 0; i < SNTP_SERVERS; i++) {
+            SNTPPeer& peer = _peers[i];
+            peer.pending = peer.fresh = false;
+            peer.stamp = 0;
+            if (peer.host == NULL || (!all && i != _preferred)) {
+                continue;
+            }
+            peer.reach <<= 1;
+            if ((peer.reach & 0x0F) == 0 && peer.count > 0) {
+                peer.address = IPAddress();     // silent for four requests, resolve again
+                peer.count = 0;
+            }
+            if (uint32_t(peer.address) == 0 && !peer.resolving) {
+                ip_addr_t address;
+                peer.resolving = true;
+                err_t error = dns_gethostbyname(peer.host, &address, onResolved, &peer);
+                if (error == ERR_OK) {
+                    onResolved(peer.host, &address, &peer);
+                }
+                else if (error != ERR_INPROGRESS) {
+                    peer.resolving = false;
+                }
+            }
+            if (uint32_t(peer.address) != 0) {
+                send(peer);
+            }
+            else peer.pending = peer.resolving;     // sent once resolved
+        }
+        _pollStart = millis();
+        _polling = true;
+        _rounds++;
+    }
+
+    // Servers replied before are voting too, their samples stay valid as drift is
+    // compensated, offset is averaged from servers replied in this round and agreeing
+    // with the majority, nothing is corrected without them
+    void finishRound() {
+        _polling = false;
+        SNTPPeer* candidates[SNTP_SERVERS];
+        uint8_t count = 0;
+        bool fresh = false;
+        for (SNTPPeer& peer : _peers) {
+            peer.pending = false;
+            if (peer.host && peer.count > 0 && peer.reach != 0) {
+                filter(peer);
+                candidates[count++] = &peer;
+                fresh |= peer.fresh;
+            }
+        }
+        if (!fresh) {
+            if (_interval > SNTP_MIN_POLL) {
+                _interval /= 2;
+            }
+            _good = 0;
+            return;
+        }
+        // median, then servers whose correctness interval misses the median one dropped
+        for (uint8_t i = 1; i < count; i++) {
+            for (uint8_t j = i; j > 0 && candidates[j]->offset < candidates[j - 1]->offset; j--) {
+                SNTPPeer* swap = candidates[j];
+                candidates[j] = candidates[j - 1];
+                candidates[j - 1] = swap;
+            }
+        }
+        const SNTPPeer* median = candidates[(count - 1) / 2];
+        double weights = 0, offset = 0, jitter = 0, delay = 0;
+        uint32_t best = UINT32_MAX;
+        fresh = false;
+        for (uint8_t i = 0; i < count; i++) {
+            SNTPPeer* peer = candidates[i];
+            int64_t difference = peer->offset - median->offset;
+            uint64_t magnitude = difference < 0 ? -difference : difference;
+            peer->truechimer = magnitude <= (uint64_t)peer->distance() + median->distance();
+            if (!peer->truechimer || !peer->fresh) {
+                continue;
+            }
+            fresh = true;
+            double weight = 1.0 / (peer->distance() + 100);
+            weights += weight;
+            offset += weight * (double)(peer->offset - median->offset);
+            jitter += weight * peer->jitter;
+            delay += weight * peer->delay;
+            if (peer->distance() < best) {
+                best = peer->distance();
+                _preferred = peer - _peers;
+            }
+        }
+        if (!fresh) {
+            _good = 0;
+            return;
+        }
+        _offset = median->offset + (int64_t)(offset / weights);
+        _jitter = (uint32_t)(jitter / weights);
+        _delay = (uint32_t)(delay / weights);
+        discipline();
+    }
+
+    void discipline() {
+        int64_t magnitude = _offset < 0 ? -_offset : _offset;
+        if (!_synced || magnitude > SNTP_STEP_THRESHOLD) {
+            LOG_INFO("SNTP clock stepped by %lld ms", (long long)(_offset / 1000));
+            _slew = 0;
+            shift(_offset, _offset);
+            _synced = true;
+            _steps++;
+            _good = 0;
+            _interval = SNTP_MIN_POLL;
+            record();
+            return;
+        }
+        uint32_t accuracy = max((uint32_t)SNTP_MIN_ACCURACY, _jitter * 3);
+        if (magnitude > accuracy * 4) {
+            // oscillator changed its rate, history before is misleading
+            _points = min(_points, (uint8_t)4);
+        }
+        record();
+        estimateDrift();
+        _slew = _offset;
+        if (magnitude <= accuracy) {
+            if (++_good >= SNTP_POLL_STRETCH && _interval < SNTP_MAX_POLL) {
+                _interval *= 2;
+                _good = 0;
+            }
+        }
+        else {
+            _good = 0;
+            if (magnitude > accuracy * 4 && _interval > SNTP_MIN_POLL) {
+                _interval /= 2;
+            }
+        }
+    }
+
+    // Reference time minus clock as it would be without adjustments, at the time of round
+    void record() {
+        _pointTimes[_nextPoint] = _uptime;
+        _pointErrors[_nextPoint] = _applied + _offset;
+        _nextPoint = (_nextPoint + 1) % SNTP_DRIFT_POINTS;
+        if (_points < SNTP_DRIFT_POINTS) {
+            _points++;
+        }
+    }
+
+    // Least squares slope of the uncorrected clock error is the drift correction rate
+    void estimateDrift() {
+        uint8_t last = (_nextPoint + SNTP_DRIFT_POINTS - 1) % SNTP_DRIFT_POINTS;
+        uint8_t first = (_nextPoint + SNTP_DRIFT_POINTS - _points) % SNTP_DRIFT_POINTS;
+        if (_points < 3 || _pointTimes[last] - _pointTimes[first] < SNTP_DRIFT_SPAN * 1000ULL) {
+            return;
+        }
+        double meanTime = 0, meanError = 0;
+        for (uint8_t n = 0, i = first; n < _points; n++, i = (i + 1) % SNTP_DRIFT_POINTS) {
+            meanTime += (double)(_pointTimes[i] - _pointTimes[first]) / _points;
+            meanError += (double)(_pointErrors[i] - _pointErrors[first]) / _points;
+        }
+        double covariance = 0, variance = 0;
+        for (uint8_t n = 0, i = first; n < _points; n++, i = (i + 1) % SNTP_DRIFT_POINTS) {
+            double time = (double)(_pointTimes[i] - _pointTimes[first]) - meanTime;
+            covariance += time * ((double)(_pointErrors[i] - _pointErrors[first]) - meanError);
+            variance += time * time;
+        }
+        double drift = covariance / variance * 1000000.0;    // us per ms to ppb
+        _drift = (int32_t)constrain(drift, (double)-SNTP_MAX_DRIFT, (double)SNTP_MAX_DRIFT);
+    }
+
+    public:
+    SNTPClient() : _enabled(false), _listening(false), _polling(false), _synced(false),
+        _interval(SNTP_MIN_POLL), _pollStart(0), _adjustedAt(0), _lastMillis(0), _uptime(0),
+        _good(0), _rounds(0), _preferred(0), _packets(0), _replies(0), _steps(0), _applied(0), _slewed(0),
+        _offset(0), _slew(0), _driftRemainder(0), _jitter(0), _delay(0), _drift(0),
+        _pointTimes(), _pointErrors(), _points(0), _nextPoint(0) {
+    }
+
+    // Set server host names, strings must outlive the client, NULL or empty ones unused,
+    // state of the servers kept is not lost
+    void configure(const char* server1, const char* server2 = NULL, const char* server3 = NULL) {
+        const char* hosts[SNTP_SERVERS] = { server1, server2, server3 };
+        bool changed = false;
+        for (uint8_t i = 0; i < SNTP_SERVERS; i++) {
+            const char* host = hosts[i] && *hosts[i] ? hosts[i] : NULL;
+            if (_peers[i].host != host || _peers[i].resolving) {
+                _peers[i] = SNTPPeer();
+                _peers[i].host = host;
+                changed = true;
+            }
+        }
+        if (changed) {
+            _preferred = 0;
+            restart();
+        }
+        else _enabled = true;
+    }
+
+    void start() {
+        _enabled = true;
+    }
+
+    void stop() {
+        _enabled = false;
+        _polling = false;
+    }
+
+    // Poll on next update, drift estimate is kept
+    void restart() {
+        _enabled = true;
+        _polling = false;
+        _rounds = 0;
+        _good = 0;
+        _interval = SNTP_MIN_POLL;
+    }
+
+    // Clock was set by other means, next reply steps it, offset history is dropped
+    // as it no longer tells the drift
+    void unsynchronize() {
+        _synced = false;
+        _slew = 0;
+        _points = _nextPoint = 0;
+    }
+
+    bool isEnabled() const {
+        return _enabled;
+    }
+
+    bool isSynchronized() const {
+        return _synced;
+    }
+
+    // Round in progress, replies are time stamped when update() sees them
+    bool isPolling() const {
+        return _polling;
+    }
+
+    // Return ms until the next poll round starts, 1 while polling, adjustment catches up
+    // any time elapsed so it does not need a call of its own
+    uint32_t getRoundDelay() const {
+        if (_polling) {
+            return 1;
+        }
+        uint32_t elapsed = millis() - _pollStart;
+        return _rounds == 0 || elapsed >= _interval * 1000 ? 0 : _interval * 1000 - elapsed;
+    }
+
+    // Call every loop pass, sends, receives and adjusts clock without blocking
+    void update() {
+        uint32_t ms = millis();
+        _uptime += ms - _lastMillis;
+        _lastMillis = ms;
+        if (!_enabled) {
+            return;
+        }
+        adjust(ms);
+        if (WiFi.status() != WL_CONNECTED) {
+            return;
+        }
+        if (_polling) {
+            receive();
+            for (SNTPPeer& peer : _peers) {
+                if (peer.pending && !peer.resolving && peer.stamp == 0) {
+                    if (uint32_t(peer.address) != 0) {
+                        send(peer);
+                    }
+                    else peer.pending = false;  // not resolved
+                }
+            }
+            bool waiting = false;
+            for (const SNTPPeer& peer : _peers) {
+                waiting |= peer.pending;
+            }
+            if (!waiting || ms - _pollStart >= SNTP_REPLY_TIMEOUT) {
+                finishRound();
+            }
+        }
+        else if (_rounds == 0 || ms - _pollStart >= _interval * 1000) {
+            startRound();
+        }
+    }
+
+    // Return last combined offset of reference time from clock, us
+    int64_t getOffset() const {
+        return _offset;
+    }
+
+    uint32_t getJitter() const {
+        return _jitter;
+    }
+
+    uint32_t getDelay() const {
+        return _delay;
+    }
+
+    // Return drift correction rate, ppb the clock is made faster by
+    int32_t getDrift() const {
+        return _drift;
+    }
+
+    // Return seconds between poll rounds
+    uint32_t getPollInterval() const {
+        return _interval;
+    }
+
+    uint32_t getPackets() const {
+        return _packets;
+    }
+
+    uint32_t getReplies() const {
+        return _replies;
+    }
+
+    uint32_t getSteps() const {
+        return _steps;
+    }
+
+    const SNTPPeer& getPeer(uint8_t index) const {
+        return _peers[index];
+    }
+
+    // Write state as JSON object into given buffer, return its length
+    size_t toJSON(char* buffer, size_t size) const {
+        size_t length = snprintf(buffer, size, "{\"synchronized\":%s, \"offset\":%lld, \"jitter\":%u, "
+            "\"delay\":%u, \"drift\":%ld, \"poll\":%u, \"packets\":%u, \"replies\":%u, \"steps\":%u, \"servers\":[",
+            _synced ? "true" : "false", (long long)_offset, (unsigned)_jitter, (unsigned)_delay, (long)_drift,
+            (unsigned)_interval, (unsigned)_packets, (unsigned)_replies, (unsigned)_steps);
+        bool first = true;
+        for (const SNTPPeer& peer : _peers) {
+            if (peer.host && length < size) {
+                length += snprintf(buffer + length, size - length, "%s{\"host\":\"%s\", \"offset\":%lld, "
+                    "\"delay\":%u, \"jitter\":%u, \"reach\":%u, \"selected\":%s}", first ? "" : ", ",
+                    peer.host, (long long)peer.offset, (unsigned)peer.delay, (unsigned)peer.jitter,
+                    (unsigned)peer.reach, peer.truechimer ? "true" : "false");
+                first = false;
+            }
+        }
+        if (length < size) {
+            length += snprintf(buffer + length, size - length, "]}");
+        }
+        return min(length, size - 1);
+    }
+};
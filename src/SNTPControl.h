@@ -1,35 +1,45 @@
 /******************************************************************************
- * (c) Skatech Research Lab, 2000-2023.
- * Last change: 2023.01.02
+ * (c) Skatech Research Lab, 2000-2026.
+ * Last change: 2026.10.16
  * SNTPControl class  - helper functions for NTP service configuration and control
  *****************************************************************************/
 
 #include <Arduino.h>
 #include <sntp.h>
 
-#pragma once
+#include "DateTime.h"
+#include "SNTPClient.h"
 
-// seconds between ntp time syncronization, default 3600
-//#define CONFIG_LWIP_SNTP_UPDATE_DELAY 3600
+#pragma once
 
+// Time service controls, time is kept by the native SNTPClient, lwIP SNTP stays stopped
 class SNTPControl {
     public:
-    
+
+    static SNTPClient& client() {
+        static SNTPClient instance;
+        return instance;
+    }
+
     static bool isEnabled() {
-        return sntp_enabled();
+        return client().isEnabled();
     }
 
     static void restart() {
-        sntp_stop();
-        sntp_init();
+        client().restart();
     }
 
     static void start() {
-        sntp_init();
+        client().start();
     }
 
     static void stop() {
-        sntp_stop();
+        client().stop();
+    }
+
+    // Call every loop pass
+    static void update() {
+        client().update();
     }
 
     static int8_t getTimezone() {
@@ -39,9 +49,24 @@ class SNTPControl {
     // timezone, daylight - in hours
     static void configure(int8_t timezone, int8_t daylight, const char* timeServer1,
         const char* timeServer2 = NULL, const char* timeServer3 = NULL, bool enableService = true) {
-        configTime(timezone * 3600, daylight * 3600, timeServer1, timeServer2, timeServer3);
+        char rule[TIMEZONE_RULE_LENGTH];
+        TimeZone::fixedRule(rule, sizeof(rule), (timezone + daylight) * 3600);
+        configure(rule, timeServer1, timeServer2, timeServer3, enableService);
+    }
+
+    // rule - POSIX TZ string, applied to DateTime conversions and libc, return false
+    // and keep current configuration when rule is invalid
+    static bool configure(const char* rule, const char* timeServer1,
+        const char* timeServer2 = NULL, const char* timeServer3 = NULL, bool enableService = true) {
+        if (!TimeZone::local().parse(rule)) {
+            return false;
+        }
+        setTZ(rule);
+        DateTime::calendar().reset();
+        client().configure(timeServer1, timeServer2, timeServer3);
         if (enableService == false) {
             stop();
         }
+        return true;
     }
 };
\ No newline at end of file
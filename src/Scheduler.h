@@ -0,0 +1,281 @@
+/******************************************************************************
+ * (c) Skatech Research Lab, 2000-2026.
+ * Last change: 2026.10.17
+ * Scheduler class - cooperative scheduler of named tasks on a hierarchical
+ * timer wheel, tells how long the loop may sleep until the next deadline
+ *****************************************************************************/
+
+#pragma once
+
+#include <Arduino.h>
+#include "JsonWriter.h"
+
+#define SCHEDULER_WHEEL_BITS 6          // slots per level as power of two
+#define SCHEDULER_WHEEL_SLOTS (1 << SCHEDULER_WHEEL_BITS)
+#define SCHEDULER_WHEEL_LEVELS 4        // 1 ms, 64 ms, 4.1 s and 262 s slots, 4.6 hours ahead
+#define SCHEDULER_MAX_DELAY ((1UL << (SCHEDULER_WHEEL_BITS * SCHEDULER_WHEEL_LEVELS)) - 1)
+#define SCHEDULER_IDLE_SLEEP 1000       // ms slept at most, also with no task scheduled
+
+typedef void (*TaskFunction)();
+
+// Task to run by Scheduler, periodic while period is not zero, one-shot otherwise.
+// Period and budget can be changed any time, also from the task function
+class ScheduledTask {
+    private:
+    ScheduledTask* _next = NULL;        // in wheel slot
+    ScheduledTask* _prev = NULL;
+    ScheduledTask* _following = NULL;   // in list of all tasks
+    uint32_t _due = 0;                  // millis() of the deadline
+    uint8_t _level = 0, _slot = 0;
+    bool _scheduled = false, _registered = false;
+    friend class Scheduler;
+
+    public:
+    const char* name;
+    TaskFunction function;
+    uint32_t period;                    // ms
+    uint32_t budget;                    // us of single run, longer run is an overrun
+    uint32_t runs = 0, overruns = 0;
+    uint32_t microsMax = 0;             // longest run
+    uint64_t microsTotal = 0;
+    uint32_t lateMax = 0;               // ms of the latest start after deadline
+
+    ScheduledTask(const char* name, TaskFunction function, uint32_t period, uint32_t budget)
+        : name(name), function(function), period(period), budget(budget) {
+    }
+
+    bool isScheduled() const {
+        return _scheduled;
+    }
+
+    uint32_t getDue() const {
+        return _due;
+    }
+};
+
+// Level of the task is chosen by the time left to its deadline, slot by the deadline
+// bits of that level, so every slot holds tasks of a single wheel turn. Whenever a level
+// turns, the slot of the level above is reached and its tasks fall down to finer levels.
+// Occupied slots are kept in bitmaps, ticks without tasks are skipped up to the next turn
+class Scheduler {
+    private:
+    ScheduledTask* _slots[SCHEDULER_WHEEL_LEVELS][SCHEDULER_WHEEL_SLOTS];
+    uint64_t _occupied[SCHEDULER_WHEEL_LEVELS];
+    ScheduledTask* _tasks;
+    uint32_t _clock;                    // next tick to process, ms
+    uint16_t _count;                    // tasks in the wheel
+    bool _running;
+
+    static uint8_t shiftOf(uint8_t level) {
+        return level * SCHEDULER_WHEEL_BITS;
+    }
+
+    static uint64_t rotate(uint64_t bits, uint8_t shift) {
+        shift &= SCHEDULER_WHEEL_SLOTS - 1;
+        return shift ? (bits >> shift) | (bits << (SCHEDULER_WHEEL_SLOTS - shift)) : bits;
+    }
+
+    void insert(ScheduledTask& task) {
+        uint32_t delta = task._due - _clock;
+        uint32_t due = delta > SCHEDULER_MAX_DELAY ? _clock + SCHEDULER_MAX_DELAY : task._due;
+        uint8_t level = 0;
+        while (level + 1 < SCHEDULER_WHEEL_LEVELS && (due - _clock) >> shiftOf(level + 1) != 0) {
+            level++;
+        }
+        uint8_t slot = (due >> shiftOf(level)) & (SCHEDULER_WHEEL_SLOTS - 1);
+        ScheduledTask*& head = _slots[level][slot];
+        task._level = level;
+        task._slot = slot;
+        task._prev = NULL;
+        task._next = head;
+        if (head) {
+            head->_prev = &task;
+        }
+        head = &task;
+        _occupied[level] |= 1ULL << slot;
+        task._scheduled = true;
+        _count++;
+    }
+
+    void remove(ScheduledTask& task) {
+        ScheduledTask*& head = _slots[task._level][task._slot];
+        if (task._prev) {
+            task._prev->_next = task._next;
+        }
+        else head = task._next;
+        if (task._next) {
+            task._next->_prev = task._prev;
+        }
+        if (head == NULL) {
+            _occupied[task._level] &= ~(1ULL << task._slot);
+        }
+        task._next = task._prev = NULL;
+        task._scheduled = false;
+        _count--;
+    }
+
+    // Tasks of the slot reached move to finer levels, ones beyond the wheel reach back
+    void cascade(uint8_t level) {
+        uint8_t slot = (_clock >> shiftOf(level)) & (SCHEDULER_WHEEL_SLOTS - 1);
+        ScheduledTask* task = _slots[level][slot];
+        _slots[level][slot] = NULL;
+        _occupied[level] &= ~(1ULL << slot);
+        while (task) {
+            ScheduledTask* next = task->_next;
+            _count--;
+            insert(*task);
+            task = next;
+        }
+    }
+
+    void execute(ScheduledTask& task) {
+        uint32_t late = millis() - task._due;
+        uint32_t start = micros();
+        task.function();
+        uint32_t spent = micros() - start;
+        task.runs++;
+        task.microsTotal += spent;
+        task.microsMax = max(task.microsMax, spent);
+        task.lateMax = max(task.lateMax, late);
+        if (spent > task.budget) {
+            task.overruns++;
+        }
+        // periodic task keeps its phase, missed deadlines are skipped
+        if (!task._scheduled && task.period != 0) {
+            uint32_t now = millis();
+            uint32_t due = task._due + task.period;
+            if ((int32_t)(due - now) <= 0) {
+                due += ((now - due) / task.period + 1) * task.period;
+            }
+            task._due = due;
+            insert(task);
+        }
+    }
+
+    // Process tick of the wheel clock, cascades when levels turn, runs due tasks
+    void tick() {
+        for (uint8_t level = 1; level < SCHEDULER_WHEEL_LEVELS; level++) {
+            if ((_clock & ((1UL << shiftOf(level)) - 1)) != 0) {
+                break;
+            }
+            cascade(level);
+        }
+        uint8_t slot = _clock & (SCHEDULER_WHEEL_SLOTS - 1);
+        while (_slots[0][slot]) {
+            ScheduledTask& task = *_slots[0][slot];
+            remove(task);
+            execute(task);
+        }
+    }
+
+    // Next tick having tasks of the first level or turning it, not after the limit
+    uint32_t skip(uint32_t limit) const {
+        uint8_t slot = _clock & (SCHEDULER_WHEEL_SLOTS - 1);
+        uint64_t ahead = _occupied[0] >> slot;
+        uint32_t next = slot == 0 ? _clock : ahead ? _clock + __builtin_ctzll(ahead) :
+            (_clock | (SCHEDULER_WHEEL_SLOTS - 1)) + 1;
+        return (int32_t)(next - limit) > 0 ? limit : next;
+    }
+
+    public:
+    Scheduler() : _slots(), _occupied(), _tasks(NULL), _clock(0), _count(0), _running(false) {
+    }
+
+    // Run task after given delay, ms, task scheduled already is moved
+    void schedule(ScheduledTask& task, uint32_t delay = 0) {
+        if (!task._registered) {
+            task._following = _tasks;
+            task._registered = true;
+            _tasks = &task;
+        }
+        if (task._scheduled) {
+            remove(task);
+        }
+        uint32_t now = millis();
+        if (_count == 0 && !_running) {
+            _clock = now;
+        }
+        task._due = now + min(delay, (uint32_t)SCHEDULER_MAX_DELAY);
+        if ((int32_t)(task._due - _clock) < 0) {
+            task._due = _clock;
+        }
+        insert(task);
+    }
+
+    void cancel(ScheduledTask& task) {
+        if (task._scheduled) {
+            remove(task);
+        }
+    }
+
+    // Run every task due, return ms until the next deadline, the time loop may sleep
+    uint32_t run() {
+        uint32_t now = millis();
+        _running = true;
+        while (_count > 0 && (int32_t)(now - _clock) >= 0) {
+            tick();
+            _clock++;
+            _clock = skip(now + 1);
+        }
+        _running = false;
+        if (_count == 0) {
+            _clock = now + 1;
+            return SCHEDULER_IDLE_SLEEP;
+        }
+        int32_t left = (int32_t)(getNextDeadline() - millis());
+        return left > 0 ? min((uint32_t)left, (uint32_t)SCHEDULER_IDLE_SLEEP) : 0;
+    }
+
+    // Return millis() of the earliest deadline, the first occupied slot of each level
+    // holds the earliest tasks of that level
+    uint32_t getNextDeadline() const {
+        uint32_t best = _clock + SCHEDULER_MAX_DELAY;
+        for (uint8_t level = 0; level < SCHEDULER_WHEEL_LEVELS; level++) {
+            if (_occupied[level] == 0) {
+                continue;
+            }
+            // current slot of upper level holds next turn tasks once its cascade is passed
+            bool passed = (_clock & ((1UL << shiftOf(level)) - 1)) != 0;
+            uint8_t start = ((_clock >> shiftOf(level)) + (passed ? 1 : 0)) & (SCHEDULER_WHEEL_SLOTS - 1);
+            uint8_t slot = (start + __builtin_ctzll(rotate(_occupied[level], start))) & (SCHEDULER_WHEEL_SLOTS - 1);
+            for (const ScheduledTask* task = _slots[level][slot]; task; task = task->_next) {
+                if ((int32_t)(task->_due - best) < 0) {
+                    best = task->_due;
+                }
+            }
+        }
+        return best;
+    }
+
+    uint16_t getScheduledCount() const {
+        return _count;
+    }
+
+    // Return first of the tasks ever scheduled, others follow by getFollowing()
+    const ScheduledTask* getFirstTask() const {
+        return _tasks;
+    }
+
+    static const ScheduledTask* getFollowing(const ScheduledTask* task) {
+        return task->_following;
+    }
+
+    // Write task statistics as JSON object, streamed so counters of long uptime never truncate it
+    void printTo(Print& out) const {
+        JsonWriter json(out);
+        json.beginObject().key("tasks").beginArray();
+        for (const ScheduledTask* task = _tasks; task; task = task->_following) {
+            json.beginObject()
+                .member("name", task->name)
+                .member("period", task->period)
+                .member("budget", task->budget)
+                .member("runs", task->runs)
+                .member("overruns", task->overruns)
+                .member("mean", (uint32_t)(task->runs ? task->microsTotal / task->runs : 0))
+                .member("max", task->microsMax)
+                .member("late", task->lateMax)
+                .endObject();
+        }
+        json.endArray().endObject();
+    }
+};
@@ -0,0 +1,137 @@
+/******************************************************************************
+ * (c) Skatech Research Lab, 2000-2026.
+ * Last change: 2026.10.16
+ * StaticAssets class - web UI files gzipped by the build step, served with
+ * content hash ETags and cache lifetimes, revalidated by If-None-Match
+ *****************************************************************************/
+
+#pragma once
+
+#include <Arduino.h>
+#include <ESP8266WebServer.h>
+#include <FS.h>
+
+#define ASSET_MANIFEST "/assets.txt"    // lines of uri and ETag written by tools/webui.py
+#define ASSET_MAX_COUNT 8
+#define ASSET_URI_LENGTH 32
+#define ASSET_ETAG_LENGTH 16            // hex digits of the content hash
+#define ASSET_CACHE_PAGE "no-cache"     // pages are revalidated, 304 when unchanged
+#define ASSET_CACHE_VERSIONED "max-age=31536000, immutable" // referenced by ?v=ETag from pages
+
+struct StaticAsset {
+    char uri[ASSET_URI_LENGTH];
+    char etag[ASSET_ETAG_LENGTH + 3];   // quoted
+};
+
+// Assets are stored as <uri>.gz, the manifest is loaded once at boot so requests
+// cost a table lookup, unchanged ones are answered without opening the file
+class StaticAssets {
+    private:
+    StaticAsset _assets[ASSET_MAX_COUNT];
+    uint8_t _count;
+    uint32_t _sent, _notModified, _bytes;
+
+    static bool isPage(const char* uri) {
+        const char* dot = strrchr(uri, '.');
+        return dot && (strcmp(dot, ".html") == 0 || strcmp(dot, ".htm") == 0);
+    }
+
+    static const char* contentType(const char* uri) {
+        const char* dot = strrchr(uri, '.');
+        return !dot ? "application/octet-stream" : isPage(uri) ? "text/html" :
+            strcmp(dot, ".css") == 0 ? "text/css" : strcmp(dot, ".js") == 0 ? "application/javascript" :
+            strcmp(dot, ".json") == 0 ? "application/json" : strcmp(dot, ".png") == 0 ? "image/png" :
+            strcmp(dot, ".ico") == 0 ? "image/x-icon" : "application/octet-stream";
+    }
+
+    static void sendHeaders(ESP8266WebServer& server, const StaticAsset& asset) {
+        server.sendHeader("ETag", asset.etag);
+        server.sendHeader("Cache-Control", isPage(asset.uri) ? ASSET_CACHE_PAGE : ASSET_CACHE_VERSIONED);
+    }
+
+    public:
+    StaticAssets() : _count(0), _sent(0), _notModified(0), _bytes(0) {
+    }
+
+    // Read manifest, return false when missing, assets are not built then
+    bool load(FS& fs) {
+        File file = fs.open(ASSET_MANIFEST, "r");
+        if (!file) {
+            return false;
+        }
+        _count = 0;
+        char line[ASSET_URI_LENGTH + ASSET_ETAG_LENGTH + 2];
+        size_t length;
+        while (_count < ASSET_MAX_COUNT && (length = file.readBytesUntil('\n', line, sizeof(line) - 1)) > 0) {
+            line[length] = 0;
+            char* space = strchr(line, ' ');
+            if (!space || space - line >= ASSET_URI_LENGTH || strlen(space + 1) != ASSET_ETAG_LENGTH) {
+                continue;
+            }
+            StaticAsset& asset = _assets[_count++];
+            *space = 0;
+            strcpy(asset.uri, line);
+            snprintf(asset.etag, sizeof(asset.etag), "\"%s\"", space + 1);
+        }
+        file.close();
+        return _count > 0;
+    }
+
+    // Return asset of given request path, directory paths map to their index.html
+    const StaticAsset* find(const String& uri) const {
+        size_t length = uri.length();
+        bool directory = length == 0 || uri[length - 1] == '/';
+        for (uint8_t i = 0; i < _count; i++) {
+            const char* name = _assets[i].uri;
+            if (directory ? strncmp(name, uri.c_str(), length) == 0 && strcmp(name + length, "index.html") == 0 :
+                    uri == name) {
+                return &_assets[i];
+            }
+        }
+        return NULL;
+    }
+
+    // Answer current request when it is an asset, return false otherwise
+    bool handle(ESP8266WebServer& server, FS& fs) {
+        if (server.method() != HTTP_GET) {
+            return false;
+        }
+        const StaticAsset* asset = find(server.uri());
+        if (!asset) {
+            return false;
+        }
+        if (server.header("If-None-Match") == asset->etag) {
+            sendHeaders(server, *asset);
+            server.send(304);
+            _notModified++;
+            return true;
+        }
+        char path[ASSET_URI_LENGTH + 3];
+        snprintf(path, sizeof(path), "%s.gz", asset->uri);
+        File file = fs.open(path, "r");
+        if (!file) {
+            return false;
+        }
+        sendHeaders(server, *asset);
+        _bytes += server.streamFile(file, contentType(asset->uri));
+        _sent++;
+        file.close();
+        return true;
+    }
+
+    uint8_t getCount() const {
+        return _count;
+    }
+
+    uint32_t getSent() const {
+        return _sent;
+    }
+
+    uint32_t getNotModified() const {
+        return _notModified;
+    }
+
+    uint32_t getBytes() const {
+        return _bytes;
+    }
+};
@@ -0,0 +1,111 @@
+/******************************************************************************
+ * (c) Skatech Research Lab, 2000-2026.
+ * Last change: 2026.10.17
+ * TickerStrip class - off-screen pre-rendered text line for pixel scrolling
+ *****************************************************************************/
+
+#pragma once
+
+#include <Arduino.h>
+#include <U8g2lib.h>
+
+// Text is rendered once into a strip of tile rows in the SSD1306 page layout,
+// every scroll frame only copies a display wide window of strip columns
+class TickerStrip {
+    private:
+    uint8_t* _strip;
+    uint16_t _width;
+    uint8_t _tileRow, _tileRows;
+
+    public:
+    TickerStrip() : _strip(NULL), _width(0), _tileRow(0), _tileRows(0) {
+    }
+
+    ~TickerStrip() {
+        delete[] _strip;
+    }
+
+    bool isReady() const {
+        return _strip != NULL;
+    }
+
+    // Return strip width in pixels
+    uint16_t getWidth() const {
+        return _width;
+    }
+
+    void clear() {
+        delete[] _strip;
+        _strip = NULL;
+        _width = 0;
+    }
+
+    // Render text drawn at display line y into tile rows covering it, font must be selected,
+    // frame buffer is used in chunks of display width and, for a page buffer, of its tile
+    // rows, then left cleared
+    bool build(U8G2& u8g2, uint8_t y, uint8_t tileRow, uint8_t tileRows, const char* text) {
+        clear();
+        uint16_t stride = u8g2.getBufferTileWidth() * 8;
+        uint8_t rows = u8g2.getBufferTileHeight();
+        uint8_t maxCharWidth = u8g2.getMaxCharWidth();
+        _tileRow = tileRow;
+        _tileRows = tileRows;
+
+        for (const char* s = text; *s; s++) {
+            _width += u8g2.drawGlyph(0, y, (uint8_t)*s);
+        }
+        if (_width == 0) {
+            u8g2.clearBuffer();
+            return false;
+        }
+        _strip = new uint8_t[_width * _tileRows];
+        memset(_strip, 0, _width * _tileRows);
+
+        uint16_t chunk = 0;
+        for (const char* s = text; *s; ) {
+            const char* next = s;
+            uint16_t x = 0;
+            for (uint8_t first = _tileRow / rows * rows; first < _tileRow + _tileRows; first += rows) {
+                u8g2.setBufferCurrTileRow(first);
+                u8g2.clearBuffer();
+                next = s;
+                x = 0;
+                while (*next && (x == 0 || x + maxCharWidth <= stride)) {
+                    x += u8g2.drawGlyph(x, y, (uint8_t)*next++);
+                }
+                // glyph ink past the last advance is kept, next chunk continues after it
+                uint16_t columns = min((int)min(stride, (uint16_t)(x + maxCharWidth)), _width - chunk);
+                for (uint8_t row = max(first, _tileRow); row < min(first + rows, _tileRow + _tileRows); row++) {
+                    const uint8_t* source = u8g2.getBufferPtr() + (row - first) * stride;
+                    uint8_t* target = _strip + (row - _tileRow) * _width + chunk;
+                    for (uint16_t column = 0; column < columns; column++) {
+                        target[column] |= source[column];
+                    }
+                }
+            }
+            s = next;
+            chunk += x;
+        }
+        u8g2.setBufferCurrTileRow(0);
+        u8g2.clearBuffer();
+        return true;
+    }
+
+    // Copy strip window starting at given strip column into the frame buffer tile rows,
+    // columns outside the strip are left blank. Rows outside a page buffer are skipped
+    void draw(U8G2& u8g2, int16_t offset) const {
+        uint16_t stride = u8g2.getBufferTileWidth() * 8;
+        int16_t first = max(0, -offset), last = min((int)stride, _width - offset);
+        int8_t page = u8g2.getBufferCurrTileRow();
+        for (uint8_t row = 0; row < _tileRows; row++) {
+            if (_tileRow + row < page || _tileRow + row >= page + u8g2.getBufferTileHeight()) {
+                continue;
+            }
+            uint8_t* target = u8g2.getBufferPtr() + (_tileRow + row - page) * stride;
+            memset(target, 0, stride);
+            if (first < last) {
+                memcpy(target + first, _strip + row * _width + offset + first, last - first);
+            }
+        }
+    }
+};
@@ -0,0 +1,315 @@
+/******************************************************************************
+ * (c) Skatech Research Lab, 2000-2026.
+ * Last change: 2026.10.16
+ * TimeZone class - POSIX TZ rule parser with precomputed DST transition table
+ *****************************************************************************/
+
+#pragma once
+
+#include <Arduino.h>
+
+#define TIMEZONE_RULE_LENGTH 48     // characters of the rule, with terminator
+#define TIMEZONE_NAME_LENGTH 8      // characters of zone abbreviation, with terminator
+#define TIMEZONE_TABLE_YEARS 8      // years of transitions precomputed from the previous one
+#define TIMEZONE_DEFAULT_RULE "MSK-3"
+
+// Day and local time of the daylight saving start or end, POSIX forms
+// Jn (1-365, February 29 never counted), n (0-365) and Mm.w.d
+class TimeZoneDate {
+    public:
+    char type;                      // 'J', 'D' for zero based day, 'M'
+    uint8_t month, week, weekday;
+    uint16_t day;
+    int32_t time;                   // seconds since local midnight, may be negative or over a day
+};
+
+class TimeZoneTransition {
+    public:
+    time_t at;                      // UTC seconds when offset takes effect
+    int32_t offset;                 // seconds east of UTC from this moment
+    bool dst;
+};
+
+// Rule "std offset [dst [offset] [,start[/time],end[/time]]]", offsets are POSIX,
+// positive west of Greenwich, hours with optional minutes and seconds.
+// Local time conversion is a binary search in the transition table and an add
+class TimeZone {
+    private:
+    char _rule[TIMEZONE_RULE_LENGTH];
+    char _names[2][TIMEZONE_NAME_LENGTH];
+    int32_t _offsets[2];            // standard and daylight offsets, seconds east of UTC
+    TimeZoneDate _dates[2];         // daylight saving start and end
+    bool _daylight;
+    TimeZoneTransition _table[TIMEZONE_TABLE_YEARS * 2];
+    int16_t _tableYear;             // first year of the table, 0 when not built
+
+    static bool isLeap(int32_t year) {
+        return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+    }
+
+    // Return days since 1970-01-01 of the civil date
+    static int32_t daysFromCivil(int32_t year, uint8_t month, uint8_t day) {
+        year -= month <= 2;
+        int32_t era = (year >= 0 ? year : year - 399) / 400;
+        uint32_t yoe = year - era * 400;
+        uint32_t doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+        uint32_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+        return era * 146097 + (int32_t)doe - 719468;
+    }
+
+    static int32_t yearOf(time_t local) {
+        int32_t days = local >= 0 ? local / 86400 : (local - 86399) / 86400;
+        int32_t year = 1970 + days / 366;
+        while (daysFromCivil(year + 1, 1, 1) <= days) {
+            year++;
+        }
+        return year;
+    }
+
+    static const char* parseName(const char* p, char* name) {
+        uint8_t length = 0;
+        if (*p == '<') {
+            while (*++p && *p != '>') {
+                if (!isalnum(*p) && *p != '+' && *p != '-') {
+                    return NULL;
+                }
+                if (length < TIMEZONE_NAME_LENGTH - 1) {
+                    name[length++] = *p;
+                }
+            }
+            if (*p++ != '>') {
+                return NULL;
+            }
+        }
+        else while (isalpha(*p)) {
+            if (length < TIMEZONE_NAME_LENGTH - 1) {
+                name[length++] = *p;
+            }
+            p++;
+        }
+        name[length] = 0;
+        return length >= 3 ? p : NULL;
+    }
+
+    // Parse [+|-]hh[:mm[:ss]], return pointer after it or NULL
+    static const char* parseTime(const char* p, int32_t* seconds, uint8_t maxHours) {
+        int8_t sign = *p == '-' ? -1 : 1;
+        if (*p == '+' || *p == '-') {
+            p++;
+        }
+        int32_t parts[3] = { 0, 0, 0 };
+        for (uint8_t i = 0; i < 3; i++) {
+            if (!isdigit(*p)) {
+                return NULL;
+            }
+            while (isdigit(*p)) {
+                parts[i] = parts[i] * 10 + (*p++ - '0');
+                if (parts[i] > 999) {
+                    return NULL;
+                }
+            }
+            if (*p != ':' || i == 2) {
+                break;
+            }
+            p++;
+        }
+        if (parts[0] > maxHours || parts[1] > 59 || parts[2] > 59) {
+            return NULL;
+        }
+        *seconds = sign * (parts[0] * 3600 + parts[1] * 60 + parts[2]);
+        return p;
+    }
+
+    static const char* parseNumber(const char* p, uint16_t* value, uint16_t low, uint16_t high) {
+        if (!isdigit(*p)) {
+            return NULL;
+        }
+        for (*value = 0; isdigit(*p); p++) {
+            *value = *value * 10 + (*p - '0');
+            if (*value > high) {
+                return NULL;
+            }
+        }
+        return *value >= low ? p : NULL;
+    }
+
+    static const char* parseDate(const char* p, TimeZoneDate* date) {
+        uint16_t month = 0, week = 0, weekday = 0;
+        date->time = 7200;
+        date->type = *p == 'J' || *p == 'M' ? *p++ : 'D';
+        if (date->type == 'M') {
+            if (!(p = parseNumber(p, &month, 1, 12)) || *p++ != '.' ||
+                    !(p = parseNumber(p, &week, 1, 5)) || *p++ != '.' ||
+                    !(p = parseNumber(p, &weekday, 0, 6))) {
+                return NULL;
+            }
+            date->month = month; date->week = week; date->weekday = weekday;
+        }
+        else if (!(p = parseNumber(p, &date->day, date->type == 'J' ? 1 : 0, 365))) {
+            return NULL;
+        }
+        if (*p == '/') {
+            p = parseTime(p + 1, &date->time, 167);
+        }
+        return p;
+    }
+
+    // Return UTC time of the date in given year, offset in effect before transition
+    static time_t transitionTime(const TimeZoneDate& date, int32_t year, int32_t offset) {
+        int32_t days = daysFromCivil(year, 1, 1);
+        if (date.type == 'J') {
+            days += date.day - 1 + (isLeap(year) && date.day >= 60);
+        }
+        else if (date.type == 'D') {
+            days += date.day;
+        }
+        else {
+            static const uint8_t lengths[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+            int32_t first = daysFromCivil(year, date.month, 1);
+            uint8_t weekday = (first + 4) % 7;  // 1970-01-01 was Thursday
+            uint8_t day = (date.weekday + 7 - weekday) % 7 + (date.week - 1) * 7;
+            uint8_t length = lengths[date.month - 1] + (date.month == 2 && isLeap(year));
+            while (day >= length) {
+                day -= 7;
+            }
+            days = first + day;
+        }
+        return (time_t)days * 86400 + date.time - offset;
+    }
+
+    void build(int32_t year) {
+        uint8_t count = 0;
+        for (int32_t y = year; y < year + TIMEZONE_TABLE_YEARS; y++) {
+            _table[count++] = { transitionTime(_dates[0], y, _offsets[0]), _offsets[1], true };
+            _table[count++] = { transitionTime(_dates[1], y, _offsets[1]), _offsets[0], false };
+        }
+        for (uint8_t i = 1; i < count; i++) {
+            for (uint8_t j = i; j > 0 && _table[j].at < _table[j - 1].at; j--) {
+                TimeZoneTransition swap = _table[j];
+                _table[j] = _table[j - 1];
+                _table[j - 1] = swap;
+            }
+        }
+        _tableYear = year;
+    }
+
+    // Return index of the last transition not after given time, table rebuilt when outside
+    uint8_t find(time_t utc) {
+        const uint8_t last = TIMEZONE_TABLE_YEARS * 2 - 1;
+        if (_tableYear == 0 || utc < _table[0].at || utc >= _table[last].at) {
+            build(yearOf(utc + _offsets[0]) - 1);
+        }
+        uint8_t low = 0, high = last;
+        while (low < high) {
+            uint8_t middle = (low + high + 1) / 2;
+            if (_table[middle].at <= utc) {
+                low = middle;
+            }
+            else high = middle - 1;
+        }
+        return low;
+    }
+
+    public:
+    TimeZone() : _rule(), _names(), _offsets(), _dates(), _daylight(false), _table(), _tableYear(0) {
+        tryParse(TIMEZONE_DEFAULT_RULE);
+    }
+
+    // Set rule, return false and keep current one when rule is invalid
+    bool parse(const char* rule) {
+        TimeZone zone(*this);
+        if (rule == NULL || strlen(rule) >= TIMEZONE_RULE_LENGTH || !zone.tryParse(rule)) {
+            return false;
+        }
+        *this = zone;
+        return true;
+    }
+
+    const char* getRule() const {
+        return _rule;
+    }
+
+    bool hasDaylightSaving() const {
+        return _daylight;
+    }
+
+    // Return standard time offset in seconds east of UTC
+    int32_t getStandardOffset() const {
+        return _offsets[0];
+    }
+
+    const char* getName(bool dst) const {
+        return _names[dst && _daylight];
+    }
+
+    // Return offset from UTC in seconds east at given UTC time, daylight saving flag and
+    // bounds of the interval with this offset, no bound is given as 0
+    int32_t getOffset(time_t utc, bool* dst = NULL, time_t* from = NULL, time_t* until = NULL) {
+        if (!_daylight) {
+            if (dst) *dst = false;
+            if (from) *from = 0;
+            if (until) *until = 0;
+            return _offsets[0];
+        }
+        uint8_t i = find(utc);
+        if (dst) *dst = _table[i].dst;
+        if (from) *from = _table[i].at;
+        if (until) *until = _table[i + 1].at;
+        return _table[i].offset;
+    }
+
+    // Write rule of the fixed offset in seconds east of UTC, like "<+0530>-5:30"
+    static void fixedRule(char* buffer, size_t size, int32_t offset) {
+        uint32_t minutes = abs(offset) / 60;
+        char sign = offset < 0 ? '-' : '+';
+        if (minutes % 60) {
+            snprintf(buffer, size, "<%c%02u%02u>%c%u:%02u", sign, (unsigned)(minutes / 60),
+                (unsigned)(minutes % 60), sign == '+' ? '-' : '+', (unsigned)(minutes / 60), (unsigned)(minutes % 60));
+        }
+        else snprintf(buffer, size, "<%c%02u>%c%u", sign, (unsigned)(minutes / 60),
+            sign == '+' ? '-' : '+', (unsigned)(minutes / 60));
+    }
+
+    // Zone used by DateTime conversions
+    static TimeZone& local() {
+        static TimeZone zone;
+        return zone;
+    }
+
+    private:
+    bool tryParse(const char* rule) {
+        const char* p = parseName(rule, _names[0]);
+        int32_t offset;
+        if (!p || !(p = parseTime(p, &offset, 24))) {
+            return false;
+        }
+        _offsets[0] = _offsets[1] = -offset;
+        strcpy(_names[1], _names[0]);
+        _daylight = *p != 0;
+        _tableYear = 0;
+        if (_daylight) {
+            if (!(p = parseName(p, _names[1]))) {
+                return false;
+            }
+            _offsets[1] = _offsets[0] + 3600;
+            if (*p && *p != ',') {
+                if (!(p = parseTime(p, &offset, 24))) {
+                    return false;
+                }
+                _offsets[1] = -offset;
+            }
+            // rules omitted, US rules as glibc uses without posixrules file
+            if (*p == 0) {
+                p = ",M3.2.0,M11.1.0";
+            }
+            if (*p++ != ',' || !(p = parseDate(p, &_dates[0])) || *p++ != ',' || !(p = parseDate(p, &_dates[1]))) {
+                return false;
+            }
+        }
+        if (*p != 0) {
+            return false;
+        }
+        strcpy(_rule, rule);
+        return true;
+    }
+};
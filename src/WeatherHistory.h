@@ -0,0 +1,247 @@
+/******************************************************************************
+ * (c) Skatech Research Lab, 2000-2026.
+ * Last change: 2026.10.17
+ * WeatherHistory class - received weather samples appended to segment files,
+ * range queries downsampled to min/max/avg buckets
+ *****************************************************************************/
+
+#pragma once
+
+#include <Arduino.h>
+#include <FS.h>
+
+#include "JsonWriter.h"
+#include "Logger.h"
+
+#define HISTORY_DIRECTORY "/history"
+#define HISTORY_SEGMENT_SAMPLES 1024    // samples of a segment file, 8 KB, a filesystem block
+#define HISTORY_SEGMENTS 16             // segment files kept, oldest removed, 16 weeks at 10 minutes
+#define HISTORY_READ_SAMPLES 32         // samples read at once, stack buffer
+#define HISTORY_QUERY_BUCKETS 2048      // buckets of a single query, two weeks at 10 minutes
+#define HISTORY_MIN_TIME 1672531200     // 2023-01-01, samples of a clock not set are not kept
+
+#define HISTORY_FIELD_TEMPERATURE 0
+#define HISTORY_FIELD_WINDSPEED 1
+
+// Sample of received weather, 8 bytes
+struct WeatherSample {
+    uint32_t time;                      // UTC seconds, grows sample by sample
+    int16_t temperature;                // tenths of degree
+    uint8_t windspeed;                  // km/h, saturated
+    uint8_t weathercode;
+};
+
+// Segment file is named by hex UTC time of its first sample, samples follow in time
+// order, so the index of segment start times is read from the directory listing alone
+// and a query seeks to its window by binary search without reading older samples.
+// Newest segment takes samples until full, then a new one starts and the oldest goes
+class WeatherHistory {
+    private:
+    FS* _storage;
+    uint32_t _starts[HISTORY_SEGMENTS]; // first sample time of segments, oldest first
+    uint8_t _segments;
+    uint16_t _newestSamples;            // samples in the newest segment, full when its tail is torn
+    uint32_t _last;                     // time of newest sample
+    uint32_t _samples;                  // samples kept in all segments
+
+    static void segmentPath(char* path, uint32_t start) {
+        sprintf(path, HISTORY_DIRECTORY "/%08lX", (unsigned long)start);
+    }
+
+    static int32_t fieldValue(const WeatherSample& sample, uint8_t field) {
+        return field == HISTORY_FIELD_WINDSPEED ? sample.windspeed * 10 : sample.temperature;
+    }
+
+    // Values in tenths, average rounded half away from zero
+    static void writeBucket(JsonWriter& json, uint32_t start, int32_t low, int32_t high, int32_t sum, uint32_t count) {
+        int32_t half = sum < 0 ? -(int32_t)count / 2 : (int32_t)count / 2;
+        json.beginArray().value(start).value(low, 10).value(high, 10)
+            .value((sum + half) / (int32_t)count, 10).value(count).endArray();
+    }
+
+    // Return index of first sample at or after given time, samples count when none
+    static uint16_t findSample(File& file, uint16_t count, uint32_t time) {
+        uint16_t low = 0, high = count;
+        while (low < high) {
+            uint16_t middle = (low + high) / 2;
+            uint32_t at = 0;
+            file.seek(middle * sizeof(WeatherSample));
+            if (file.read((uint8_t*)&at, sizeof(at)) != sizeof(at) || at >= time) {
+                high = middle;
+            }
+            else low = middle + 1;
+        }
+        return low;
+    }
+
+    // Insert segment start keeping order, drop oldest ones past the limit
+    void insertSegment(uint32_t start) {
+        uint8_t at = _segments;
+        while (at > 0 && _starts[at - 1] > start) {
+            at--;
+        }
+        if (_segments == HISTORY_SEGMENTS) {
+            if (at == 0) {
+                removeSegment(start);
+                return;
+            }
+            removeSegment(_starts[0]);
+            memmove(_starts, _starts + 1, (HISTORY_SEGMENTS - 1) * sizeof(uint32_t));
+            _segments--;
+            at--;
+        }
+        memmove(_starts + at + 1, _starts + at, (_segments - at) * sizeof(uint32_t));
+        _starts[at] = start;
+        _segments++;
+    }
+
+    void removeSegment(uint32_t start) {
+        char path[32];
+        segmentPath(path, start);
+        File file = _storage->open(path, "r");
+        _samples -= min((uint32_t)(file.size() / sizeof(WeatherSample)), _samples);
+        file.close();
+        _storage->remove(path);
+    }
+
+    public:
+    WeatherHistory() : _storage(NULL), _segments(0), _newestSamples(0), _last(0), _samples(0) {
+    }
+
+    // Build segment index from the directory, read newest sample time only
+    bool begin(FS& storage) {
+        _storage = &storage;
+        _segments = 0;
+        _samples = 0;
+        Dir dir = storage.openDir(HISTORY_DIRECTORY);
+        while (dir.next()) {
+            char* end;
+            String name = dir.fileName();
+            uint32_t start = strtoul(name.c_str(), &end, 16);
+            if (*end == 0 && end != name.c_str()) {
+                insertSegment(start);
+            }
+        }
+        for (uint8_t i = 0; i < _segments; i++) {
+            char path[32];
+            segmentPath(path, _starts[i]);
+            File file = storage.open(path, "r");
+            uint32_t size = file.size();
+            _samples += size / sizeof(WeatherSample);
+            if (i == _segments - 1) {
+                WeatherSample sample;
+                _newestSamples = size % sizeof(WeatherSample) ? HISTORY_SEGMENT_SAMPLES : size / sizeof(WeatherSample);
+                _last = size >= sizeof(sample) && file.seek(size / sizeof(sample) * sizeof(sample) - sizeof(sample)) &&
+                    file.read((uint8_t*)&sample, sizeof(sample)) == sizeof(sample) ? sample.time : _starts[i];
+            }
+        }
+        LOG_INFO("Weather history: %u samples in %u segments", (unsigned)_samples, (unsigned)_segments);
+        return true;
+    }
+
+    // Append sample newer than the last one, segment rotated when full. Return false for a
+    // sample not kept
+    bool append(uint32_t time, float temperature, float windspeed, uint8_t weathercode) {
+        if (_storage == NULL || time < HISTORY_MIN_TIME || time <= _last) {
+            return false;
+        }
+        WeatherSample sample = { time, (int16_t)constrain(lroundf(temperature * 10), -32768L, 32767L),
+            (uint8_t)constrain(lroundf(windspeed), 0L, 255L), weathercode };
+        if (_segments == 0 || _newestSamples >= HISTORY_SEGMENT_SAMPLES) {
+            insertSegment(time);
+            _newestSamples = 0;
+        }
+        char path[32];
+        segmentPath(path, _starts[_segments - 1]);
+        File file = _storage->open(path, "a");
+        bool written = file && file.write((const uint8_t*)&sample, sizeof(sample)) == sizeof(sample);
+        file.close();
+        if (!written) {
+            _newestSamples = HISTORY_SEGMENT_SAMPLES;   // tail may be torn, next sample starts a segment
+            LOG_ERROR("Weather history append FAILED");
+            return false;
+        }
+        _newestSamples++;
+        _samples++;
+        _last = time;
+        return true;
+    }
+
+    // Write buckets of given field over from to till times as JSON, bucket of step seconds
+    // is [start, min, max, avg, samples], empty ones left out. Reads only the window
+    void query(Print& out, uint32_t from, uint32_t till, uint32_t step, uint8_t field) const {
+        JsonWriter json(out);
+        json.beginObject()
+            .member("from", from)
+            .member("till", till)
+            .member("step", step)
+            .member("field", field == HISTORY_FIELD_WINDSPEED ? "windspeed" : "temperature")
+            .key("buckets").beginArray();
+        uint8_t segment = 0;
+        while (segment + 1 < _segments && _starts[segment + 1] <= from) {
+            segment++;
+        }
+        uint32_t bucket = 0, count = 0;
+        int32_t low = 0, high = 0, sum = 0;
+        bool done = false;
+        for (; segment < _segments && _starts[segment] < till && !done; segment++) {
+            char path[32];
+            segmentPath(path, _starts[segment]);
+            File file = _storage->open(path, "r");
+            uint16_t samples = file.size() / sizeof(WeatherSample);
+            uint16_t index = _starts[segment] < from ? findSample(file, samples, from) : 0;
+            file.seek(index * sizeof(WeatherSample));
+            WeatherSample buffer[HISTORY_READ_SAMPLES];
+            while (index < samples && !done) {
+                uint16_t read = file.read((uint8_t*)buffer, min(samples - index, HISTORY_READ_SAMPLES) *
+                    sizeof(WeatherSample)) / sizeof(WeatherSample);
+                if (read == 0) {
+                    break;
+                }
+                index += read;
+                for (uint16_t i = 0; i < read; i++) {
+                    if (buffer[i].time >= till) {
+                        done = true;
+                        break;
+                    }
+                    uint32_t start = from + (buffer[i].time - from) / step * step;
+                    int32_t value = fieldValue(buffer[i], field);
+                    if (count && start != bucket) {
+                        writeBucket(json, bucket, low, high, sum, count);
+                        count = 0;
+                    }
+                    if (count == 0) {
+                        bucket = start;
+                        low = high = value;
+                        sum = 0;
+                    }
+                    low = min(low, value);
+                    high = max(high, value);
+                    sum += value;
+                    count++;
+                }
+            }
+        }
+        if (count) {
+            writeBucket(json, bucket, low, high, sum, count);
+        }
+        json.endArray().endObject();
+    }
+
+    uint32_t getSamples() const {
+        return _samples;
+    }
+
+    uint8_t getSegments() const {
+        return _segments;
+    }
+
+    // Return time of oldest sample kept, 0 none
+    uint32_t getOldest() const {
+        return _segments ? _starts[0] : 0;
+    }
+
+    uint32_t getNewest() const {
+        return _last;
+    }
+};
@@ -5,6 +5,9 @@
 
 #include "DateTime.h"
 #include "forecast.h"
+#include "GlyphCache.h"
+#include "TickerStrip.h"
+#include "Metrics.h"
 
 #ifdef U8X8_HAVE_HW_SPI
 #include <SPI.h>
@@ -16,79 +19,530 @@
 #define OLED_SCL D1
 #define OLED_SDA D2
 
+// Display bus driver, bit-banged software I2C by default. Define OLED_HW_I2C to use
+// the Wire peripheral on the same pins with OLED_I2C_CLOCK bus clock in Hz:
+// 100000 (standard), 400000 (fast mode) or 1000000 (fast mode plus).
+// OLED_PAGE_BUFFER tile rows of the frame are kept, U8g2 page buffer of 1 or 2 rows (128
+// or 256 bytes) drawn page by page at some CPU cost per frame, or 0 for the whole 1 KB frame
+#ifndef OLED_PAGE_BUFFER
+#define OLED_PAGE_BUFFER 2
+#endif
+#ifdef OLED_HW_I2C
+#ifndef OLED_I2C_CLOCK
+#define OLED_I2C_CLOCK 400000
+#endif
+#if OLED_PAGE_BUFFER == 1
+typedef U8G2_SSD1306_128X64_NONAME_1_HW_I2C OLEDDriver;
+#elif OLED_PAGE_BUFFER == 2
+typedef U8G2_SSD1306_128X64_NONAME_2_HW_I2C OLEDDriver;
+#else
+typedef U8G2_SSD1306_128X64_NONAME_F_HW_I2C OLEDDriver;
+#endif
+#else
+#if OLED_PAGE_BUFFER == 1
+typedef U8G2_SSD1306_128X64_NONAME_1_SW_I2C OLEDDriver;
+#elif OLED_PAGE_BUFFER == 2
+typedef U8G2_SSD1306_128X64_NONAME_2_SW_I2C OLEDDriver;
+#else
+typedef U8G2_SSD1306_128X64_NONAME_F_SW_I2C OLEDDriver;
+#endif
+#endif
+
+#define OLED_TILE_COLUMNS 16    // 8x8 pixel tiles per row
+#define OLED_TILE_ROWS 8
+
+#define TICKER_FRAME_RATE 10        // forecast ticker frames per second
+#define TICKER_SPEED 20             // forecast ticker scroll speed, pixels per second
+#define TICKER_DATE_SECONDS 20      // seconds to display date between ticker runs
+#define TICKER_LINE_Y (64 - 20)     // ticker and date text line top
+#define TICKER_TILE_ROW 5           // tile rows covering the text line
+#define TICKER_TILE_ROWS 3
+#define TICKER_HIDDEN INT16_MIN     // ticker offset while date shown
+
+#define OLED_SPAN_COMMAND_BYTES 6   // page and column address commands before each tile span
+
+#define SCREEN_CLOCK 0              // clock face with forecast ticker
+#define SCREEN_HOURLY 1             // hourly forecast ahead
+#define SCREEN_TREND 2              // temperature sparkline of the forecast series
+#define SCREEN_NETWORK 3            // station and time synchronization status
+#define SCREEN_COUNT 4
+#define SCREEN_INFO_SECOND 50       // second of the minute the clock face gives way to an info screen, 60 never
+#define SCREEN_LINE_HEIGHT 8        // small font text line pitch, 8 lines
+#define SCREEN_HOURS 7              // hourly forecast lines under the title
+#define SCREEN_TREND_HOURS 48       // sparkline hours
+#define SCREEN_TREND_TOP 12         // sparkline area under the title line
+#define SCREEN_TREND_HEIGHT (64 - SCREEN_TREND_TOP)
+
+// Screens take turns by the second shown, each is drawn by a const member function from
+// state set before the frame, so a page buffer replays it once per page with the same
+// result. Tiles go to the panel only when changed, told apart from those sent before by
+// 32-bit hash, 512 bytes instead of a frame copy. Tile that changed to another of equal
+// hash stays until every tile is resent, at the next minute or screen switch
 class ClockDisplay {
     private:
-    U8G2_SSD1306_128X64_NONAME_F_SW_I2C _u8g2;
+    typedef void (ClockDisplay::*ScreenDraw)(U8G2& u8g2) const;
+
+    OLEDDriver _u8g2;
+    uint8_t _brightness;
     uint32_t _colors[5];
-    String _forecast;
+    GlyphCache _clockGlyphs;
+    uint32_t _tileSums[OLED_TILE_COLUMNS * OLED_TILE_ROWS];  // hashes of tiles on the panel
+    bool _invalid;
+    uint16_t _frameBytes, _pendingBytes;
+    uint32_t _frameMicros, _frameMicrosMax, _renderMicros;
+    uint32_t _busMicros;                // bus time of tiles sent by last frame
+    uint32_t _byteNanos;                // bus time per byte, learned from frames pushed
+    TickerStrip _ticker;
+    const ForecastSeries* _series;
+    DateTime _now;
+    char _time[8], _date[12];
+    uint32_t _tickerStart, _tickerFrame;
+    int16_t _tickerOffset;
+    uint8_t _screen;
+    uint32_t _address;
+    int8_t _rssi;
+    bool _connected, _synchronized;
+    bool _prepared, _tickerEnabled;
+    Metric _renderMetric, _sendMetric;
+
+    void drawScreen() {
+        static const ScreenDraw draws[SCREEN_COUNT] = { &ClockDisplay::drawClock,
+            &ClockDisplay::drawHourly, &ClockDisplay::drawTrend, &ClockDisplay::drawNetwork };
+        (this->*draws[_screen])(_u8g2);
+    }
+
+    // FNV-1a hash of 8 tile bytes
+    static uint32_t tileHash(const uint8_t* tile) {
+        uint32_t hash = 2166136261u;
+        for (uint8_t i = 0; i < 8; i++) {
+            hash = (hash ^ tile[i]) * 16777619u;
+        }
+        return hash;
+    }
+
+    // Render current screen page by page from the page holding given tile row, or with
+    // render false take the full buffer as is, and compare its tiles with those on the
+    // panel. Changed span of every tile row is sent when asked, counted only otherwise.
+    // Return bus bytes of the spans
+    uint16_t frame(uint8_t firstRow, bool render, bool send) {
+        uint8_t rows = _u8g2.getBufferTileHeight();
+        uint16_t bytes = 0, busBytes = 0;
+        _busMicros = 0;
+        for (uint8_t page = firstRow / rows * rows; page < OLED_TILE_ROWS; page += rows) {
+            if (render) {
+                _u8g2.setBufferCurrTileRow(page);
+                _u8g2.clearBuffer();
+                drawScreen();
+            }
+            for (uint8_t ty = max(page, firstRow); ty < page + rows; ty++) {
+                uint8_t* tiles = _u8g2.getBufferPtr() + (ty - page) * OLED_TILE_COLUMNS * 8;
+                uint32_t* sent = _tileSums + ty * OLED_TILE_COLUMNS;
+                uint32_t sums[OLED_TILE_COLUMNS];
+                int8_t first = -1, last = -1;
+                for (uint8_t tx = 0; tx < OLED_TILE_COLUMNS; tx++) {
+                    sums[tx] = tileHash(tiles + tx * 8);
+                    if (_invalid || sums[tx] != sent[tx]) {
+                        if (first < 0) {
+                            first = tx;
+                        }
+                        last = tx;
+                    }
+                }
+                if (first < 0) {
+                    continue;
+                }
+                uint8_t count = last - first + 1;
+                bytes += count * 8;
+                busBytes += count * 8 + OLED_SPAN_COMMAND_BYTES;
+                if (send) {
+                    uint32_t start = micros();
+                    u8x8_DrawTile(_u8g2.getU8x8(), first, ty, count, tiles + first * 8);
+                    _busMicros += micros() - start;
+                    memcpy(sent + first, sums + first, count * sizeof(uint32_t));
+                }
+            }
+        }
+        _u8g2.setBufferCurrTileRow(0);
+        if (send) {
+            _frameBytes = bytes;
+            _invalid = _invalid && firstRow > 0;
+        }
+        return busBytes;
+    }
+
+    // Send frame of tile rows from given one, full buffer rendered by prepare() is sent as is
+    void send(uint8_t firstRow, bool render) {
+        MetricTimer timer(_sendMetric);
+        uint32_t start = micros();
+        uint16_t busBytes = frame(firstRow, render || _u8g2.getBufferTileHeight() < OLED_TILE_ROWS, true);
+        _prepared = false;
+        _frameMicros = micros() - start;
+        if (_frameMicros > _frameMicrosMax) {
+            _frameMicrosMax = _frameMicros;
+        }
+        if (busBytes > 0) {
+            uint32_t nanos = (uint64_t)_busMicros * 1000 / busBytes;
+            _byteNanos = _byteNanos ? (_byteNanos * 7 + nanos) / 8 : nanos;
+        }
+    }
 
     public:
-    ClockDisplay() : _u8g2(U8G2_R0, OLED_SCL, OLED_SDA) {
+#ifdef OLED_HW_I2C
+    ClockDisplay() : _u8g2(U8G2_R0, U8X8_PIN_NONE, OLED_SCL, OLED_SDA),
+#else
+    ClockDisplay() : _u8g2(U8G2_R0, OLED_SCL, OLED_SDA),
+#endif
+        _brightness(0), _colors(), _invalid(true), _frameBytes(0), _pendingBytes(0), _frameMicros(0), _frameMicrosMax(0),
+        _renderMicros(0), _busMicros(0), _byteNanos(0), _series(NULL), _tickerStart(0), _tickerFrame(0),
+        _tickerOffset(TICKER_HIDDEN), _screen(SCREEN_CLOCK), _address(0), _rssi(0), _connected(false),
+        _synchronized(false), _prepared(false), _tickerEnabled(true),
+        _renderMetric("display_render_seconds", "Clock face rendered into the frame buffer"),
+        _sendMetric("display_send_seconds", "Changed tiles sent to the panel") {
+        _time[0] = _date[0] = 0;
     }
 
     void initialize(uint8_t brightness, uint32_t* colors) {
+#ifdef OLED_HW_I2C
+        _u8g2.setBusClock(OLED_I2C_CLOCK);
+#endif
         _u8g2.begin();
+        setBrightnessAndColorScheme(brightness, colors);
+        _clockGlyphs.build(_u8g2, u8g2_font_logisoso32_tn, "0123456789: "); //u8g2_font_inb33_mn
+        invalidate();
+    }
+
+    // Force next update to resend whole frame
+    void invalidate() {
+        _invalid = true;
+    }
+
+    // Return count of frame bytes sent to the panel by last update
+    uint16_t getFrameBytes() const {
+        return _frameBytes;
+    }
+
+    // Return time in microseconds spent pushing last frame to the panel
+    uint32_t getFrameMicros() const {
+        return _frameMicros;
+    }
+
+    // Return RAM held for the panel, frame buffer and hashes of tiles sent
+    uint16_t getMemoryBytes() {
+        return _u8g2.getBufferTileHeight() * OLED_TILE_COLUMNS * 8 + sizeof(_tileSums);
+    }
+
+    // Run time series of frame rendering and panel updates
+    Metric& getRenderMetric() {
+        return _renderMetric;
+    }
+
+    Metric& getSendMetric() {
+        return _sendMetric;
+    }
+
+    // Return longest frame push time in microseconds since start
+    uint32_t getFrameMicrosMax() const {
+        return _frameMicrosMax;
     }
 
     void clear() {
     }
 
-    uint8_t getBrightness() {
-        return 25;
+    uint8_t getBrightness() const {
+        return _brightness;
     }
-    
+
+    // Set panel contrast, 0 to 255
     void setBrightness(uint8_t brightness) {
+        _brightness = brightness;
+        _u8g2.setContrast(brightness);
     }
 
+    // Set brightness of decimal and scheme of five colors of six hex digits each from text,
+    // return false and keep current ones when any is invalid
     bool setBrightnessAndColorScheme(String brightnessStr, String colorsStr) {
+        const char* value = brightnessStr.c_str();
+        char* end;
+        unsigned long brightness = strtoul(value, &end, 10);
+        uint8_t count = sizeof(_colors) / sizeof(uint32_t);
+        if (*value < '0' || *value > '9' || *end != 0 || brightness > 255 || colorsStr.length() != count * 6u ||
+                strspn(colorsStr.c_str(), "0123456789abcdefABCDEF") != count * 6u) {
+            return false;
+        }
+        uint32_t colors[sizeof(_colors) / sizeof(uint32_t)];
+        for (uint8_t i = 0; i < count; i++) {
+            char hex[7];
+            memcpy(hex, colorsStr.c_str() + i * 6, 6);
+            hex[6] = 0;
+            colors[i] = strtoul(hex, NULL, 16);
+        }
+        setBrightnessAndColorScheme(brightness, colors);
         return true;
     }
 
+    // Colors are kept for the web page, monochrome panel shows brightness only
+    void setBrightnessAndColorScheme(uint8_t brightness, const uint32_t* colors) {
+        memcpy(_colors, colors, sizeof(_colors));
+        setBrightness(brightness);
+    }
 
-    void setBrightnessAndColorScheme(uint8_t brightness, uint32_t* colors) {
+    void copyBrightnessAndColorScheme(uint8_t* brightness, uint32_t* colors) const {
+        *brightness = _brightness;
+        memcpy(colors, _colors, sizeof(_colors));
     }
 
-    void copyBrightnessAndColorScheme(uint8_t* brightness, uint32_t* colors) {
+    String getColorScheme() const {
+        char scheme[sizeof(_colors) / sizeof(uint32_t) * 6 + 1];
+        for (uint8_t i = 0; i < sizeof(_colors) / sizeof(uint32_t); i++) {
+            snprintf(scheme + i * 6, sizeof(scheme) - i * 6, "%06X", (unsigned)(_colors[i] & 0xFFFFFF));
+        }
+        return String(scheme);
     }
 
-    String getColorScheme() {
-        return String("0808220000443333aafe01a6001100");
+    // Screen shown at given second, clock face until SCREEN_INFO_SECOND of every minute,
+    // then info screens in turn minute by minute
+    static uint8_t screenAt(time_t second) {
+        if (second % 60 < SCREEN_INFO_SECOND) {
+            return SCREEN_CLOCK;
+        }
+        return 1 + second / 60 % (SCREEN_COUNT - 1);
+    }
+
+    uint8_t getScreen() const {
+        return _screen;
+    }
+
+    // Forecast ticker text and the series hourly and trend screens draw, kept by the caller
+    void updateForecast(const Forecast& forecast, const ForecastSeries& series) {
+        char line[FORECAST_FORMAT_BUFFER];
+        forecast.toString(line, sizeof(line));
+        _series = &series;
+        selectLineFont(_u8g2);
+        _ticker.build(_u8g2, TICKER_LINE_Y, TICKER_TILE_ROW, TICKER_TILE_ROWS, line);
+        _tickerStart = millis();
+        // nothing sent, changed tiles go with the next face or ticker frame. Strip rendering
+        // used the frame buffer, frame prepared for the coming second is rendered again
+        if (_prepared) {
+            _pendingBytes = frame(0, true, false);
+        }
     }
 
-    void updateForecast(const Forecast& forecast) {
-        _forecast = forecast.toString(); //"Weather: %W %t'C %D %Sms"
+    // Station and clock state network screen shows, drawn by the next frame
+    void updateNetwork(bool connected, uint32_t address, int32_t rssi, bool synchronized) {
+        _connected = connected;
+        _address = address;
+        _rssi = constrain(rssi, (int32_t)-128, (int32_t)127);
+        _synchronized = synchronized;
     }
 
     void update(const DateTime& now) {
-        String tms = now.toString("%H %M");
-        String tdt = now.toString("%d %b %y");
-
-        _u8g2.clearBuffer();
-        _u8g2.setFont(u8g2_font_logisoso32_tn); //u8g2_font_inb33_mn
-        _u8g2.setFontRefHeightExtendedText();
-        _u8g2.setDrawColor(1);
-        _u8g2.setFontPosTop();
-        _u8g2.setFontDirection(0);
-        _u8g2.drawStr(14, 0, tms.c_str());
-        if (now.getSecondsTotal() % 2) {
-            _u8g2.drawStr(58, 0, ":");
-        }
-
-        _u8g2.setFont(u8g2_font_crox5h_tr); // u8g2_font_crox5hb_tr
-        _u8g2.setFontRefHeightExtendedText();
-        _u8g2.setDrawColor(1);
-        _u8g2.setFontPosTop();
-        _u8g2.setFontDirection(0);
-
-        unsigned int shift = now.getSecondsTotal() % (_forecast.length() + 20); // seconds to display date
-        if (_forecast.length() > 0 && _forecast.length() > shift) {
-            if (shift > 1) {
-                String sub = _forecast.substring(shift - 2, shift - 2 + 12);
-                _u8g2.drawStr(0, 64 - 20, sub.c_str());
+        prepare(now);
+        push();
+    }
+
+    // Render frame of given time without sending it, ticker frames wait until push(). Page
+    // buffer keeps no frame, it is rendered to count tiles changed and again by push()
+    void prepare(const DateTime& now) {
+        MetricTimer timer(_renderMetric);
+        uint8_t screen = screenAt(now.getSecondsTotal());
+        if (isWhole(now.getSecondsTotal())) {
+            _screen = screen;
+            invalidate();
+        }
+        now.toString(_time, sizeof(_time), "%H %M");
+        now.toString(_date, sizeof(_date), "%d %b %y");
+        _now = now;
+        _tickerFrame = millis();
+        _tickerOffset = tickerOffset(_tickerFrame);
+
+        uint32_t start = micros();
+        _pendingBytes = frame(0, true, false);
+        _renderMicros = micros() - start;
+        _prepared = true;
+    }
+
+    bool isPrepared() const {
+        return _prepared;
+    }
+
+    // Send frame rendered by prepare()
+    void push() {
+        send(0, false);
+    }
+
+    // Return estimated time to push frame rendered, microseconds, 0 until a frame pushed
+    uint32_t estimatePushMicros() {
+        uint32_t micros = (uint64_t)_pendingBytes * _byteNanos / 1000;
+        return _u8g2.getBufferTileHeight() < OLED_TILE_ROWS && _byteNanos ? micros + _renderMicros : micros;
+    }
+
+    // Return true when frame of given second is sent whole, another screen or minute shown
+    bool isWhole(time_t second) const {
+        return screenAt(second) != _screen || second / 60 != _now.getSecondsTotal() / 60;
+    }
+
+    // Return estimated time to push whole frame when given second shows another screen or
+    // minute, microseconds, so its frame is prepared earlier
+    uint32_t estimateSwitchMicros(time_t second) const {
+        if (!isWhole(second)) {
+            return 0;
+        }
+        return (uint64_t)OLED_TILE_ROWS * (OLED_TILE_COLUMNS * 8 + OLED_SPAN_COMMAND_BYTES) * _byteNanos / 1000;
+    }
+
+    // Disabled ticker leaves date on the text line, the panel changes once a second only
+    void setTickerEnabled(bool enabled) {
+        _tickerEnabled = enabled;
+    }
+
+    // Scroll forecast ticker, can be called every loop pass, frames sent at TICKER_FRAME_RATE.
+    // Only pages of the text line are rendered
+    void animate(uint32_t ms) {
+        if (_prepared || _screen != SCREEN_CLOCK || ms - _tickerFrame < 1000 / TICKER_FRAME_RATE) {
+            return;
+        }
+        int16_t offset = tickerOffset(ms);
+        if (offset == TICKER_HIDDEN && _tickerOffset == TICKER_HIDDEN) {
+            return; // date shown, changes only by update
+        }
+        _tickerFrame = ms;
+        _tickerOffset = offset;
+        send(_invalid ? 0 : TICKER_TILE_ROW, true);
+    }
+
+    private:
+    static void selectLineFont(U8G2& u8g2) {
+        u8g2.setFont(u8g2_font_crox5h_tr); // u8g2_font_crox5hb_tr
+        u8g2.setFontRefHeightExtendedText();
+        u8g2.setDrawColor(1);
+        u8g2.setFontPosTop();
+        u8g2.setFontDirection(0);
+    }
+
+    static void selectSmallFont(U8G2& u8g2) {
+        u8g2.setFont(u8g2_font_5x7_tr);
+        u8g2.setFontRefHeightExtendedText();
+        u8g2.setDrawColor(1);
+        u8g2.setFontPosTop();
+        u8g2.setFontDirection(0);
+    }
+
+    // Return true when display lines from y of given height cross the page buffered
+    static bool onPage(U8G2& u8g2, int16_t y, int16_t height) {
+        int16_t top = u8g2.getBufferCurrTileRow() * 8;
+        return y < top + u8g2.getBufferTileHeight() * 8 && y + height > top;
+    }
+
+    // Draw small font text at given line, skipped off the page
+    static void drawText(U8G2& u8g2, uint8_t line, const char* text) {
+        if (onPage(u8g2, line * SCREEN_LINE_HEIGHT, SCREEN_LINE_HEIGHT)) {
+            u8g2.drawStr(0, line * SCREEN_LINE_HEIGHT, text);
+        }
+    }
+
+    // Ticker runs in from the right edge until it leaves at the left one, then date is shown
+    // for TICKER_DATE_SECONDS, return strip column at display left edge or TICKER_HIDDEN
+    int16_t tickerOffset(uint32_t ms) const {
+        if (!_tickerEnabled || !_ticker.isReady()) {
+            return TICKER_HIDDEN;
+        }
+        uint32_t run = (uint32_t)(_ticker.getWidth() + OLED_TILE_COLUMNS * 8) * 1000 / TICKER_SPEED;
+        uint32_t position = (ms - _tickerStart) % (run + TICKER_DATE_SECONDS * 1000);
+        if (position >= run) {
+            return TICKER_HIDDEN;
+        }
+        return position * TICKER_SPEED / 1000 - OLED_TILE_COLUMNS * 8;
+    }
+
+    // Clock digits, ticker window or date on the text line
+    void drawClock(U8G2& u8g2) const {
+        _clockGlyphs.drawStr(u8g2, 14, 0, _time);
+        if (_now.getSecondsTotal() % 2) {
+            _clockGlyphs.drawStr(u8g2, 58, 0, ":");
+        }
+        if (_tickerOffset != TICKER_HIDDEN) {
+            _ticker.draw(u8g2, _tickerOffset);
+        }
+        else if (onPage(u8g2, TICKER_LINE_Y, TICKER_TILE_ROWS * 8)) {
+            selectLineFont(u8g2);
+            u8g2.drawStr(10, TICKER_LINE_Y, _date);
+        }
+    }
+
+    // Local time, temperature and wind of the hours ahead, current one first
+    void drawHourly(U8G2& u8g2) const {
+        selectSmallFont(u8g2);
+        drawText(u8g2, 0, "Hourly forecast");
+        time_t hour = _now.getSecondsTotal() / 3600 * 3600;
+        uint8_t lines = 0;
+        for (; lines < SCREEN_HOURS; lines++) {
+            const ForecastHour* record = _series ? _series->at(hour + lines * 3600) : NULL;
+            if (record == NULL) {
+                break;
             }
+            if (!onPage(u8g2, (lines + 1) * SCREEN_LINE_HEIGHT, SCREEN_LINE_HEIGHT)) {
+                continue;
+            }
+            time_t local = hour + lines * 3600;
+            local += TimeZone::local().getOffset(local);
+            char line[32];
+            snprintf(line, sizeof(line), "%02d:%02d %5.1f C %3.0f km/h", (int)(local / 3600 % 24),
+                (int)(local / 60 % 60), record->getTemperature(), record->getWindSpeed());
+            drawText(u8g2, lines + 1, line);
+        }
+        if (lines == 0) {
+            drawText(u8g2, 2, "No forecast");
         }
-        else _u8g2.drawStr(10, 64 - 20, tdt.c_str());
+    }
 
-        _u8g2.sendBuffer();
+    // Temperature of the hours ahead as a line over the range it spans
+    void drawTrend(U8G2& u8g2) const {
+        selectSmallFont(u8g2);
+        time_t hour = _now.getSecondsTotal() / 3600 * 3600;
+        uint8_t hours = _series ? min((int)_series->hoursAhead(hour), SCREEN_TREND_HOURS) : 0;
+        if (hours < 2) {
+            drawText(u8g2, 0, "Temperature");
+            drawText(u8g2, 2, "No forecast");
+            return;
+        }
+        float low = _series->at(hour)->getTemperature(), high = low;
+        for (uint8_t i = 1; i < hours; i++) {
+            float value = _series->at(hour + i * 3600)->getTemperature();
+            low = min(low, value);
+            high = max(high, value);
+        }
+        char line[32];
+        snprintf(line, sizeof(line), "Next %uh %.1f .. %.1f C", hours, low, high);
+        drawText(u8g2, 0, line);
+
+        float scale = high > low ? (SCREEN_TREND_HEIGHT - 1) / (high - low) : 0;
+        int16_t x = 0, y = SCREEN_TREND_TOP + SCREEN_TREND_HEIGHT - 1;
+        y -= lroundf((_series->at(hour)->getTemperature() - low) * scale);
+        for (uint8_t i = 1; i < hours; i++) {
+            int16_t nextX = i * (u8g2.getDisplayWidth() - 1) / (hours - 1);
+            int16_t nextY = SCREEN_TREND_TOP + SCREEN_TREND_HEIGHT - 1 -
+                lroundf((_series->at(hour + i * 3600)->getTemperature() - low) * scale);
+            if (onPage(u8g2, min(y, nextY), abs(nextY - y) + 1)) {
+                u8g2.drawLine(x, y, nextX, nextY);
+            }
+            x = nextX;
+            y = nextY;
+        }
+    }
+
+    // Station connection, address and signal, clock synchronization
+    void drawNetwork(U8G2& u8g2) const {
+        selectSmallFont(u8g2);
+        drawText(u8g2, 0, "Network");
+        drawText(u8g2, 2, _connected ? "Station connected" : "Station disconnected");
+        char line[32];
+        if (_connected) {
+            snprintf(line, sizeof(line), "IP %u.%u.%u.%u", (unsigned)(_address & 0xFF),
+                (unsigned)(_address >> 8 & 0xFF), (unsigned)(_address >> 16 & 0xFF), (unsigned)(_address >> 24));
+            drawText(u8g2, 3, line);
+            snprintf(line, sizeof(line), "Signal %d dBm", _rssi);
+            drawText(u8g2, 4, line);
+        }
+        drawText(u8g2, 6, _synchronized ? "Time synchronized" : "Time not synchronized");
     }
-};
\ No newline at end of file
+};
@@ -1,6 +1,6 @@
 /******************************************************************************
  * (c) Skatech Research Lab, 2000-2023.
- * Last change: 2023.01.01
+ * Last change: 2026.10.17
  * open-meteo.com forecast service interaction functions
  *****************************************************************************/
 
@@ -9,9 +9,27 @@
 #include <Arduino.h>
 #include <ESP8266WiFi.h>
 #include <ESP8266HTTPClient.h>
+#include <lwip/dns.h>
+#include <FS.h>
+
+#include "JsonStream.h"
+#include "ForecastFormat.h"
+#include "ForecastSeries.h"
+#include "Metrics.h"
+#include "Logger.h"
+#include "configuration.h"
 
 #define MINIMAL_REQUEST_REPEAT_PERIOD 60      // seconds between service request attempts 
 #define DEFAULT_WEATHER_UPDATE_PERIOD 1800    // seconds between forecast updates by default
+#define FORECAST_FETCH_TIMEOUT 10000          // milliseconds to receive whole response since request start
+#define FORECAST_CONNECT_TIMEOUT 500          // milliseconds of blocking TCP connect, shorter than a clock second
+#define FORECAST_STEP_BUDGET 2000             // microseconds of work per pull() call while fetching
+#define FORECAST_HOST "api.open-meteo.com"
+#define FORECAST_SNAPSHOT_FILE "/forecast.bin"
+#define FORECAST_SNAPSHOT_FORMAT 0x0100
+#define FORECAST_SNAPSHOT_PERIOD 3600         // seconds between snapshot writes, limits flash wear
+#define FORECAST_SNAPSHOT_MAX_AGE 10800       // seconds restored forecast is shown after reboot
+#define FORECAST_FORMAT_BUFFER 256            // characters of formatted forecast string
 
 class Forecast {
     private:
@@ -21,6 +39,9 @@ class Forecast {
     friend class ForecastProvider;
 
     public:
+    Forecast() : _timestamp(0), _temperature(0), _windspeed(0), _winddir(0), _weathercode(0) {
+    }
+
     time_t getTimestamp() const {
         return _timestamp;
     }
@@ -45,50 +66,77 @@ class Forecast {
         return getWeatherCodeDescription(_weathercode);
     }
 
-    /* Return weather custom formatted string, options:
+    u8 getWeatherCode() const {
+        return _weathercode;
+    }
+
+    /* Print weather formatted by compiled format, options:
     %m     - Timestamp in seconds since January 1, 1970
     %W, %w - Weather description, weather code
     %t     - Temperature, Celsius
     %S, %s - Wind speed in km/h, wind speed in m/s
     %d     - Wind direction
     %E, %e - Wind world side full, wind world side short */
-    String toString(const char* format = "%W, %t'C, wind %E %sm/s") const {
-        String builder(format);
-        while (builder.indexOf("%m") >= 0) {
-            builder.replace("%m", String(_timestamp));
-        }
-        while (builder.indexOf("%w") >= 0) {
-            builder.replace("%w", String(_weathercode));
-        }
-        while (builder.indexOf("%W") >= 0) {
-            builder.replace("%W", getWeatherCodeDescription(_weathercode));
-        }
-        while (builder.indexOf("%t") >= 0) {
-            builder.replace("%t", String(_temperature, 1));
-        }
-        while (builder.indexOf("%s") >= 0) {
-            builder.replace("%s", String(_windspeed / 3.6F, 1));
-        }
-        while (builder.indexOf("%S") >= 0) {
-            builder.replace("%S", String(_windspeed, 1));
-        }
-        while (builder.indexOf("%d") >= 0) {
-            builder.replace("%d", String(_winddir, 1));
-        }
-        while (builder.indexOf("%e") >= 0) {
-            builder.replace("%e", getWorldSide(_winddir, true));
-        }
-        while (builder.indexOf("%E") >= 0) {
-            builder.replace("%E", getWorldSide(_winddir, false));
+    size_t printTo(Print& out, const ForecastFormat& format = ForecastFormat::text()) const {
+        size_t count = 0;
+        for (uint8_t i = 0; i < format.getCount(); i++) {
+            const ForecastFormatToken& token = format.getToken(i);
+            switch (token.field) {
+                case 0: count += out.write(format.getLiteral(token), token.length); break;
+                case 'm': count += printNumber(out, _timestamp, false); break;
+                case 'w': count += printNumber(out, _weathercode, false); break;
+                case 'W': count += out.write(getWeatherCodeDescription(_weathercode)); break;
+                case 't': count += printNumber(out, _temperature, true); break;
+                case 's': count += printNumber(out, _windspeed / 3.6F, true); break;
+                case 'S': count += printNumber(out, _windspeed, true); break;
+                case 'd': count += printNumber(out, _winddir, true); break;
+                case 'e': count += out.write(getWorldSide(_winddir, true)); break;
+                case 'E': count += out.write(getWorldSide(_winddir, false)); break;
+            }
         }
-        return builder;
+        return count;
     }
 
+    // Format into given buffer, truncated to its size, return formatted string length
+    size_t toString(char* buffer, size_t size, const ForecastFormat& format = ForecastFormat::text()) const {
+        BufferPrint out(buffer, size);
+        printTo(out, format);
+        return out.length();
+    }
+
+    // Return weather custom formatted string, format options as for printTo()
+    String toString(const char* format = FORECAST_FORMAT_TEXT) const {
+        char buffer[FORECAST_FORMAT_BUFFER];
+        toString(buffer, sizeof(buffer), ForecastFormat(format));
+        return String(buffer);
+    }
 
     String toJSONString() const {
-        return toString("{\"timeStamp\":%m, \"weatherCode\":%w, \"weatherDescription\":\"%W\", \"temperatureCelsius\":%t, \"windSpeed\":%s, \"windDirection\":%d, \"windDirectionSide\":\"%E\", \"windDirectionSideShort\":\"%e\"}");
+        char buffer[FORECAST_FORMAT_BUFFER];
+        toString(buffer, sizeof(buffer), ForecastFormat::json());
+        return String(buffer);
     }
-    
+
+    // Print integer or value with one decimal digit as String(value, 1) does, no heap
+    static size_t printNumber(Print& out, double value, bool decimal) {
+        char digits[24];
+        char* p = digits + sizeof(digits);
+        unsigned long long number = llround(fabs(value) * (decimal ? 10 : 1));
+        if (decimal) {
+            *--p = '0' + number % 10;
+            *--p = '.';
+            number /= 10;
+        }
+        do {
+            *--p = '0' + number % 10;
+            number /= 10;
+        } while (number);
+        if (value < 0) {
+            *--p = '-';
+        }
+        return out.write(p, digits + sizeof(digits) - p);
+    }
+
     static const char* getWorldSide(float direction, bool shortcut) {
         switch ((int)(direction + 22.5F + 360.0F) % 360 / 45) {
             case 0: return shortcut ? "N"  : "North";
@@ -138,15 +186,242 @@ class Forecast {
     }
 };
 
-class ForecastProvider {
+#define FORECAST_FIELD_TEMPERATURE 0x01
+#define FORECAST_FIELD_WINDSPEED   0x02
+#define FORECAST_FIELD_WINDDIR     0x04
+#define FORECAST_FIELD_WEATHERCODE 0x08
+#define FORECAST_FIELDS_ALL        0x0F
+
+// Snapshot file header, followed by Forecast and ForecastSeries images
+struct ForecastSnapshotHeader {
+    uint16_t crc16;                     // checksum of both images
+    uint16_t format;                    // snapshot format version
+    uint16_t size;                      // images size, changes with the layout
+};
+
+// Fetch progress, phases follow in order
+enum ForecastFetchPhase : uint8_t {
+    FETCH_IDLE, FETCH_RESOLVE, FETCH_CONNECT, FETCH_SEND, FETCH_HEADERS, FETCH_BODY, FETCH_PHASES
+};
+
+class ForecastProvider : public JsonListener {
     private:
-    Forecast _forecast;
+    Forecast _forecast, _received;
+    ForecastSeries _series;
+    uint8_t _receivedFields;
     float _latitude, _longitude;
     time_t _request;
     uint32_t _period;
+    bool _expired;                      // forecast due regardless of its age
+
+    WiFiClient _client;
+    JsonStreamParser _parser;
+    ForecastFetchPhase _phase;
+    volatile bool _resolved;            // set from resolver callback
+    IPAddress _address;
+    uint32_t _fetchStart, _phaseStart;
+    uint32_t _phaseMillis[FETCH_PHASES];
+    uint32_t _stepMicrosMax;
+    int16_t _status;                    // HTTP status code, 0 until status line received
+    uint8_t _lineLength;
+    char _line[16];                     // start of the current header line, enough for status
+
+    FS* _storage;
+    time_t _stored;                     // timestamp of forecast in the snapshot
+    bool _storePending, _restored;      // restored forecast waits for the clock to pass its timestamp
+    Metric _stepMetric;
+    Metric _phaseMetrics[FETCH_PHASES - 1]; // resolve to body
+
+    // Collect current weather fields and hourly series in any order, other response content is skipped
+    void onJsonValue(const JsonPath& path, const char* value, bool string) override {
+        if (string) {
+            return;
+        }
+        if (path.depth == 3 && strcmp(path.key(2), "hourly") == 0) {
+            _series.set(path.key(1), path.index(), value);
+            return;
+        }
+        if (path.depth != 2 || strcmp(path.key(1), "current_weather") != 0) {
+            return;
+        }
+        const char* key = path.key();
+        if (strcmp(key, "temperature") == 0) {
+            _received._temperature = atof(value);
+            _receivedFields |= FORECAST_FIELD_TEMPERATURE;
+        }
+        else if (strcmp(key, "windspeed") == 0) {
+            _received._windspeed = atof(value);
+            _receivedFields |= FORECAST_FIELD_WINDSPEED;
+        }
+        else if (strcmp(key, "winddirection") == 0) {
+            _received._winddir = atof(value);
+            _receivedFields |= FORECAST_FIELD_WINDDIR;
+        }
+        else if (strcmp(key, "weathercode") == 0) {
+            _received._weathercode = atoi(value);
+            _receivedFields |= FORECAST_FIELD_WEATHERCODE;
+        }
+    }
+
+    static void onResolved(const char* name, const ip_addr_t* address, void* provider) {
+        ForecastProvider* self = (ForecastProvider*)provider;
+        if (self->_phase == FETCH_RESOLVE) {
+            self->_address = address ? IPAddress(address) : IPAddress();
+            self->_resolved = true;
+        }
+    }
+
+    void enter(ForecastFetchPhase phase) {
+        uint32_t now = millis();
+        _phaseMillis[_phase] = now - _phaseStart;
+        if (_phase != FETCH_IDLE) {
+            _phaseMetrics[_phase - 1].record(_phaseMillis[_phase] * 1000);
+        }
+        _phaseStart = now;
+        _phase = phase;
+    }
+
+    bool fail(const char* reason) {
+        LOG_WARN("Forecast fetch FAILED: %s, phase %s, status %d", reason, getPhaseName(_phase), _status);
+        _client.stop();
+        enter(FETCH_IDLE);
+        return false;
+    }
+
+    bool resolve() {
+        if (!_resolved) {
+            return false;
+        }
+        if (uint32_t(_address) == 0) {
+            return fail("Host not resolved");
+        }
+        enter(FETCH_CONNECT);
+        return false;
+    }
+
+    // TCP connect of the ESP8266 core has no asynchronous form, blocking time is
+    // bounded by the client timeout so the clock is updated next second anyway
+    bool connect() {
+        _client.setTimeout(FORECAST_CONNECT_TIMEOUT);
+        if (!_client.connect(_address, 80)) {
+            return fail("Connection failed");
+        }
+        _client.setNoDelay(true);
+        enter(FETCH_SEND);
+        return false;
+    }
+
+    // HTTP/1.0 gives plain body, no chunked transfer encoding
+    bool send() {
+        char request[320];
+        int length = snprintf(request, sizeof(request),
+            "GET /v1/forecast?latitude=%.2f&longitude=%.2f&current_weather=true%s HTTP/1.0\r\n"
+            "Host: " FORECAST_HOST "\r\nConnection: close\r\n\r\n", _latitude, _longitude,
+            ForecastSeries::getRequestParameters());
+        if (_client.write((const uint8_t*)request, length) != (size_t)length) {
+            return fail("Send header failed");
+        }
+        _lineLength = 0;
+        enter(FETCH_HEADERS);
+        return false;
+    }
+
+    // Parse status line, skip other headers up to empty line
+    bool headers(uint32_t start) {
+        while (_client.available() > 0 && micros() - start < FORECAST_STEP_BUDGET) {
+            char c = _client.read();
+            if (c == '\r') {
+                continue;
+            }
+            if (c != '\n') {
+                if (_lineLength < sizeof(_line) - 1) {
+                    _line[_lineLength] = c;
+                }
+                _lineLength++;
+                continue;
+            }
+            _line[min(_lineLength, (uint8_t)(sizeof(_line) - 1))] = 0;
+            bool empty = _lineLength == 0;
+            _lineLength = 0;
+            if (_status == 0) {
+                if (strncmp(_line, "HTTP/1.", 7) != 0 || (_status = atoi(_line + 9)) != HTTP_CODE_OK) {
+                    return fail("Unexpected response");
+                }
+            }
+            else if (empty) {
+                _parser.reset();
+                _series.begin(_request);
+                _receivedFields = 0;
+                enter(FETCH_BODY);
+                return body(start);
+            }
+        }
+        if (!_client.connected()) {
+            return fail("Connection lost");
+        }
+        return false;
+    }
+
+    // Parse body straight from the stream in small chunks while step budget allows
+    bool body(uint32_t start) {
+        char chunk[64];
+        int available;
+        while ((available = _client.available()) > 0 && micros() - start < FORECAST_STEP_BUDGET) {
+            size_t count = _client.readBytes(chunk, min((size_t)available, sizeof(chunk)));
+            if (!_parser.feed(chunk, count)) {
+                return fail("Invalid data format");
+            }
+            if (_parser.isComplete()) {
+                break;
+            }
+        }
+        if (!_parser.isComplete() && _client.connected()) {
+            return false;
+        }
+        if (!_parser.finish() || _receivedFields != FORECAST_FIELDS_ALL) {
+            return fail("Invalid data format");
+        }
+        _client.stop();
+        enter(FETCH_IDLE);
+        _forecast = _received;
+        _forecast._timestamp = _request;
+        _restored = false;
+        if (_series.end()) {
+            LOG_INFO("Forecast updated");
+        }
+        else LOG_INFO("Forecast updated, no hourly series");
+        _storePending = _storage && _forecast._timestamp >= _stored + FORECAST_SNAPSHOT_PERIOD;
+        return true;
+    }
+
+    bool step() {
+        uint32_t start = micros();
+        if (millis() - _fetchStart > FORECAST_FETCH_TIMEOUT) {
+            return fail("Timeout");
+        }
+        switch (_phase) {
+            case FETCH_RESOLVE: return resolve();
+            case FETCH_CONNECT: return connect();
+            case FETCH_SEND: return send();
+            case FETCH_HEADERS: return headers(start);
+            case FETCH_BODY: return body(start);
+            default: return false;
+        }
+    }
 
     public:
-    ForecastProvider(float latitude, float longitude, uint32_t updatePeriod = DEFAULT_WEATHER_UPDATE_PERIOD) {
+    ForecastProvider(float latitude, float longitude, uint32_t updatePeriod = DEFAULT_WEATHER_UPDATE_PERIOD)
+            : _receivedFields(0), _request(0), _expired(false), _parser(this), _phase(FETCH_IDLE), _resolved(false),
+            _fetchStart(0), _phaseStart(0), _stepMicrosMax(0), _status(0), _lineLength(0),
+            _storage(NULL), _stored(0), _storePending(false), _restored(false),
+            _stepMetric("forecast_step_seconds", "Forecast fetch step run time"),
+            _phaseMetrics{
+                { "forecast_phase_seconds", "Forecast fetch phase duration", "phase=\"resolve\"" },
+                { "forecast_phase_seconds", "Forecast fetch phase duration", "phase=\"connect\"" },
+                { "forecast_phase_seconds", "Forecast fetch phase duration", "phase=\"send\"" },
+                { "forecast_phase_seconds", "Forecast fetch phase duration", "phase=\"headers\"" },
+                { "forecast_phase_seconds", "Forecast fetch phase duration", "phase=\"body\"" } } {
+        memset(_phaseMillis, 0, sizeof(_phaseMillis));
         initialize(latitude, longitude, updatePeriod);
     }
 
@@ -156,63 +431,201 @@ class ForecastProvider {
 
     // Return true when current forecast fresher than given period in seconds
     bool hasForecastFor(uint32_t lastSeconds) const {
-        return _forecast._timestamp > 0 && (_forecast._timestamp + lastSeconds > time(NULL));
+        return _forecast._timestamp > 0 && !_restored && (_forecast._timestamp + lastSeconds > time(NULL));
+    }
+
+    // Load forecast snapshot saved before reboot and keep storage for later snapshots,
+    // restored forecast is used once clock is past its timestamp, so unsynced clock is not
+    // trusted, no fetch starts before that
+    bool restore(FS& storage) {
+        _storage = &storage;
+        File file = storage.open(FORECAST_SNAPSHOT_FILE, "r");
+        if (!file) {
+            LOG_INFO("Forecast snapshot not found");
+            return false;
+        }
+        ForecastSnapshotHeader header;
+        Forecast forecast;
+        ForecastSeries series;
+        bool complete = file.read((uint8_t*)&header, sizeof(header)) == sizeof(header) &&
+            file.read((uint8_t*)&forecast, sizeof(forecast)) == sizeof(forecast) &&
+            file.read((uint8_t*)&series, sizeof(series)) == sizeof(series);
+        file.close();
+
+        if (!complete || header.format != FORECAST_SNAPSHOT_FORMAT || header.size != sizeof(forecast) + sizeof(series)) {
+            LOG_WARN("Forecast snapshot load failed (version mismatch)");
+            return false;
+        }
+        uint16_t crc = Configuration::crc16((const uint8_t*)&forecast, sizeof(forecast));
+        if (header.crc16 != Configuration::crc16((const uint8_t*)&series, sizeof(series), crc)) {
+            LOG_WARN("Forecast snapshot load failed (invalid checksum)");
+            return false;
+        }
+        _forecast = forecast;
+        _series = series;
+        _stored = forecast._timestamp;
+        _restored = true;
+        LOG_INFO("Forecast snapshot loaded");
+        return true;
+    }
+
+    // Write snapshot of current forecast, new file replaces old one only when complete
+    bool store() {
+        _storePending = false;
+        if (_storage == NULL) {
+            return false;
+        }
+        ForecastSnapshotHeader header = { 0, FORECAST_SNAPSHOT_FORMAT, sizeof(Forecast) + sizeof(ForecastSeries) };
+        header.crc16 = Configuration::crc16((const uint8_t*)&_series, sizeof(_series),
+            Configuration::crc16((const uint8_t*)&_forecast, sizeof(_forecast)));
+        File file = _storage->open(FORECAST_SNAPSHOT_FILE ".tmp", "w");
+        bool written = file &&
+            file.write((const uint8_t*)&header, sizeof(header)) == sizeof(header) &&
+            file.write((const uint8_t*)&_forecast, sizeof(_forecast)) == sizeof(_forecast) &&
+            file.write((const uint8_t*)&_series, sizeof(_series)) == sizeof(_series);
+        file.close();
+        if (!written || !_storage->rename(FORECAST_SNAPSHOT_FILE ".tmp", FORECAST_SNAPSHOT_FILE)) {
+            LOG_ERROR("Forecast snapshot save FAILED");
+            return false;
+        }
+        _stored = _forecast._timestamp;
+        return true;
     }
 
     const Forecast& getForecast() const {
         return _forecast;
     }
 
-    // Can be called every tick to check where forecast outdated and refresh
+    // Return hourly forecast ahead, refreshed by every fetch
+    const ForecastSeries& getSeries() const {
+        return _series;
+    }
+
+    bool isFetching() const {
+        return _phase != FETCH_IDLE;
+    }
+
+    ForecastFetchPhase getPhase() const {
+        return _phase;
+    }
+
+    // Return duration of given phase of the last fetch reached it, milliseconds
+    uint32_t getPhaseMillis(ForecastFetchPhase phase) const {
+        return _phaseMillis[phase];
+    }
+
+    // Run time series of pull() calls while fetching
+    Metric& getStepMetric() {
+        return _stepMetric;
+    }
+
+    // Duration series of given fetch phase, FETCH_RESOLVE to FETCH_BODY
+    Metric& getPhaseMetric(ForecastFetchPhase phase) {
+        return _phaseMetrics[phase - 1];
+    }
+
+    // Return longest single pull() call while fetching, microseconds
+    uint32_t getStepMicrosMax() const {
+        return _stepMicrosMax;
+    }
+
+    static const char* getPhaseName(ForecastFetchPhase phase) {
+        switch (phase) {
+            case FETCH_IDLE: return "idle";
+            case FETCH_RESOLVE: return "resolve";
+            case FETCH_CONNECT: return "connect";
+            case FETCH_SEND: return "send";
+            case FETCH_HEADERS: return "headers";
+            case FETCH_BODY: return "body";
+            default: return "";
+        }
+    }
+
+    // Make forecast due, next pull() starts a fetch once connected, current forecast kept
+    // until a new one received
+    void expire() {
+        _expired = true;
+        _request = 0;
+    }
+
+    // Return ms until pull() has work, 0 while fetching or snapshot store pending
+    uint32_t getPullDelay() const {
+        if (_phase != FETCH_IDLE || _storePending) {
+            return 0;
+        }
+        time_t now = time(NULL);
+        time_t due = _request + MINIMAL_REQUEST_REPEAT_PERIOD;
+        if (_restored) {
+            due = _forecast._timestamp;
+        }
+        else if (_forecast._timestamp > 0 && !_expired) {
+            due = max(due, _forecast._timestamp + (time_t)_period);
+        }
+        return due > now ? (uint32_t)min(due - now, (time_t)86400) * 1000 : 0;
+    }
+
+    // Should be called every loop iteration, starts fetch when forecast outdated and
+    // advances it by a step of limited time, never waits for the network
     // Return true only when new forecast received, otherwise false
     bool pull() {
-        if (WiFi.status() != WL_CONNECTED) {
+        if (_phase != FETCH_IDLE) {
+            uint32_t start = micros();
+            bool received = step();
+            uint32_t spent = micros() - start;
+            _stepMicrosMax = max(_stepMicrosMax, spent);
+            _stepMetric.record(spent);
+            return received;
+        }
+
+        // snapshot written by separate call, fetch step stays short
+        if (_storePending) {
+            store();
             return false;
         }
 
+        // clock behind restored snapshot is not synchronized yet, fetch stamped by it would
+        // lose the snapshot and repeat once synchronized, whole site rebooting calls API then
         time_t now = time(NULL);
-        if (_request + MINIMAL_REQUEST_REPEAT_PERIOD > now) {
+        if (_restored) {
+            if (now < _forecast._timestamp) {
+                return false;
+            }
+            _restored = false;
+            if (_forecast._timestamp + FORECAST_SNAPSHOT_MAX_AGE > now) {
+                return true;
+            }
+            _forecast._timestamp = 0;
+        }
+
+        if (WiFi.status() != WL_CONNECTED) {
             return false;
         }
 
-        if (_forecast._timestamp > 0 && (_forecast._timestamp + _period > now)) {
+        if (_request + MINIMAL_REQUEST_REPEAT_PERIOD > now) {
             return false;
         }
-        
-        _request = now;
-        WiFiClient wifi;
-        HTTPClient http;
-        Serial.print("Forecast updating... ");
-
-        String request("http://api.open-meteo.com/v1/forecast?latitude={LAT}&longitude={LON}&current_weather=true");
-        request.replace("{LAT}", String(_latitude));
-        request.replace("{LON}", String(_longitude));
-        http.begin(wifi, request);
-
-        u32 code = http.GET();
-        if(code == HTTP_CODE_OK) {
-            String data = http.getString();
-            const char* wdata = strstr(data.c_str(), "{\"temperature\":");    
-            float temperature, windspeed, winddir;
-            int weathercode;
-
-            if (wdata && sscanf(wdata,
-                    "{\"temperature\":%f,\"windspeed\":%f,\"winddirection\":%f,\"weathercode\":%d}",
-                    &temperature, &windspeed, &winddir, &weathercode) == 4) {
-                _forecast._temperature = temperature;
-                _forecast._windspeed = windspeed;
-                _forecast._winddir = winddir;
-                _forecast._weathercode = weathercode;
-                _forecast._timestamp = now;
-                Serial.println("OK");
-                return true;
-            }
 
-            Serial.println("FAIL: Invalid data format");
+        if (_forecast._timestamp > 0 && !_expired && (_forecast._timestamp + _period > now)) {
             return false;
         }
 
-        Serial.printf("FAIL: (%d) %s\n", code, http.errorToString(code).c_str());
+        _request = now;
+        _expired = false;
+        LOG_DEBUG("Forecast updating");
+        _fetchStart = _phaseStart = millis();
+        memset(_phaseMillis, 0, sizeof(_phaseMillis));
+        _stepMicrosMax = 0;
+        _phase = FETCH_RESOLVE;
+        _resolved = false;
+        _status = 0;
+        ip_addr_t address;
+        err_t error = dns_gethostbyname(FORECAST_HOST, &address, onResolved, this);
+        if (error == ERR_OK) {
+            onResolved(FORECAST_HOST, &address, this);
+        }
+        else if (error != ERR_INPROGRESS) {
+            return fail("Host not resolved");
+        }
         return false;
     }
-};
\ No newline at end of file
+};
@@ -18,15 +18,68 @@
 #include "SNTPControl.h"
 #include "forecast.h"
 #include "display-SSD1306.h"
+#include "Scheduler.h"
+#include "LatencyHistogram.h"
+#include "PowerControl.h"
+#include "JsonWriter.h"
+#include "ChunkedResponse.h"
+#include "StaticAssets.h"
+#include "EventStream.h"
+#include "ConfigurationBatch.h"
+#include "ConfigurationStore.h"
+#include "WeatherHistory.h"
+#include "Metrics.h"
+#include "Logger.h"
 
 #define LED_ON()    digitalWrite(LED_BUILTIN, LOW)
 #define LED_OFF()   digitalWrite(LED_BUILTIN, HIGH)
 
+#define WIFI_WATCH_PERIOD 250       // ms between station state checks
+#define HTTP_SERVICE_PERIOD 5       // ms between web server polls, request latency
+#define FORECAST_CHECK_PERIOD 1000  // ms between forecast age checks
+#define FORECAST_STEP_PERIOD 2      // ms between fetch steps while fetching
+#define FACE_PREPARE_LEAD 80        // ms before second the clock face is rendered, its push timed
+#define FACE_PUSH_MARGIN 100        // us added to push time estimate
+#define FACE_WAIT_LIMIT 2000        // us busy waited for the push start, longer waits scheduled
+#define FACE_HTTP_GUARD 50          // ms before the face push web requests wait
+#define EVENT_STATE_FIXED 240       // bytes of state event with longest numbers, strings of configuration aside
+#define EVENT_DATA_BUFFER (EVENT_STATE_FIXED + sizeof(Configuration::timezoneRule) + \
+    sizeof(Configuration::timeServer1) + sizeof(Configuration::timeServer2) + sizeof(Configuration::timeServer3))
+
 Configuration state;
+ConfigurationStore configStore;
 ClockDisplay display;
 ForecastProvider forecast(FORECAST_LATITUDE, FORECAST_LONGITUDE, 600); // coordinates must be defined in secrets.h
+WeatherHistory history;
 wl_status_t wl_status = WL_IDLE_STATUS;
 ESP8266WebServer server(WEBUI_PORT);
+PowerControl power;
+StaticAssets assets;
+EventStream events;
+Metrics metrics;
+Metric loopMetric("loop_seconds", "Scheduler pass, tasks due run");
+Metric configMetric("config_save_seconds", "Configuration written to flash");
+
+void watchWiFi();
+void serveHttp();
+void keepTime();
+void showFrame();
+void showFace();
+void fetchForecast();
+void flushConfiguration();
+void publishTime(int8_t to = -1);
+void publishState(int8_t to = -1);
+void publishForecast(int8_t to = -1);
+
+// name, function, period ms, budget us
+Scheduler scheduler;
+ScheduledTask wifiTask("wifi-watchdog", watchWiFi, WIFI_WATCH_PERIOD, 1000);
+ScheduledTask httpTask("http-service", serveHttp, HTTP_SERVICE_PERIOD, 20000);
+ScheduledTask sntpTask("sntp", keepTime, SNTP_ADJUST_PERIOD, 1000);
+ScheduledTask frameTask("display-frame", showFrame, 0, 100000);    // full frame by software I2C
+ScheduledTask faceTask("clock-face", showFace, 0, 100000);
+ScheduledTask forecastTask("forecast-fetch", fetchForecast, FORECAST_CHECK_PERIOD, FORECAST_STEP_BUDGET * 2);
+ScheduledTask flushTask("config-flush", flushConfiguration, 0, 50000);
 
 inline bool net_status_good(wl_status_t status) {
     return status == WL_CONNECTED || status == WL_DISCONNECTED;
@@ -43,21 +96,285 @@ bool checkAuthentified() {
     if (server.authenticate(WEBUI_USER, WEBUI_PASSWORD)) {
         return true;
     }
-    Serial.println("Authentication requested...");
+    LOG_INFO("Authentication requested");
     server.requestAuthentication(BASIC_AUTH, "ESP-CLOCK-AUTH-REALM", "Authentication failed");
     return false;
 }
 
+void watchWiFi() {
+    if (WiFi.status() != wl_status) {
+        wl_status = WiFi.status();
+        if (wl_status == WL_CONNECTED) {
+            LOG_INFO("Station connected, IP address %s", WiFi.localIP().toString().c_str());
+            LED_OFF();
+        }
+        else if (wl_status == WL_DISCONNECTED) {
+            LOG_WARN("Station disconnected");
+            LED_ON();
+        }
+        else {
+            LOG_INFO("Station connection state changed: %d", (int)wl_status);
+        }
+    }
+}
+
+// serving a request takes tens of ms, it waits when clock face push is close
+void serveHttp() {
+    if (faceTask.isScheduled() && (int32_t)(faceTask.getDue() - millis()) < FACE_HTTP_GUARD) {
+        return;
+    }
+    if (wl_status == WL_CONNECTED) {
+        server.handleClient();
+        events.flush();
+    }
+}
+
+// ms between housekeeping checks, stretched in light sleep to save wakeups
+static uint32_t housekeeping(uint32_t period) {
+    return power.getMode() == POWER_MODE_LIGHT ? POWER_LIGHT_HOUSEKEEPING : period;
+}
+
+// replies are time stamped when seen, so polled every tick while a round is in progress
+void keepTime() {
+    static uint32_t steps = 0;
+    static bool synchronized = false;
+    SNTPControl::update();
+    // clock stepped or synchronization changed, pages resynchronize their clocks
+    const SNTPClient& client = SNTPControl::client();
+    if (client.getSteps() != steps || client.isSynchronized() != synchronized) {
+        steps = client.getSteps();
+        synchronized = client.isSynchronized();
+        publishTime();
+        publishState();
+    }
+    sntpTask.period = constrain(SNTPControl::client().getRoundDelay(), (uint32_t)1, housekeeping(SNTP_ADJUST_PERIOD));
+}
+
+static int64_t wallMicros() {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return (int64_t)tv.tv_sec * 1000000 + tv.tv_usec;
+}
+
+// ms until given wall clock time, 0 when passed
+static uint32_t millisUntil(int64_t micros) {
+    int64_t left = micros - wallMicros();
+    return left > 0 ? (uint32_t)(left / 1000) : 0;
+}
+
+// Ticker frames at whole tenths of the wall second, the one at second boundary is sent
+// by clock face
+void showFrame() {
+    display.animate(millis());
+    int64_t frame = 1000000 / TICKER_FRAME_RATE;
+    scheduler.schedule(frameTask, millisUntil((wallMicros() / frame + 1) * frame) + 1);
+}
+
+LatencyHistogram faceLatency;       // second boundary to the face push completion
+time_t faceSecond = 0;              // second of the face rendered, push awaited
+
+// Face of the coming second is rendered ahead, earlier when the pager switches screens,
+// then pushed to finish at the boundary, start by whole ms scheduled, the rest busy waited
+void showFace() {
+    int64_t now = wallMicros();
+    if (faceSecond == 0 || !display.isPrepared()) {
+        if (faceSecond == 0) {
+            faceSecond = now % 1000000 >= 500000 ? now / 1000000 + 1 : now / 1000000;
+        }
+        display.updateNetwork(wl_status == WL_CONNECTED, WiFi.localIP(), WiFi.RSSI(),
+            SNTPControl::client().isSynchronized());
+        display.prepare(faceSecond);
+    }
+    int64_t start = (int64_t)faceSecond * 1000000 - display.estimatePushMicros() - FACE_PUSH_MARGIN;
+    if (start - now > FACE_WAIT_LIMIT) {
+        scheduler.schedule(faceTask, (uint32_t)((start - now) / 1000));
+        return;
+    }
+    if (start > now) {
+        delayMicroseconds(start - now);
+    }
+    display.push();
+    now = wallMicros();
+    faceLatency.add((int32_t)constrain(now - (int64_t)faceSecond * 1000000, (int64_t)INT32_MIN, (int64_t)INT32_MAX));
+    int64_t next = max((int64_t)faceSecond + 1, now / 1000000 + 1) * 1000000;
+    faceSecond = 0;
+    scheduler.schedule(faceTask, millisUntil(next - FACE_PREPARE_LEAD * 1000 -
+        display.estimateSwitchMicros(next / 1000000)));
+}
+
+// fetch advances by short steps, never holds the loop waiting for the network
+void fetchForecast() {
+    if (forecast.pull()) {
+        char line[FORECAST_FORMAT_BUFFER];
+        const Forecast& current = forecast.getForecast();
+        current.toString(line, sizeof(line));
+        LOG_INFO("Forecast %s", line);
+        history.append(current.getTimestamp(), current.getTemperature(), current.getWindSpeed(),
+            current.getWeatherCode());
+        display.updateForecast(forecast.getForecast(), forecast.getSeries());
+        publishForecast();
+    }
+    forecastTask.period = forecast.isFetching() ? FORECAST_STEP_PERIOD :
+        constrain(forecast.getPullDelay(), (uint32_t)FORECAST_STEP_PERIOD, housekeeping(FORECAST_CHECK_PERIOD));
+}
+
+// Light sleep drops ticker frames, web server is polled once per listen interval as
+// requests arrive with the beacons the station wakes for
+void applyPowerMode() {
+    bool light = power.getMode() == POWER_MODE_LIGHT;
+    display.setTickerEnabled(!light);
+    if (light) {
+        scheduler.cancel(frameTask);
+    }
+    else if (!frameTask.isScheduled()) {
+        scheduler.schedule(frameTask);
+    }
+    httpTask.period = light ? POWER_LISTEN_INTERVAL * POWER_BEACON_MICROS / 1000 : HTTP_SERVICE_PERIOD;
+    wifiTask.period = housekeeping(WIFI_WATCH_PERIOD);
+}
+
+// Configuration, display and forecast state, timezone and daylight in hours as the web
+// page expects, fractional for zones of minutes
+void writeState(Print& out, bool withForecast = true) {
+    DateTime now = DateTime::now();
+    int32_t offset = TimeZone::local().getOffset(time(NULL));
+    int32_t standard = TimeZone::local().getStandardOffset();
+    char date[DATETIME_FORMAT_BUFFER], colors[sizeof(state.displayColors) / sizeof(uint32_t) * 6 + 1];
+    now.toString(date, sizeof(date), "%Y%m%dT%H%M%SZ");
+    for (uint8_t i = 0; i < sizeof(state.displayColors) / sizeof(uint32_t); i++) {
+        snprintf(colors + i * 6, sizeof(colors) - i * 6, "%06X", (unsigned)(state.displayColors[i] & 0xFFFFFF));
+    }
+    JsonWriter json(out);
+    json.beginObject()
+        .member("date", date)
+        .key("timezone").value(standard, 3600)
+        .key("daylight").value(offset - standard, 3600)
+        .member("tzrule", state.timezoneRule)
+        .member("ntpenabled", state.ntpenabled != 0)
+        .member("ntpserver1", state.timeServer1)
+        .member("ntpserver2", state.timeServer2)
+        .member("ntpserver3", state.timeServer3)
+        .member("brightness", (uint32_t)state.displayBrightness)
+        .member("colors", colors)
+        .member("synchronized", SNTPControl::client().isSynchronized());
+    if (withForecast) {
+        if (forecast.hasForecastFor(3600)) {
+            forecast.getForecast().printTo(json.key("forecast").raw(), ForecastFormat::json());
+        }
+        else json.key("forecast").null();
+    }
+    json.endObject();
+}
+
+// Event to given subscriber, or to all of them when negative
+static void emit(int8_t to, const char* event, const char* data) {
+    if (to < 0) {
+        events.publish(event, data);
+    }
+    else events.send(to, event, data);
+}
+
+// Compact time sync, local time with milliseconds the page runs its clock from
+void publishTime(int8_t to) {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    char date[DATETIME_FORMAT_BUFFER], data[64];
+    DateTime(tv.tv_sec).toString(date, sizeof(date), "%Y%m%dT%H%M%SZ");
+    snprintf(data, sizeof(data), "{\"date\":\"%s\", \"ms\":%u}", date, (unsigned)(tv.tv_usec / 1000));
+    emit(to, "time", data);
+}
+
+void publishState(int8_t to) {
+    char data[EVENT_DATA_BUFFER];
+    BufferPrint out(data, sizeof(data));
+    writeState(out, false);
+    // escaped characters lengthen strings, cut JSON is not sent to be rejected by the page
+    if (out.isTruncated()) {
+        LOG_ERROR("State event of %u bytes truncated, not sent", (unsigned)sizeof(data));
+        return;
+    }
+    emit(to, "state", data);
+}
+
+void publishForecast(int8_t to) {
+    char data[FORECAST_FORMAT_BUFFER];
+    if (forecast.hasForecastFor(3600)) {
+        forecast.getForecast().toString(data, sizeof(data), ForecastFormat::json());
+    }
+    else strcpy(data, "null");
+    emit(to, "forecast", data);
+}
+
+// Apply accepted batch, only parts it changes are reconfigured, flash is written after
+// the response when configuration bytes differ, return true then
+bool applyConfiguration(const ConfigurationBatch& batch) {
+    bool changed = batch.changes(state);
+    bool servers = batch.changes(state, offsetof(Configuration, timeServer1),
+        offsetof(Configuration, timezoneRule) - offsetof(Configuration, timeServer1));
+    bool rule = batch.changes(state, offsetof(Configuration, timezoneRule), sizeof(state.timezoneRule));
+    bool timing = servers || rule || batch.changes(state, offsetof(Configuration, ntpenabled), 1);
+    bool shown = batch.changes(state, offsetof(Configuration, displayBrightness), 1) ||
+        batch.changes(state, offsetof(Configuration, displayColors), sizeof(state.displayColors));
+    if (servers) {
+        // client keeps host names by pointer, they change in place
+        SNTPControl::client().configure(NULL, NULL, NULL);
+    }
+    state = batch.getStaged();
+    if (timing) {
+        SNTPControl::configure(state.timezoneRule, state.timeServer1, state.timeServer2,
+            state.timeServer3, state.ntpenabled);
+    }
+    if (shown) {
+        display.setBrightnessAndColorScheme(state.displayBrightness, state.displayColors);
+    }
+    if (batch.hasDate() && batch.getDate().setAsSystemTime()) {
+        SNTPControl::client().unsynchronize();
+    }
+    if (batch.hasSynchronize()) {
+        SNTPControl::restart();
+    }
+    if (changed) {
+        scheduler.schedule(flushTask);
+    }
+    if (rule || batch.hasDate()) {
+        publishTime();
+    }
+    if (changed) {
+        publishState();
+    }
+    return changed;
+}
+
+void flushConfiguration() {
+    MetricTimer timer(configMetric);
+    if (configStore.save(state)) {
+        LOG_INFO("Configuration saved");
+    }
+    else LOG_ERROR("Configuration save FAILED");
+}
+
+// Register handler timed by its own series, labels are allocated once here
+void on(const char* uri, HTTPMethod method, void (*handler)()) {
+    char* labels = new char[strlen(uri) + 32];
+    sprintf(labels, "path=\"%s\",method=\"%s\"", uri, method == HTTP_POST ? "POST" : "GET");
+    Metric* metric = new Metric("http_handler_seconds", "Web request handler run time", labels);
+    metrics.add(*metric);
+    server.on(uri, method, [metric, handler]() {
+        MetricTimer timer(*metric);
+        handler();
+    });
+}
+
 void setup() {
     pinMode(LED_BUILTIN, OUTPUT);
     LED_ON();
 
     Serial.begin(UART_SPEED);
-    Serial.println("\n\nESP8266 OLED-SSD1306 Clock\n=============================\n");
+    Logger::system().begin(&Serial);
+    LOG_INFO("ESP8266 OLED-SSD1306 Clock");
+    LOG_DEBUG("Forecast size %u bytes", (unsigned)sizeof(Forecast));
 
-    Serial.println(sizeof(Forecast));
-
-    state.loadStoredConfigurationOrDefaults();
+    configStore.load(state);
 
     // Serial.print("Time Server 1: ");
     // Serial.println(state.timeServer1);
@@ -67,8 +384,13 @@ void setup() {
     // Serial.println(state.timeServer3);
 
     if (true) {
-        SNTPControl::configure(state.timezone, state.daylight,
-            state.timeServer1, state.timeServer2, state.timeServer3, state.ntpenabled);
+        if (!SNTPControl::configure(state.timezoneRule,
+                state.timeServer1, state.timeServer2, state.timeServer3, state.ntpenabled)) {
+            LOG_WARN("Timezone rule invalid, default used");
+            strcpy(state.timezoneRule, TIMEZONE_DEFAULT_RULE);
+            SNTPControl::configure(state.timezoneRule,
+                state.timeServer1, state.timeServer2, state.timeServer3, state.ntpenabled);
+        }
 
         DateTime(2000, 1, 1, 0, 0, 0).setAsSystemTime();
     }
@@ -80,168 +402,315 @@ void setup() {
 
     display.initialize(state.displayBrightness, state.displayColors);
 
-    Serial.print("Initializing network: ");
-    Serial.println(net_initialize() ? "OK" : "FAILED");
-    Serial.print("MAC address: ");
-    Serial.println(WiFi.macAddress());
-    Serial.print("IP Address:  ");
-    Serial.println(IPAddress(state.stationIP));
-    Serial.print("Gateway:     ");
-    Serial.println(IPAddress(state.stationGateway));
-    Serial.print("DNS Address: ");
-    Serial.println(IPAddress(state.stationDNS));
-    Serial.print("Subnet Mask: ");
-    Serial.println(IPAddress(state.stationSubnet));
-    Serial.print("SSID Name:   ");
-    Serial.println(state.wifiSSID);
-
-    Serial.print("Initializing filesystem: ");
-    Serial.println(LittleFS.begin() ? "OK" : "FAILED");
+    LOG_INFO("Initializing network: %s", net_initialize() ? "OK" : "FAILED");
+    LOG_INFO("Power mode: %s", power.setMode(POWER_DEFAULT_MODE) ? PowerControl::getModeName(power.getMode()) : "FAILED");
+    LOG_INFO("MAC address: %s", WiFi.macAddress().c_str());
+    LOG_INFO("IP address:  %s", IPAddress(state.stationIP).toString().c_str());
+    LOG_INFO("Gateway:     %s", IPAddress(state.stationGateway).toString().c_str());
+    LOG_INFO("DNS address: %s", IPAddress(state.stationDNS).toString().c_str());
+    LOG_INFO("Subnet mask: %s", IPAddress(state.stationSubnet).toString().c_str());
+    LOG_INFO("SSID name:   %s", state.wifiSSID);
+
+    LOG_INFO("Initializing filesystem: %s", LittleFS.begin() ? "OK" : "FAILED");
+    forecast.restore(LittleFS);
+    history.begin(LittleFS);
+
+    metrics.add(loopMetric);
+    metrics.add(display.getRenderMetric());
+    metrics.add(display.getSendMetric());
+    metrics.add(forecast.getStepMetric());
+    for (uint8_t phase = FETCH_RESOLVE; phase < FETCH_PHASES; phase++) {
+        metrics.add(forecast.getPhaseMetric((ForecastFetchPhase)phase));
+    }
+    metrics.add(configMetric);
 
-    server.on("/time", HTTP_GET, []() {
-        server.send(200, "text/plain", DateTime::now().toString());
+    on("/time", HTTP_GET, []() {
+        char date[DATETIME_FORMAT_BUFFER];
+        DateTime::now().toString(date, sizeof(date), "%Y-%m-%d %H:%M:%S");
+        server.send(200, "text/plain", date);
     });
 
-    server.on("/info", HTTP_GET, []() {
-        String message = "Status: OK\r\nDate: {DATE}\r\nForecast: {CAST}\r\n";
-        message.replace("{DATE}", DateTime::now().toString());
-        message.replace("{CAST}", forecast.hasForecastFor(3600)
-            ? forecast.getForecast().toString() : String("Unknown"));
-
-        server.send(200, "text/plain", message);
+    on("/info", HTTP_GET, []() {
+        char date[DATETIME_FORMAT_BUFFER];
+        DateTime::now().toString(date, sizeof(date), "%Y-%m-%d %H:%M:%S");
+        ChunkedResponse response(server, 200, "text/plain");
+        response.print("Status: OK\r\nDate: ");
+        response.print(date);
+        response.print("\r\nForecast: ");
+        if (forecast.hasForecastFor(3600)) {
+            forecast.getForecast().printTo(response);
+        }
+        else response.print("Unknown");
+        response.print("\r\nHourly: ");
+        response.print((unsigned)forecast.getSeries().hoursAhead(time(NULL)));
+        response.print(" hours ahead\r\nFrame: ");
+        response.print((unsigned)display.getFrameBytes());
+        response.print(" bytes, ");
+        response.print((unsigned long)display.getFrameMicros());
+        response.print(" us (max ");
+        response.print((unsigned long)display.getFrameMicrosMax());
+        response.print(" us)\r\nFetch: resolve ");
+        response.print((unsigned long)forecast.getPhaseMillis(FETCH_RESOLVE));
+        response.print(", connect ");
+        response.print((unsigned long)forecast.getPhaseMillis(FETCH_CONNECT));
+        response.print(", send ");
+        response.print((unsigned long)forecast.getPhaseMillis(FETCH_SEND));
+        response.print(", headers ");
+        response.print((unsigned long)forecast.getPhaseMillis(FETCH_HEADERS));
+        response.print(", body ");
+        response.print((unsigned long)forecast.getPhaseMillis(FETCH_BODY));
+        response.print(" ms, step max ");
+        response.print((unsigned long)forecast.getStepMicrosMax());
+        response.print(" us\r\n");
+        response.end();
     });
 
-    server.on("/get-state-forecast", HTTP_GET, []() {
+    on("/get-state-forecast", HTTP_GET, []() {
         if (forecast.hasForecastFor(3600)) {
-            String data = forecast.getForecast().toJSONString();
+            char data[FORECAST_FORMAT_BUFFER];
+            forecast.getForecast().toString(data, sizeof(data), ForecastFormat::json());
             server.send(200, "application/json", data);
-            Serial.println("Forecast state sended OK");
+            LOG_DEBUG("Forecast state sended OK");
         }
         else {
             server.send(200, "application/json", "null");
-            Serial.println("Forecast state sended OK - (No forecast)");
+            LOG_DEBUG("Forecast state sended OK - (No forecast)");
         }       
     });
 
-    server.on("/get-state", HTTP_GET, []() {
-        String json("{\"date\":\"[DATE]\", \"timezone\":[ZONE], \"daylight\":[DAYL], \"ntpenabled\":[NTPE], \"ntpserver1\":\"[NTP1]\", \"ntpserver2\":\"[NTP2]\", \"ntpserver3\":\"[NTP3]\", \"brightness\":[BRIG], \"colors\":\"[CLRS]\"}");
-        json.replace("[DATE]", DateTime::now().toISOString());
-        json.replace("[ZONE]", "3");
-        json.replace("[DAYL]", "0");
-        json.replace("[NTPE]", "true");
-        json.replace("[NTP1]", "0.pool.ntp.org");
-        json.replace("[NTP2]", "1.pool.ntp.org");
-        json.replace("[NTP3]", "time.nist.gov");
-        json.replace("[BRIG]", String(display.getBrightness()));
-        json.replace("[CLRS]", display.getColorScheme());
+    on("/get-state-latency", HTTP_GET, []() {
+        char data[768];
+        faceLatency.toJSON(data, sizeof(data));
+        server.send(200, "application/json", data);
+    });
+
+    on("/get-state-tasks", HTTP_GET, []() {
+        ChunkedResponse response(server, 200, "application/json");
+        scheduler.printTo(response);
+        response.end();
+    });
+
+    on("/get-state-power", HTTP_GET, []() {
+        char data[256];
+        power.toJSON(data, sizeof(data));
+        server.send(200, "application/json", data);
+    });
+
+    on("/get-state-ntp", HTTP_GET, []() {
+        char data[512];
+        SNTPControl::client().toJSON(data, sizeof(data));
+        server.send(200, "application/json", data);
+    });
+
+    // connection stays open, subscriber gets current state then changes as they happen
+    on("/events", HTTP_GET, []() {
+        int8_t subscriber = events.subscribe(server.client());
+        if (subscriber < 0) {
+            server.send(503, "text/plain", "Too many subscribers");
+            return;
+        }
+        publishTime(subscriber);
+        publishState(subscriber);
+        publishForecast(subscriber);
+        events.flush();
+    });
+
+    on("/get-state-events", HTTP_GET, []() {
+        char data[256];
+        events.toJSON(data, sizeof(data));
+        server.send(200, "application/json", data);
+    });
+
+    // recent log lines, oldest first
+    on("/log", HTTP_GET, []() {
+        ChunkedResponse response(server, 200, "text/plain");
+        Logger::system().printTo(response);
+        response.end();
+    });
+
+    // Weather history downsampled, from and till in UTC seconds, a week back to now by default
+    on("/get-history", HTTP_GET, []() {
+        uint32_t till = server.hasArg("till") ? strtoul(server.arg("till").c_str(), NULL, 10) : (uint32_t)time(NULL);
+        uint32_t from = server.hasArg("from") ? strtoul(server.arg("from").c_str(), NULL, 10) : till - 7 * 86400;
+        uint32_t step = server.hasArg("step") ? strtoul(server.arg("step").c_str(), NULL, 10) : 3600;
+        String field = server.arg("field");
+        if (step == 0 || till <= from || (till - from - 1) / step >= HISTORY_QUERY_BUCKETS ||
+                !(field == "" || field == "temperature" || field == "windspeed")) {
+            server.send(400, "text/html", "History query FAILED");
+            return;
+        }
+        ChunkedResponse response(server, 200, "application/json");
+        history.query(response, from, till, step, field == "windspeed" ? HISTORY_FIELD_WINDSPEED : HISTORY_FIELD_TEMPERATURE);
+        response.end();
+    });
+
+    // Prometheus text format, for scraping many clocks to find slow ones
+    on("/metrics", HTTP_GET, []() {
+        ChunkedResponse response(server, 200, "text/plain; version=0.0.4");
+        metrics.printTo(response);
+        response.end();
+    });
 
-        server.send(200, "application/json", json);
-        Serial.println("Processed GET(/get-state)");
+    on("/get-state", HTTP_GET, []() {
+        ChunkedResponse response(server, 200, "application/json");
+        writeState(response);
+        response.end();
+        LOG_DEBUG("Processed GET(/get-state)");
     });
 
-    server.on("/set-date", HTTP_POST, []() {
+    on("/set-date", HTTP_POST, []() {
         if (checkAuthentified()) {
             DateTime date = DateTime::parseISOString(server.arg("date").c_str());
 
             if (date.isDateTime() && date.setAsSystemTime()) {
+                SNTPControl::client().unsynchronize();
+                publishTime();
                 server.send(200, "text/html", "OK");
-                Serial.println("Date changed to " + date.toString());
+                LOG_INFO("Date changed to %s", date.toString().c_str());
             }
             else {
                 server.send(400, "text/html", "Date set FAILED");
-                Serial.println("Date set FAILED");
+                LOG_WARN("Date set FAILED");
             }
         }
     });
 
-    server.on("/syncronize", HTTP_POST, []() {
+    on("/set-timezone", HTTP_POST, []() {
+        if (checkAuthentified()) {
+            String rule = server.arg("rule");
+            if (SNTPControl::configure(rule.c_str(), state.timeServer1, state.timeServer2,
+                    state.timeServer3, state.ntpenabled)) {
+                strcpy(state.timezoneRule, rule.c_str());
+                publishTime();
+                publishState();
+                server.send(200, "text/html", "OK");
+                LOG_INFO("Timezone rule changed to %s", rule.c_str());
+            }
+            else {
+                server.send(400, "text/html", "Timezone rule set FAILED");
+                LOG_WARN("Timezone rule set FAILED");
+            }
+        }
+    });
+
+    on("/syncronize", HTTP_POST, []() {
         if (checkAuthentified()) {
             SNTPControl::restart();
             server.send(200, "text/html", "OK");
-            Serial.println("SNTP restarted");
+            LOG_INFO("SNTP restarted");
         }
     });
 
-    server.on("/set-display", HTTP_POST, []() {
+    on("/set-display", HTTP_POST, []() {
         if (checkAuthentified()) {
             if (display.setBrightnessAndColorScheme(
                     server.arg("brightness"), server.arg("colors"))) {
 
                 display.copyBrightnessAndColorScheme(
                     &state.displayBrightness, state.displayColors);
-            
+                publishState();
+
                 const char * msg = "Display scheme updated";
                 server.send(200, "text/html", msg);
-                Serial.println(msg);
+                LOG_INFO("%s", msg);
             }
             else {
                 const char * msg = "Display scheme update failed";
                 server.send(400, "text/html", msg);
-                Serial.println(msg);
+                LOG_WARN("%s", msg);
             }
         }
     });
 
-    server.on("/write-config", HTTP_POST, []() {
+    on("/set-power", HTTP_POST, []() {
         if (checkAuthentified()) {
-            if (state.saveToEEPROM()) {
+            if (power.setMode(server.arg("mode").c_str())) {
+                applyPowerMode();
+                power.reset();
                 server.send(200, "text/html", "OK");
-                Serial.println("Configuration saved");
+                LOG_INFO("Power mode changed to %s", server.arg("mode").c_str());
             }
             else {
-                server.send(400, "text/html", "Configuration save FAILED");
-                Serial.println("Configuration save FAILED");
+                server.send(400, "text/html", "Power mode set FAILED");
+                LOG_WARN("Power mode set FAILED");
             }
         }
     });
 
-    server.on("/syncronize", HTTP_GET, []() {
+    // fields of /get-state and date, synchronize, checked together then applied at once
+    on("/set-config", HTTP_POST, []() {
+        if (checkAuthentified()) {
+            ConfigurationBatch batch(state);
+            for (int i = 0; i < server.args(); i++) {
+                String name = server.argName(i);
+                if (name != "plain") {
+                    batch.set(name.c_str(), server.arg(i).c_str());
+                }
+            }
+            if (batch.getRejected()) {
+                server.send(400, "text/html", String("Configuration FAILED, invalid ") + batch.getRejected());
+                LOG_WARN("Configuration batch rejected, invalid %s", batch.getRejected());
+                return;
+            }
+            bool changed = applyConfiguration(batch);
+            server.send(200, "text/html", changed ? "OK" : "OK, unchanged");
+            LOG_INFO("Configuration batch applied%s", changed ? "" : ", unchanged");
+        }
+    });
+
+    on("/write-config", HTTP_POST, []() {
+        if (checkAuthentified()) {
+            // flash is written after the response is sent
+            scheduler.schedule(flushTask);
+            server.send(200, "text/html", "OK");
+        }
+    });
+
+    on("/syncronize", HTTP_GET, []() {
         if (checkAuthentified()) {
             SNTPControl::restart();
             server.send(200, "text/html", "SNTP restarted");
-            Serial.println("SNTP restarted");
+            LOG_INFO("SNTP restarted");
         }
     });
 
-    server.serveStatic("/", LittleFS, "/", "no-cache"/*"max-age=3600"*/);
+    // gzipped assets of the build step, plain data/ files when uploaded as they are
+    static const char* collected[] = { "If-None-Match" };
+    server.collectHeaders(collected, 1);
+    if (assets.load(LittleFS)) {
+        LOG_INFO("Web UI assets: %u", assets.getCount());
+    }
+    else {
+        LOG_WARN("Web UI assets not built, plain files served");
+        server.serveStatic("/", LittleFS, "/", "no-cache");
+    }
+    static Metric staticMetric("http_handler_seconds", "Web request handler run time", "path=\"static\",method=\"GET\"");
+    metrics.add(staticMetric);
+    server.onNotFound([]() {
+        MetricTimer timer(staticMetric);
+        if (!assets.handle(server, LittleFS)) {
+            server.send(404, "text/plain", "Not found");
+        }
+    });
     server.begin();
     NBNS.begin(WEBUI_HOSTNAME);
+
+    scheduler.schedule(wifiTask);
+    scheduler.schedule(sntpTask);
+    scheduler.schedule(frameTask);
+    scheduler.schedule(faceTask);
+    scheduler.schedule(forecastTask);
+    scheduler.schedule(httpTask);
+    applyPowerMode();
 }
 
-time_t lastsec = -1;
 void loop() {
-    if (WiFi.status() != wl_status) {
-        wl_status = WiFi.status();
-        if (wl_status == WL_CONNECTED) {
-            Serial.print("Station connected, IP address: ");
-            Serial.println(WiFi.localIP());
-            LED_OFF();
-        }
-        else if (wl_status == WL_DISCONNECTED) {
-            Serial.println("Station disconnected");
-            LED_ON();
-        }
-        else {
-            Serial.print("Station connection state changed: ");
-            Serial.println(wl_status);
-        }
-    }
-
-    time_t sec = time(NULL);    
-    if (lastsec != sec) {
-        lastsec = sec;
-        display.update(sec);
-
-        if (wl_status == WL_CONNECTED && forecast.pull()) {
-            Serial.print(DateTime::now().toTimeString() + "  ");
-            Serial.println(forecast.getForecast().toString());
-            display.updateForecast(forecast.getForecast());
-        }
-    }
-
-    if (wl_status == WL_CONNECTED) {
-        server.handleClient();
-    }
-
-    delay(1);
-}
\ No newline at end of file
+    // tasks run when due, until the next deadline loop sleeps and WiFi stack works
+    uint32_t start = micros();
+    uint32_t sleep = scheduler.run();
+    loopMetric.record(micros() - start);
+    metrics.sampleHeap();
+    // log lines go out as the UART FIFO empties, never in the display tick
+    Logger::system().drain();
+    power.idle(Logger::system().isPending() ? min(sleep, (uint32_t)LOG_DRAIN_PERIOD) : sleep);
+}
@@ -0,0 +1,90 @@
+# (c) Skatech Research Lab, 2000-2026.
+# Last change: 2026.10.16
+# Web UI asset build step - minifies and gzips data/ into the filesystem image
+# directory with a manifest of content hash ETags read by the firmware
+#
+# PlatformIO runs it before every target (extra_scripts = pre:tools/webui.py),
+# standalone: python3 tools/webui.py [source] [target]
+
+import gzip
+import hashlib
+import os
+import re
+import sys
+
+MANIFEST = "assets.txt"
+
+def minify_css(text):
+    text = re.sub(r"/\*.*?\*/", "", text, flags=re.S)
+    text = re.sub(r"\s+", " ", text)
+    return re.sub(r"\s*([{};:,>])\s*", r"\1", text).replace(";}", "}").strip()
+
+# statements end by newlines (no semicolons), so lines are kept, only trimmed
+def minify_js(text):
+    text = re.sub(r"^\s*/\*.*?\*/", "", text, flags=re.S | re.M)
+    lines = (line.strip() for line in text.splitlines())
+    return "\n".join(line for line in lines if line and not line.startswith("//"))
+
+def minify_html(text):
+    text = re.sub(r"<!--.*?-->", "", text, flags=re.S)
+    return re.sub(r">\s+<", "><", re.sub(r"\n\s*", "\n", text)).strip()
+
+MINIFIERS = { ".css": minify_css, ".js": minify_js, ".html": minify_html, ".htm": minify_html }
+
+def compress(data):
+    return gzip.compress(data, compresslevel=9, mtime=0)
+
+def etag(data):
+    return hashlib.sha1(data).hexdigest()[:16]
+
+# pages reference assets by versioned URL, so assets are cached for good and
+# a page revalidated by ETag brings new versions
+def version_references(page, tags):
+    def replace(match):
+        path = "/" + match.group(2).lstrip("./")
+        return match.group(1) + match.group(2) + ("?v=" + tags[path] if path in tags else "") + match.group(3)
+    return re.sub(r'((?:href|src)=")([^"?:]+)(")', replace, page)
+
+def build(source, target):
+    assets = {}
+    for root, _, files in os.walk(source):
+        for name in sorted(files):
+            path = os.path.join(root, name)
+            uri = "/" + os.path.relpath(path, source).replace(os.sep, "/")
+            with open(path, "rb") as file:
+                data = file.read()
+            extension = os.path.splitext(name)[1].lower()
+            if extension in MINIFIERS:
+                data = MINIFIERS[extension](data.decode("utf-8")).encode("utf-8")
+            assets[uri] = data
+
+    pages = [uri for uri in assets if uri.endswith((".html", ".htm"))]
+    tags = { uri: etag(compress(data)) for uri, data in assets.items() if uri not in pages }
+    for uri in pages:
+        assets[uri] = version_references(assets[uri].decode("utf-8"), tags).encode("utf-8")
+        tags[uri] = etag(compress(assets[uri]))
+
+    original = compressed = 0
+    manifest = []
+    for uri in sorted(assets):
+        output = os.path.join(target, uri.lstrip("/") + ".gz")
+        os.makedirs(os.path.dirname(output), exist_ok=True)
+        data = compress(assets[uri])
+        with open(output, "wb") as file:
+            file.write(data)
+        original += os.path.getsize(os.path.join(source, uri.lstrip("/")))
+        compressed += len(data)
+        manifest.append("%s %s\n" % (uri, tags[uri]))
+    with open(os.path.join(target, MANIFEST), "w") as file:
+        file.writelines(manifest)
+    print("Web UI: %d assets, %d bytes, %d gzipped" % (len(assets), original, compressed))
+
+try:
+    Import("env")
+    project = env.subst("$PROJECT_DIR")
+    build(os.path.join(project, "data"), env.subst("$PROJECT_DATA_DIR"))
+except NameError:
+    if __name__ == "__main__":
+        here = os.path.dirname(os.path.abspath(__file__))
+        build(sys.argv[1] if len(sys.argv) > 1 else os.path.join(here, "..", "data"),
+            sys.argv[2] if len(sys.argv) > 2 else os.path.join(here, "..", ".pio", "webui"))